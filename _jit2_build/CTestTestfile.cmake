@@ -0,0 +1,12 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_jit2_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(unittests "unittests" "-cp" "/root/repo/Smalltalk" "/root/repo/Examples/Hello.som")
+set_tests_properties(unittests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;300;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(som-tests "/root/repo/_jit2_build/SOM++" "-cp" "/root/repo/Smalltalk" "/root/repo/TestSuite/TestHarness.som")
+set_tests_properties(som-tests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;304;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(benchmarks "/root/repo/_jit2_build/SOM++" "-cp" "/root/repo/Smalltalk:/root/repo/Examples/Benchmarks/LanguageFeatures" "/root/repo/Examples/Benchmarks/All.som")
+set_tests_properties(benchmarks PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;308;add_test;/root/repo/CMakeLists.txt;0;")
@@ -0,0 +1,89 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/Main.cpp" "CMakeFiles/SOM++.dir/src/Main.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/Main.cpp.o.d"
+  "/root/repo/src/compiler/BytecodeGenerator.cpp" "CMakeFiles/SOM++.dir/src/compiler/BytecodeGenerator.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/compiler/BytecodeGenerator.cpp.o.d"
+  "/root/repo/src/compiler/ClassGenerationContext.cpp" "CMakeFiles/SOM++.dir/src/compiler/ClassGenerationContext.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/compiler/ClassGenerationContext.cpp.o.d"
+  "/root/repo/src/compiler/Disassembler.cpp" "CMakeFiles/SOM++.dir/src/compiler/Disassembler.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/compiler/Disassembler.cpp.o.d"
+  "/root/repo/src/compiler/Lexer.cpp" "CMakeFiles/SOM++.dir/src/compiler/Lexer.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/compiler/Lexer.cpp.o.d"
+  "/root/repo/src/compiler/MethodGenerationContext.cpp" "CMakeFiles/SOM++.dir/src/compiler/MethodGenerationContext.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/compiler/MethodGenerationContext.cpp.o.d"
+  "/root/repo/src/compiler/Parser.cpp" "CMakeFiles/SOM++.dir/src/compiler/Parser.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/compiler/Parser.cpp.o.d"
+  "/root/repo/src/compiler/SourcecodeCompiler.cpp" "CMakeFiles/SOM++.dir/src/compiler/SourcecodeCompiler.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/compiler/SourcecodeCompiler.cpp.o.d"
+  "/root/repo/src/compiler/Variable.cpp" "CMakeFiles/SOM++.dir/src/compiler/Variable.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/compiler/Variable.cpp.o.d"
+  "/root/repo/src/interpreter/Interpreter.cpp" "CMakeFiles/SOM++.dir/src/interpreter/Interpreter.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/interpreter/Interpreter.cpp.o.d"
+  "/root/repo/src/interpreter/JIT.cpp" "CMakeFiles/SOM++.dir/src/interpreter/JIT.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/interpreter/JIT.cpp.o.d"
+  "/root/repo/src/interpreter/RegisterCode.cpp" "CMakeFiles/SOM++.dir/src/interpreter/RegisterCode.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/interpreter/RegisterCode.cpp.o.d"
+  "/root/repo/src/interpreter/RegisterInterpreter.cpp" "CMakeFiles/SOM++.dir/src/interpreter/RegisterInterpreter.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/interpreter/RegisterInterpreter.cpp.o.d"
+  "/root/repo/src/interpreter/SequenceProfile.cpp" "CMakeFiles/SOM++.dir/src/interpreter/SequenceProfile.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/interpreter/SequenceProfile.cpp.o.d"
+  "/root/repo/src/interpreter/bytecodes.cpp" "CMakeFiles/SOM++.dir/src/interpreter/bytecodes.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/interpreter/bytecodes.cpp.o.d"
+  "/root/repo/src/memory/CopyingCollector.cpp" "CMakeFiles/SOM++.dir/src/memory/CopyingCollector.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/memory/CopyingCollector.cpp.o.d"
+  "/root/repo/src/memory/CopyingHeap.cpp" "CMakeFiles/SOM++.dir/src/memory/CopyingHeap.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/memory/CopyingHeap.cpp.o.d"
+  "/root/repo/src/memory/DebugCopyingCollector.cpp" "CMakeFiles/SOM++.dir/src/memory/DebugCopyingCollector.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/memory/DebugCopyingCollector.cpp.o.d"
+  "/root/repo/src/memory/DebugCopyingHeap.cpp" "CMakeFiles/SOM++.dir/src/memory/DebugCopyingHeap.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/memory/DebugCopyingHeap.cpp.o.d"
+  "/root/repo/src/memory/FrameStack.cpp" "CMakeFiles/SOM++.dir/src/memory/FrameStack.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/memory/FrameStack.cpp.o.d"
+  "/root/repo/src/memory/GenerationalCollector.cpp" "CMakeFiles/SOM++.dir/src/memory/GenerationalCollector.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/memory/GenerationalCollector.cpp.o.d"
+  "/root/repo/src/memory/GenerationalHeap.cpp" "CMakeFiles/SOM++.dir/src/memory/GenerationalHeap.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/memory/GenerationalHeap.cpp.o.d"
+  "/root/repo/src/memory/Heap.cpp" "CMakeFiles/SOM++.dir/src/memory/Heap.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/memory/Heap.cpp.o.d"
+  "/root/repo/src/memory/MarkSweepCollector.cpp" "CMakeFiles/SOM++.dir/src/memory/MarkSweepCollector.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/memory/MarkSweepCollector.cpp.o.d"
+  "/root/repo/src/memory/MarkSweepHeap.cpp" "CMakeFiles/SOM++.dir/src/memory/MarkSweepHeap.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/memory/MarkSweepHeap.cpp.o.d"
+  "/root/repo/src/misc/Murmur3Hash.cpp" "CMakeFiles/SOM++.dir/src/misc/Murmur3Hash.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/misc/Murmur3Hash.cpp.o.d"
+  "/root/repo/src/misc/ParseInteger.cpp" "CMakeFiles/SOM++.dir/src/misc/ParseInteger.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/misc/ParseInteger.cpp.o.d"
+  "/root/repo/src/misc/Timer.cpp" "CMakeFiles/SOM++.dir/src/misc/Timer.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/misc/Timer.cpp.o.d"
+  "/root/repo/src/misc/debug.cpp" "CMakeFiles/SOM++.dir/src/misc/debug.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/misc/debug.cpp.o.d"
+  "/root/repo/src/primitives/Array.cpp" "CMakeFiles/SOM++.dir/src/primitives/Array.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/Array.cpp.o.d"
+  "/root/repo/src/primitives/Block.cpp" "CMakeFiles/SOM++.dir/src/primitives/Block.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/Block.cpp.o.d"
+  "/root/repo/src/primitives/Class.cpp" "CMakeFiles/SOM++.dir/src/primitives/Class.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/Class.cpp.o.d"
+  "/root/repo/src/primitives/Double.cpp" "CMakeFiles/SOM++.dir/src/primitives/Double.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/Double.cpp.o.d"
+  "/root/repo/src/primitives/Integer.cpp" "CMakeFiles/SOM++.dir/src/primitives/Integer.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/Integer.cpp.o.d"
+  "/root/repo/src/primitives/Method.cpp" "CMakeFiles/SOM++.dir/src/primitives/Method.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/Method.cpp.o.d"
+  "/root/repo/src/primitives/Object.cpp" "CMakeFiles/SOM++.dir/src/primitives/Object.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/Object.cpp.o.d"
+  "/root/repo/src/primitives/Primitive.cpp" "CMakeFiles/SOM++.dir/src/primitives/Primitive.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/Primitive.cpp.o.d"
+  "/root/repo/src/primitives/String.cpp" "CMakeFiles/SOM++.dir/src/primitives/String.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/String.cpp.o.d"
+  "/root/repo/src/primitives/Symbol.cpp" "CMakeFiles/SOM++.dir/src/primitives/Symbol.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/Symbol.cpp.o.d"
+  "/root/repo/src/primitives/System.cpp" "CMakeFiles/SOM++.dir/src/primitives/System.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/System.cpp.o.d"
+  "/root/repo/src/primitives/Vector.cpp" "CMakeFiles/SOM++.dir/src/primitives/Vector.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitives/Vector.cpp.o.d"
+  "/root/repo/src/primitivesCore/PrimitiveContainer.cpp" "CMakeFiles/SOM++.dir/src/primitivesCore/PrimitiveContainer.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitivesCore/PrimitiveContainer.cpp.o.d"
+  "/root/repo/src/primitivesCore/PrimitiveLoader.cpp" "CMakeFiles/SOM++.dir/src/primitivesCore/PrimitiveLoader.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/primitivesCore/PrimitiveLoader.cpp.o.d"
+  "/root/repo/src/vm/Globals.cpp" "CMakeFiles/SOM++.dir/src/vm/Globals.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vm/Globals.cpp.o.d"
+  "/root/repo/src/vm/IsValidObject.cpp" "CMakeFiles/SOM++.dir/src/vm/IsValidObject.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vm/IsValidObject.cpp.o.d"
+  "/root/repo/src/vm/LogAllocation.cpp" "CMakeFiles/SOM++.dir/src/vm/LogAllocation.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vm/LogAllocation.cpp.o.d"
+  "/root/repo/src/vm/Print.cpp" "CMakeFiles/SOM++.dir/src/vm/Print.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vm/Print.cpp.o.d"
+  "/root/repo/src/vm/Shell.cpp" "CMakeFiles/SOM++.dir/src/vm/Shell.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vm/Shell.cpp.o.d"
+  "/root/repo/src/vm/Symbols.cpp" "CMakeFiles/SOM++.dir/src/vm/Symbols.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vm/Symbols.cpp.o.d"
+  "/root/repo/src/vm/Universe.cpp" "CMakeFiles/SOM++.dir/src/vm/Universe.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vm/Universe.cpp.o.d"
+  "/root/repo/src/vmobjects/AbstractObject.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/AbstractObject.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/AbstractObject.cpp.o.d"
+  "/root/repo/src/vmobjects/InlineCache.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/InlineCache.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/InlineCache.cpp.o.d"
+  "/root/repo/src/vmobjects/IntegerBox.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/IntegerBox.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/IntegerBox.cpp.o.d"
+  "/root/repo/src/vmobjects/Signature.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/Signature.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/Signature.cpp.o.d"
+  "/root/repo/src/vmobjects/VMArray.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMArray.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMArray.cpp.o.d"
+  "/root/repo/src/vmobjects/VMBigInteger.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMBigInteger.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMBigInteger.cpp.o.d"
+  "/root/repo/src/vmobjects/VMBlock.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMBlock.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMBlock.cpp.o.d"
+  "/root/repo/src/vmobjects/VMClass.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMClass.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMClass.cpp.o.d"
+  "/root/repo/src/vmobjects/VMDouble.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMDouble.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMDouble.cpp.o.d"
+  "/root/repo/src/vmobjects/VMEvaluationPrimitive.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMEvaluationPrimitive.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMEvaluationPrimitive.cpp.o.d"
+  "/root/repo/src/vmobjects/VMFrame.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMFrame.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMFrame.cpp.o.d"
+  "/root/repo/src/vmobjects/VMInteger.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMInteger.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMInteger.cpp.o.d"
+  "/root/repo/src/vmobjects/VMInvokable.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMInvokable.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMInvokable.cpp.o.d"
+  "/root/repo/src/vmobjects/VMMethod.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMMethod.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMMethod.cpp.o.d"
+  "/root/repo/src/vmobjects/VMObject.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMObject.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMObject.cpp.o.d"
+  "/root/repo/src/vmobjects/VMPrimitive.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMPrimitive.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMPrimitive.cpp.o.d"
+  "/root/repo/src/vmobjects/VMSafePrimitive.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMSafePrimitive.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMSafePrimitive.cpp.o.d"
+  "/root/repo/src/vmobjects/VMString.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMString.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMString.cpp.o.d"
+  "/root/repo/src/vmobjects/VMSymbol.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMSymbol.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMSymbol.cpp.o.d"
+  "/root/repo/src/vmobjects/VMTrivialMethod.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMTrivialMethod.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMTrivialMethod.cpp.o.d"
+  "/root/repo/src/vmobjects/VMVector.cpp" "CMakeFiles/SOM++.dir/src/vmobjects/VMVector.cpp.o" "gcc" "CMakeFiles/SOM++.dir/src/vmobjects/VMVector.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
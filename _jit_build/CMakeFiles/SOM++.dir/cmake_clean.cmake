@@ -0,0 +1,151 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SOM++.dir/src/Main.cpp.o"
+  "CMakeFiles/SOM++.dir/src/Main.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/compiler/BytecodeGenerator.cpp.o"
+  "CMakeFiles/SOM++.dir/src/compiler/BytecodeGenerator.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/compiler/ClassGenerationContext.cpp.o"
+  "CMakeFiles/SOM++.dir/src/compiler/ClassGenerationContext.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/compiler/Disassembler.cpp.o"
+  "CMakeFiles/SOM++.dir/src/compiler/Disassembler.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/compiler/Lexer.cpp.o"
+  "CMakeFiles/SOM++.dir/src/compiler/Lexer.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/compiler/MethodGenerationContext.cpp.o"
+  "CMakeFiles/SOM++.dir/src/compiler/MethodGenerationContext.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/compiler/Parser.cpp.o"
+  "CMakeFiles/SOM++.dir/src/compiler/Parser.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/compiler/SourcecodeCompiler.cpp.o"
+  "CMakeFiles/SOM++.dir/src/compiler/SourcecodeCompiler.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/compiler/Variable.cpp.o"
+  "CMakeFiles/SOM++.dir/src/compiler/Variable.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/interpreter/Interpreter.cpp.o"
+  "CMakeFiles/SOM++.dir/src/interpreter/Interpreter.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/interpreter/JIT.cpp.o"
+  "CMakeFiles/SOM++.dir/src/interpreter/JIT.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/interpreter/RegisterCode.cpp.o"
+  "CMakeFiles/SOM++.dir/src/interpreter/RegisterCode.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/interpreter/RegisterInterpreter.cpp.o"
+  "CMakeFiles/SOM++.dir/src/interpreter/RegisterInterpreter.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/interpreter/SequenceProfile.cpp.o"
+  "CMakeFiles/SOM++.dir/src/interpreter/SequenceProfile.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/interpreter/bytecodes.cpp.o"
+  "CMakeFiles/SOM++.dir/src/interpreter/bytecodes.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/memory/CopyingCollector.cpp.o"
+  "CMakeFiles/SOM++.dir/src/memory/CopyingCollector.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/memory/CopyingHeap.cpp.o"
+  "CMakeFiles/SOM++.dir/src/memory/CopyingHeap.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/memory/DebugCopyingCollector.cpp.o"
+  "CMakeFiles/SOM++.dir/src/memory/DebugCopyingCollector.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/memory/DebugCopyingHeap.cpp.o"
+  "CMakeFiles/SOM++.dir/src/memory/DebugCopyingHeap.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/memory/FrameStack.cpp.o"
+  "CMakeFiles/SOM++.dir/src/memory/FrameStack.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/memory/GenerationalCollector.cpp.o"
+  "CMakeFiles/SOM++.dir/src/memory/GenerationalCollector.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/memory/GenerationalHeap.cpp.o"
+  "CMakeFiles/SOM++.dir/src/memory/GenerationalHeap.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/memory/Heap.cpp.o"
+  "CMakeFiles/SOM++.dir/src/memory/Heap.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/memory/MarkSweepCollector.cpp.o"
+  "CMakeFiles/SOM++.dir/src/memory/MarkSweepCollector.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/memory/MarkSweepHeap.cpp.o"
+  "CMakeFiles/SOM++.dir/src/memory/MarkSweepHeap.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/misc/Murmur3Hash.cpp.o"
+  "CMakeFiles/SOM++.dir/src/misc/Murmur3Hash.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/misc/ParseInteger.cpp.o"
+  "CMakeFiles/SOM++.dir/src/misc/ParseInteger.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/misc/Timer.cpp.o"
+  "CMakeFiles/SOM++.dir/src/misc/Timer.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/misc/debug.cpp.o"
+  "CMakeFiles/SOM++.dir/src/misc/debug.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/Array.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/Array.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/Block.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/Block.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/Class.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/Class.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/Double.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/Double.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/Integer.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/Integer.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/Method.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/Method.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/Object.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/Object.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/Primitive.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/Primitive.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/String.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/String.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/Symbol.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/Symbol.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/System.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/System.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitives/Vector.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitives/Vector.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitivesCore/PrimitiveContainer.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitivesCore/PrimitiveContainer.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/primitivesCore/PrimitiveLoader.cpp.o"
+  "CMakeFiles/SOM++.dir/src/primitivesCore/PrimitiveLoader.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vm/Globals.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vm/Globals.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vm/IsValidObject.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vm/IsValidObject.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vm/LogAllocation.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vm/LogAllocation.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vm/Print.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vm/Print.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vm/Shell.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vm/Shell.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vm/Symbols.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vm/Symbols.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vm/Universe.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vm/Universe.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/AbstractObject.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/AbstractObject.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/InlineCache.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/InlineCache.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/IntegerBox.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/IntegerBox.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/Signature.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/Signature.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMArray.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMArray.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMBigInteger.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMBigInteger.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMBlock.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMBlock.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMClass.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMClass.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMDouble.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMDouble.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMEvaluationPrimitive.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMEvaluationPrimitive.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMFrame.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMFrame.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMInteger.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMInteger.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMInvokable.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMInvokable.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMMethod.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMMethod.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMObject.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMObject.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMPrimitive.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMPrimitive.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMSafePrimitive.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMSafePrimitive.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMString.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMString.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMSymbol.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMSymbol.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMTrivialMethod.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMTrivialMethod.cpp.o.d"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMVector.cpp.o"
+  "CMakeFiles/SOM++.dir/src/vmobjects/VMVector.cpp.o.d"
+  "SOM++"
+  "SOM++.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SOM++.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
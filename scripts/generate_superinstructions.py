@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+"""Generates src/interpreter/Superinstructions.h from bytecode sequence
+profiles.
+
+The profiles are the *_bytecode_sequences.csv files written by a SOM++ built
+with -DBYTECODE_SEQUENCE_PROFILE=ON. The sequences that save the most
+dispatches, summed over all profiles, become superinstructions.
+
+Usage:
+  scripts/generate_superinstructions.py --count 16 \\
+      --output src/interpreter/Superinstructions.h Bench_bytecode_sequences.csv
+"""
+import argparse
+from collections import defaultdict
+
+# keep in sync with CanPrecedeInSuperinstruction() in bytecodes.h
+CAN_PRECEDE = {
+    "DUP", "DUP_SECOND",
+    "PUSH_LOCAL", "PUSH_LOCAL_0", "PUSH_LOCAL_1", "PUSH_LOCAL_2",
+    "PUSH_ARGUMENT", "PUSH_SELF", "PUSH_ARG_1", "PUSH_ARG_2",
+    "PUSH_FIELD", "PUSH_FIELD_0", "PUSH_FIELD_1",
+    "PUSH_CONSTANT", "PUSH_CONSTANT_0", "PUSH_CONSTANT_1", "PUSH_CONSTANT_2",
+    "PUSH_0", "PUSH_1", "PUSH_NIL",
+    "POP", "POP_LOCAL", "POP_LOCAL_0", "POP_LOCAL_1", "POP_LOCAL_2",
+    "POP_ARGUMENT", "POP_FIELD", "POP_FIELD_0", "POP_FIELD_1",
+    "DEC", "INC_FIELD", "INC_FIELD_PUSH",
+}
+
+HEADER = """#pragma once
+
+// Generated by scripts/generate_superinstructions.py, do not edit.
+//
+// Each superinstruction is a sequence of bytecodes, of which all but the last
+// are simple bytecodes, see CanPrecedeInSuperinstruction() in bytecodes.h.
+// It replaces only the first bytecode of the sequence. The others stay in
+// place, and the superinstruction has the length of its first bytecode.
+//
+// V(name, first, second) and V(name, first, second, third), without the BC_
+// prefix.
+"""
+
+
+def is_valid(sequence):
+    return (all(bc in CAN_PRECEDE for bc in sequence[:-1])
+            and sequence[-1] != "HALT")
+
+
+def read_profiles(files):
+    counts = defaultdict(int)
+    for file_name in files:
+        with open(file_name) as csv:
+            for line in csv:
+                if line.startswith("#") or not line.strip():
+                    continue
+                fields = [f.strip() for f in line.split(",")]
+                counts[tuple(fields[1:])] += int(fields[0])
+    return counts
+
+
+def select(counts, count):
+    # a pair saves one dispatch, a triple two
+    candidates = [(c * (len(seq) - 1), seq) for seq, c in counts.items()
+                  if is_valid(seq)]
+    candidates.sort(key=lambda x: (-x[0], x[1]))
+    return [seq for _, seq in candidates[:count]]
+
+
+def write_header(file_name, sequences):
+    pairs = sorted(s for s in sequences if len(s) == 2)
+    triples = sorted(s for s in sequences if len(s) == 3)
+
+    with open(file_name, "w") as out:
+        out.write(HEADER)
+        out.write("\n// clang-format off\n")
+        bc = 0
+        for seq in pairs + triples:
+            out.write("#define BC_%-40s (FIRST_SUPERINSTRUCTION + %d)\n"
+                      % ("_".join(seq), bc))
+            bc += 1
+        out.write("\n#define NUM_SUPERINSTRUCTIONS %d\n" % len(sequences))
+
+        for name, seqs in (("PAIRS", pairs), ("TRIPLES", triples)):
+            out.write("\n#define SUPERINSTRUCTION_%s(V) \\\n" % name)
+            for seq in seqs:
+                out.write("    V(%s, %s) \\\n" % ("_".join(seq), ", ".join(seq)))
+            out.write("    /* end */\n")
+        out.write("// clang-format on\n")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description="Generate superinstructions from bytecode sequence "
+                    "profiles")
+    parser.add_argument("--count", type=int, default=16,
+                        help="number of superinstructions")
+    parser.add_argument("--output", required=True,
+                        help="the header file to write")
+    parser.add_argument("profiles", nargs="+",
+                        help="*_bytecode_sequences.csv files")
+    args = parser.parse_args()
+
+    write_header(args.output, select(read_profiles(args.profiles), args.count))
@@ -314,6 +314,46 @@ void EmitPOPFIELD(MethodGenerationContext& mgenc, const Parser& parser,
     EmitPopFieldWithIndex(mgenc, idx);
 }
 
+/// Returns the bytecode for a send of the given binary selector, which the
+/// interpreter handles directly for integers and doubles, or BC_SEND.
+static uint8_t binaryOperationBytecodeFor(VMSymbol* msg) {
+    const char* const sel = msg->GetRawChars();
+    size_t const length = msg->GetStringLength();
+
+    if (length == 1) {
+        switch (sel[0]) {
+            case '+':
+                return BC_ADD;
+            case '-':
+                return BC_SUB;
+            case '*':
+                return BC_MUL;
+            case '<':
+                return BC_LT;
+            case '>':
+                return BC_GT;
+            case '=':
+                return BC_EQ;
+            default:
+                return BC_SEND;
+        }
+    }
+
+    if (length == 2 && sel[1] == '=') {
+        switch (sel[0]) {
+            case '<':
+                return BC_LE;
+            case '>':
+                return BC_GE;
+            case '=':
+                return BC_EQ_EQ;
+            default:
+                return BC_SEND;
+        }
+    }
+    return BC_SEND;
+}
+
 void EmitSEND(MethodGenerationContext& mgenc, const Parser& parser,
               VMSymbol* msg) {
     const uint8_t idx = mgenc.AddLiteralIfAbsent(msg, parser);
@@ -321,7 +361,20 @@ void EmitSEND(MethodGenerationContext& mgenc, const Parser& parser,
     const uint8_t numArgs = Signature::GetNumberOfArguments(msg);
     const int64_t stackEffect = -numArgs + 1;  // +1 for the result
 
-    Emit2(mgenc, numArgs == 1 ? BC_SEND_1 : BC_SEND, idx, stackEffect);
+    uint8_t bytecode = BC_SEND;
+    if (numArgs == 1) {
+        bytecode = BC_SEND_1;
+    } else if (numArgs == 2) {
+        bytecode = binaryOperationBytecodeFor(msg);
+    }
+    Emit2(mgenc, bytecode, idx, stackEffect);
+
+    if (numArgs == 1) {
+        // a block that does a non-local return after its home context
+        // returned sends #escapedBlock: from the sender of #value, which
+        // needs room for the receiver and the block
+        mgenc.ReserveStackSlot();
+    }
 }
 
 void EmitSUPERSEND(MethodGenerationContext& mgenc, const Parser& parser,
@@ -331,6 +384,10 @@ void EmitSUPERSEND(MethodGenerationContext& mgenc, const Parser& parser,
     const int64_t stackEffect = -numArgs + 1;  // +1 for the result
 
     Emit2(mgenc, BC_SUPER_SEND, idx, stackEffect);
+
+    if (numArgs == 1) {
+        mgenc.ReserveStackSlot();
+    }
 }
 
 void EmitRETURNSELF(MethodGenerationContext& mgenc) {
@@ -78,7 +78,7 @@ void Disassembler::dispatch(vm_oop_t o) {
             DebugPrint("\"%s\"",
                        static_cast<VMString*>(o)->GetStdString().c_str());
         } else if (c == load_ptr(doubleClass)) {
-            DebugPrint("%g", static_cast<VMDouble*>(o)->GetEmbeddedDouble());
+            DebugPrint("%g", AS_DOUBLE(o));
         } else if (c == load_ptr(symbolClass)) {
             DebugPrint("#%s",
                        static_cast<VMSymbol*>(o)->GetStdString().c_str());
@@ -174,11 +174,12 @@ void Disassembler::dumpMethod(uint8_t* bytecodes, size_t numberOfBytecodes,
     // output bytecodes
     for (size_t bc_idx = 0; bc_idx < numberOfBytecodes;
          bc_idx += Bytecode::GetBytecodeLength(bytecodes[bc_idx])) {
-        // the bytecode.
-        uint8_t const bytecode = bytecodes[bc_idx];
+        // the bytecode. Superinstructions are printed with the parameters
+        // of their first bytecode
+        uint8_t const bytecode = Bytecode::GetBaseBytecode(bytecodes[bc_idx]);
         // indent, bytecode index, bytecode mnemonic
         DebugDump("%s%4d:%s  ", indent, bc_idx,
-                  Bytecode::GetBytecodeName(bytecode));
+                  Bytecode::GetBytecodeName(bytecodes[bc_idx]));
 #ifdef BYTECODE_HEATMAP
         if (method != nullptr) {
             DebugPrint("[hits: %llu] ",
@@ -312,7 +313,20 @@ void Disassembler::dumpMethod(uint8_t* bytecodes, size_t numberOfBytecodes,
                 break;
             }
             case BC_SEND:
-            case BC_SEND_1: {
+            case BC_SEND_1:
+            case BC_ADD:
+            case BC_SUB:
+            case BC_MUL:
+            case BC_LT:
+            case BC_GT:
+            case BC_LE:
+            case BC_GE:
+            case BC_EQ:
+            case BC_EQ_EQ:
+            case BC_DIV_DOUBLE:
+            case BC_AT_ARRAY:
+            case BC_AT_PUT_ARRAY:
+            case BC_INST_VAR_NAMED: {
                 if (method != nullptr && printObjects) {
                     auto* name =
                         static_cast<VMSymbol*>(method->GetConstant(bc_idx));
@@ -445,7 +459,7 @@ void Disassembler::DumpBytecode(VMFrame* frame, VMMethod* method,
                                 size_t bc_idx) {
     static int64_t indentc = 0;
     static char ikind = '@';
-    uint8_t const bc = BC_0;
+    uint8_t const bc = Bytecode::GetBaseBytecode(BC_0);
     VMClass* cl = method->GetHolder();
 
     // Determine Context: Class or Block?
@@ -455,12 +469,12 @@ void Disassembler::DumpBytecode(VMFrame* frame, VMMethod* method,
 
         DebugTrace("%20s>>%-20s% 10lld %c %04d: %s\t",
                    cname->GetStdString().c_str(), sig->GetStdString().c_str(),
-                   indentc, ikind, bc_idx, Bytecode::GetBytecodeName(bc));
+                   indentc, ikind, bc_idx, Bytecode::GetBytecodeName(BC_0));
     } else {
         VMSymbol* sig = method->GetSignature();
 
         DebugTrace("%-42s% 10lld %c %04d: %s\t", sig->GetStdString().c_str(),
-                   indentc, ikind, bc_idx, Bytecode::GetBytecodeName(bc));
+                   indentc, ikind, bc_idx, Bytecode::GetBytecodeName(BC_0));
     }
     // reset send indicator
     if (ikind != '@') {
@@ -666,7 +680,20 @@ void Disassembler::DumpBytecode(VMFrame* frame, VMMethod* method,
         }
         case BC_SUPER_SEND:
         case BC_SEND:
-        case BC_SEND_1: {
+        case BC_SEND_1:
+        case BC_ADD:
+        case BC_SUB:
+        case BC_MUL:
+        case BC_LT:
+        case BC_GT:
+        case BC_LE:
+        case BC_GE:
+        case BC_EQ:
+        case BC_EQ_EQ:
+        case BC_DIV_DOUBLE:
+        case BC_AT_ARRAY:
+        case BC_AT_PUT_ARRAY:
+        case BC_INST_VAR_NAMED: {
             auto* sel = static_cast<VMSymbol*>(method->GetConstant(bc_idx));
 
             DebugPrint("(index: %d) signature: %s (", BC_1,
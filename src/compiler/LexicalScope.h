@@ -22,6 +22,8 @@ public:
         return locals.size();
     }
 
+    [[nodiscard]] inline bool IsBlockScope() const { return outer != nullptr; }
+
     void AddInlinedLocal(Variable& var) {
         assert(var.GetIndex() == locals.size());
         locals.push_back(var);
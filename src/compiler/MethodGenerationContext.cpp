@@ -86,6 +86,12 @@ VMInvokable* MethodGenerationContext::Assemble() {
         meth->SetBytecode(i, bytecode[i]);
     }
 
+    // blocks are fused with their outer method, since they may still be
+    // inlined until then
+    if (!IsBlockMethod()) {
+        meth->FuseSuperinstructions();
+    }
+
     // return the method - the holder field is to be set later on!
     return meth;
 }
@@ -440,6 +446,10 @@ void MethodGenerationContext::AddBytecode(uint8_t bc, int64_t stackEffect) {
     last4Bytecodes[3] = bc;
 }
 
+void MethodGenerationContext::ReserveStackSlot() {
+    maxStackDepth = max(maxStackDepth, currentStackDepth + 1);
+}
+
 void MethodGenerationContext::AddBytecodeArgument(uint8_t arg) {
     bytecode.push_back(arg);
 }
@@ -96,6 +96,10 @@ public:
 
     uint8_t GetNumberOfArguments();
     void AddBytecode(uint8_t bc, int64_t stackEffect);
+
+    /// Makes sure that the stack has room for one more element than it
+    /// currently holds.
+    void ReserveStackSlot();
     void AddBytecodeArgument(uint8_t arg);
     size_t AddBytecodeArgumentAndGetIndex(size_t bc);
 
@@ -794,7 +794,7 @@ vm_oop_t Parser::literalDouble(bool negateValue) {
         d = 0 - d;
     }
     expect(Double);
-    return Universe::NewDouble(d);
+    return NEW_DOUBLE(d);
 }
 
 void Parser::literalSymbol(MethodGenerationContext& mgenc) {
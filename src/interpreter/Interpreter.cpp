@@ -29,16 +29,23 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
 #include "../compiler/Disassembler.h"
 #include "../interpreter/bytecodes.h"  // NOLINT(misc-include-cleaner) it's required for InterpreterLoop.h
+#include "../interpreter/JIT.h"
+#include "../interpreter/RegisterCode.h"
+#include "../interpreter/RegisterInterpreter.h"
+#include "../interpreter/SequenceProfile.h"
+#include "../memory/FrameStack.h"
 #include "../memory/Heap.h"
 #include "../misc/defs.h"
 #include "../vm/Globals.h"
 #include "../vm/IsValidObject.h"
 #include "../vm/Print.h"
 #include "../vm/Universe.h"
+#include "../vmobjects/InlineCache.h"
 #include "../vmobjects/IntegerBox.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/Signature.h"
@@ -66,6 +73,85 @@ VMMethod* Interpreter::method = nullptr;
 size_t Interpreter::bytecodeIndexGlobal;
 uint8_t* Interpreter::currentBytecodes;
 
+#if GC_TYPE == GENERATIONAL
+InlineCache* Interpreter::sendSite = nullptr;
+#endif
+
+template <uint8_t BC>
+void Interpreter::doSuperinstructionPart(size_t bytecodeIndex) {
+    static_assert(CanPrecedeInSuperinstruction(BC),
+                  "only simple bytecodes can start a superinstruction");
+
+    if constexpr (BC == BC_DUP) {
+        doDup();
+    } else if constexpr (BC == BC_DUP_SECOND) {
+        vm_oop_t elem = GetFrame()->GetStackElement(1);
+        GetFrame()->Push(elem);
+    } else if constexpr (BC == BC_PUSH_LOCAL) {
+        doPushLocal(bytecodeIndex);
+    } else if constexpr (BC >= BC_PUSH_LOCAL_0 && BC <= BC_PUSH_LOCAL_2) {
+        doPushLocalWithIndex(BC - BC_PUSH_LOCAL_0);
+    } else if constexpr (BC == BC_PUSH_ARGUMENT) {
+        doPushArgument(bytecodeIndex);
+    } else if constexpr (BC >= BC_PUSH_SELF && BC <= BC_PUSH_ARG_2) {
+        vm_oop_t argument =
+            GetFrame()->GetArgumentInCurrentContext(BC - BC_PUSH_SELF);
+        GetFrame()->Push(argument);
+    } else if constexpr (BC == BC_PUSH_FIELD) {
+        doPushField(bytecodeIndex);
+    } else if constexpr (BC == BC_PUSH_FIELD_0 || BC == BC_PUSH_FIELD_1) {
+        doPushFieldWithIndex(BC - BC_PUSH_FIELD_0);
+    } else if constexpr (BC == BC_PUSH_CONSTANT) {
+        doPushConstant(bytecodeIndex);
+    } else if constexpr (BC >= BC_PUSH_CONSTANT_0 && BC <= BC_PUSH_CONSTANT_2) {
+        vm_oop_t constant = method->GetIndexableField(BC - BC_PUSH_CONSTANT_0);
+        GetFrame()->Push(constant);
+    } else if constexpr (BC == BC_PUSH_0 || BC == BC_PUSH_1) {
+        GetFrame()->Push(NEW_INT(BC - BC_PUSH_0));
+    } else if constexpr (BC == BC_PUSH_NIL) {
+        GetFrame()->Push(load_ptr(nilObject));
+    } else if constexpr (BC == BC_POP) {
+        doPop();
+    } else if constexpr (BC == BC_POP_LOCAL) {
+        doPopLocal(bytecodeIndex);
+    } else if constexpr (BC >= BC_POP_LOCAL_0 && BC <= BC_POP_LOCAL_2) {
+        doPopLocalWithIndex(BC - BC_POP_LOCAL_0);
+    } else if constexpr (BC == BC_POP_ARGUMENT) {
+        doPopArgument(bytecodeIndex);
+    } else if constexpr (BC == BC_POP_FIELD) {
+        doPopField(bytecodeIndex);
+    } else if constexpr (BC == BC_POP_FIELD_0 || BC == BC_POP_FIELD_1) {
+        doPopFieldWithIndex(BC - BC_POP_FIELD_0);
+    } else if constexpr (BC == BC_DEC) {
+        doDec();
+    } else if constexpr (BC == BC_INC_FIELD) {
+        doIncField(currentBytecodes[bytecodeIndex + 1]);
+    } else if constexpr (BC == BC_INC_FIELD_PUSH) {
+        doIncFieldPush(currentBytecodes[bytecodeIndex + 1]);
+    }
+}
+
+#ifdef TOP_OF_STACK_CACHING
+// Bytecodes that get their own spill code in the cached state, instead of the
+// shared TOS_SPILL, so that they are reached with a direct jump. These are the
+// ones that commonly follow a push.
+  #define TOS_SPILLING_BYTECODES(V)                                         \
+      V(BC_PUSH_LOCAL)                                                      \
+      V(BC_PUSH_LOCAL_0) V(BC_PUSH_LOCAL_1) V(BC_PUSH_LOCAL_2)              \
+      V(BC_PUSH_ARGUMENT)                                                   \
+      V(BC_PUSH_SELF) V(BC_PUSH_ARG_1) V(BC_PUSH_ARG_2)                     \
+      V(BC_PUSH_FIELD) V(BC_PUSH_FIELD_0) V(BC_PUSH_FIELD_1)                \
+      V(BC_PUSH_CONSTANT)                                                   \
+      V(BC_PUSH_CONSTANT_0) V(BC_PUSH_CONSTANT_1) V(BC_PUSH_CONSTANT_2)     \
+      V(BC_PUSH_0) V(BC_PUSH_1) V(BC_PUSH_NIL) V(BC_PUSH_GLOBAL)            \
+      V(BC_SEND) V(BC_SEND_1) V(BC_RETURN_LOCAL) V(BC_RETURN_NON_LOCAL)     \
+      V(BC_INC) V(BC_DEC) V(BC_POP_FIELD_0) V(BC_POP_FIELD_1)               \
+      V(BC_JUMP_ON_FALSE_POP) V(BC_JUMP_ON_TRUE_POP)                        \
+      V(BC_ADD) V(BC_SUB) V(BC_MUL) V(BC_LT) V(BC_GT) V(BC_LE) V(BC_GE)     \
+      V(BC_EQ) V(BC_EQ_EQ) V(BC_AT_ARRAY) V(BC_AT_PUT_ARRAY)              \
+      V(BC_INST_VAR_NAMED)
+#endif
+
 template <bool PrintBytecodes>
 vm_oop_t Interpreter::Start() {
 #ifdef BYTECODE_HEATMAP
@@ -79,8 +165,50 @@ vm_oop_t Interpreter::Start() {
             disassembleMethod();          \
         }                                 \
         HEATMAP_INC();                    \
+        SEQUENCE_PROFILE_INC();           \
         bytecodeIndexGlobal += (bcCount); \
     }
+#if defined(USE_JIT)
+  // continue in compiled code, when the current method has some. This is
+  // checked where the current method changes, and on back edges
+  #define TIER_ENTER()                                                   \
+      {                                                                  \
+          if constexpr (!PrintBytecodes) {                               \
+              if (unlikely(method->GetCompiledCode() != nullptr)) {      \
+                  JIT::Run();                                            \
+              }                                                          \
+          }                                                              \
+      }
+  #define TIER_BACK_EDGE()                                   \
+      {                                                      \
+          if (useJIT && unlikely(method->CountBackEdge())) { \
+              JIT::Compile(method);                          \
+          }                                                  \
+          TIER_ENTER();                                      \
+      }
+#elif defined(USE_REGISTER_BYTECODES)
+  // continue in register code, when the current method has some and it can
+  // be entered at the current bytecode
+  #define TIER_ENTER()                                                   \
+      {                                                                  \
+          if constexpr (!PrintBytecodes) {                               \
+              if (unlikely(method->GetRegisterCode() != nullptr)) {      \
+                  RegisterInterpreter::Run();                            \
+              }                                                          \
+          }                                                              \
+      }
+  #define TIER_BACK_EDGE()                                   \
+      {                                                      \
+          if (useRegisterBytecodes &&                        \
+              unlikely(method->CountBackEdge())) {           \
+              RegisterCode::Translate(method);               \
+          }                                                  \
+          TIER_ENTER();                                      \
+      }
+#else
+  #define TIER_ENTER() ((void)0)
+  #define TIER_BACK_EDGE() ((void)0)
+#endif
 
     // initialization
     method = GetMethod();
@@ -152,7 +280,73 @@ vm_oop_t Interpreter::Start() {
                            &&LABEL_BC_JUMP2_ON_NOT_NIL_TOP_TOP,
                            &&LABEL_BC_JUMP2_ON_NIL_TOP_TOP,
                            &&LABEL_BC_JUMP2_IF_GREATER,
-                           &&LABEL_BC_JUMP2_BACKWARD};
+                           &&LABEL_BC_JUMP2_BACKWARD,
+                           &&LABEL_BC_ADD,
+                           &&LABEL_BC_SUB,
+                           &&LABEL_BC_MUL,
+                           &&LABEL_BC_LT,
+                           &&LABEL_BC_GT,
+                           &&LABEL_BC_LE,
+                           &&LABEL_BC_GE,
+                           &&LABEL_BC_EQ,
+                           &&LABEL_BC_EQ_EQ,
+                           &&LABEL_BC_DIV_DOUBLE,
+                           &&LABEL_BC_AT_ARRAY,
+                           &&LABEL_BC_AT_PUT_ARRAY,
+                           &&LABEL_BC_INST_VAR_NAMED,
+#define SUPERINSTRUCTION_PAIR_TARGET(name, first, second) &&LABEL_BC_##name,
+#define SUPERINSTRUCTION_TRIPLE_TARGET(name, first, second, third) \
+    &&LABEL_BC_##name,
+                           SUPERINSTRUCTION_PAIRS(SUPERINSTRUCTION_PAIR_TARGET)
+                               SUPERINSTRUCTION_TRIPLES(
+                                   SUPERINSTRUCTION_TRIPLE_TARGET)};
+#undef SUPERINSTRUCTION_PAIR_TARGET
+#undef SUPERINSTRUCTION_TRIPLE_TARGET
+
+#ifdef TOP_OF_STACK_CACHING
+    // With top-of-stack caching, the interpreter has two states. In the
+    // uncached state, which all LABEL_BC_* labels expect, the operand stack
+    // is completely in the frame. In the cached state, its top element is in
+    // `tos` instead, and bytecodes dispatch via cachedTargets to the
+    // CACHED_BC_* labels. Most of them spill `tos` to the frame, and continue
+    // in the uncached state. Thus, everything that sends, returns, or reaches
+    // a GC safepoint sees the whole stack in the frame.
+    vm_oop_t tos = nullptr;
+
+    void* cachedTargets[_LAST_BYTECODE + 1];
+    for (void*& target : cachedTargets) {
+        target = &&TOS_SPILL;
+    }
+    if constexpr (!PrintBytecodes) {
+        // the disassembler prints the stack, and needs it in the frame
+        cachedTargets[BC_DUP] = &&CACHED_BC_DUP;
+        cachedTargets[BC_POP] = &&CACHED_BC_POP;
+        cachedTargets[BC_POP_LOCAL] = &&CACHED_BC_POP_LOCAL;
+        cachedTargets[BC_POP_LOCAL_0] = &&CACHED_BC_POP_LOCAL_0;
+        cachedTargets[BC_POP_LOCAL_1] = &&CACHED_BC_POP_LOCAL_1;
+        cachedTargets[BC_POP_LOCAL_2] = &&CACHED_BC_POP_LOCAL_2;
+
+  #define TOS_SPILL_TARGET(bc) cachedTargets[bc] = &&CACHED_##bc;
+        TOS_SPILLING_BYTECODES(TOS_SPILL_TARGET)
+  #undef TOS_SPILL_TARGET
+    }
+
+  #define DISPATCH_CACHED()                                           \
+      {                                                               \
+          goto* cachedTargets[currentBytecodes[bytecodeIndexGlobal]]; \
+      }
+  #define PUSH_AND_DISPATCH(value) \
+      {                            \
+          tos = (value);           \
+          DISPATCH_CACHED();       \
+      }
+#else
+  #define PUSH_AND_DISPATCH(value)  \
+      {                             \
+          GetFrame()->Push(value);  \
+          DISPATCH_NOGC();          \
+      }
+#endif
 
     goto* loopTargets[currentBytecodes[bytecodeIndexGlobal]];
 
@@ -182,18 +376,15 @@ LABEL_BC_PUSH_LOCAL:
 
 LABEL_BC_PUSH_LOCAL_0:
     PROLOGUE(1);
-    doPushLocalWithIndex(0);
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(GetFrame()->GetLocalInCurrentContext(0));
 
 LABEL_BC_PUSH_LOCAL_1:
     PROLOGUE(1);
-    doPushLocalWithIndex(1);
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(GetFrame()->GetLocalInCurrentContext(1));
 
 LABEL_BC_PUSH_LOCAL_2:
     PROLOGUE(1);
-    doPushLocalWithIndex(2);
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(GetFrame()->GetLocalInCurrentContext(2));
 
 LABEL_BC_PUSH_ARGUMENT:
     PROLOGUE(3);
@@ -202,27 +393,15 @@ LABEL_BC_PUSH_ARGUMENT:
 
 LABEL_BC_PUSH_SELF:
     PROLOGUE(1);
-    {
-        vm_oop_t argument = GetFrame()->GetArgumentInCurrentContext(0);
-        GetFrame()->Push(argument);
-    }
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(GetFrame()->GetArgumentInCurrentContext(0));
 
 LABEL_BC_PUSH_ARG_1:
     PROLOGUE(1);
-    {
-        vm_oop_t argument = GetFrame()->GetArgumentInCurrentContext(1);
-        GetFrame()->Push(argument);
-    }
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(GetFrame()->GetArgumentInCurrentContext(1));
 
 LABEL_BC_PUSH_ARG_2:
     PROLOGUE(1);
-    {
-        vm_oop_t argument = GetFrame()->GetArgumentInCurrentContext(2);
-        GetFrame()->Push(argument);
-    }
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(GetFrame()->GetArgumentInCurrentContext(2));
 
 LABEL_BC_PUSH_FIELD:
     PROLOGUE(2);
@@ -251,42 +430,27 @@ LABEL_BC_PUSH_CONSTANT:
 
 LABEL_BC_PUSH_CONSTANT_0:
     PROLOGUE(1);
-    {
-        vm_oop_t constant = method->GetIndexableField(0);
-        GetFrame()->Push(constant);
-    }
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(method->GetIndexableField(0));
 
 LABEL_BC_PUSH_CONSTANT_1:
     PROLOGUE(1);
-    {
-        vm_oop_t constant = method->GetIndexableField(1);
-        GetFrame()->Push(constant);
-    }
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(method->GetIndexableField(1));
 
 LABEL_BC_PUSH_CONSTANT_2:
     PROLOGUE(1);
-    {
-        vm_oop_t constant = method->GetIndexableField(2);
-        GetFrame()->Push(constant);
-    }
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(method->GetIndexableField(2));
 
 LABEL_BC_PUSH_0:
     PROLOGUE(1);
-    GetFrame()->Push(NEW_INT(0));
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(NEW_INT(0));
 
 LABEL_BC_PUSH_1:
     PROLOGUE(1);
-    GetFrame()->Push(NEW_INT(1));
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(NEW_INT(1));
 
 LABEL_BC_PUSH_NIL:
     PROLOGUE(1);
-    GetFrame()->Push(load_ptr(nilObject));
-    DISPATCH_NOGC();
+    PUSH_AND_DISPATCH(load_ptr(nilObject));
 
 LABEL_BC_PUSH_GLOBAL:
     PROLOGUE(2);
@@ -341,26 +505,31 @@ LABEL_BC_POP_FIELD_1:
 LABEL_BC_SEND:
     PROLOGUE(2);
     doSend(bytecodeIndexGlobal - 2);
+    TIER_ENTER();
     DISPATCH_GC();
 
 LABEL_BC_SEND_1:
     PROLOGUE(2);
     doUnarySend(bytecodeIndexGlobal - 2);
+    TIER_ENTER();
     DISPATCH_GC();
 
 LABEL_BC_SUPER_SEND:
     PROLOGUE(2);
     doSuperSend(bytecodeIndexGlobal - 2);
+    TIER_ENTER();
     DISPATCH_GC();
 
 LABEL_BC_RETURN_LOCAL:
     PROLOGUE(1);
     doReturnLocal();
+    TIER_ENTER();
     DISPATCH_NOGC();
 
 LABEL_BC_RETURN_NON_LOCAL:
     PROLOGUE(1);
     doReturnNonLocal();
+    TIER_ENTER();
     DISPATCH_NOGC();
 
 LABEL_BC_RETURN_SELF: {
@@ -368,22 +537,26 @@ LABEL_BC_RETURN_SELF: {
     assert(GetFrame()->GetContext() == nullptr &&
            "RETURN_SELF is not allowed in blocks");
     popFrameAndPushResult(GetFrame()->GetArgumentInCurrentContext(0));
+    TIER_ENTER();
     DISPATCH_NOGC();
 }
 
 LABEL_BC_RETURN_FIELD_0:
     PROLOGUE(1);
     doReturnFieldWithIndex(0);
+    TIER_ENTER();
     DISPATCH_NOGC();
 
 LABEL_BC_RETURN_FIELD_1:
     PROLOGUE(1);
     doReturnFieldWithIndex(1);
+    TIER_ENTER();
     DISPATCH_NOGC();
 
 LABEL_BC_RETURN_FIELD_2:
     PROLOGUE(1);
     doReturnFieldWithIndex(2);
+    TIER_ENTER();
     DISPATCH_NOGC();
 
 LABEL_BC_INC:
@@ -533,6 +706,7 @@ LABEL_BC_JUMP_BACKWARD: {
     uint8_t const offset = currentBytecodes[bytecodeIndexGlobal + 1];
     bytecodeIndexGlobal -= offset;
 }
+    TIER_BACK_EDGE();
     DISPATCH_NOGC();
 
 LABEL_BC_JUMP2: {
@@ -678,15 +852,158 @@ LABEL_BC_JUMP2_BACKWARD: {
                       currentBytecodes[bytecodeIndexGlobal + 2]);
     bytecodeIndexGlobal -= offset;
 }
+    TIER_BACK_EDGE();
     DISPATCH_NOGC();
+
+LABEL_BC_ADD:
+    PROLOGUE(2);
+    doArithmetic<ADD>(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_SUB:
+    PROLOGUE(2);
+    doArithmetic<SUB>(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_MUL:
+    PROLOGUE(2);
+    doArithmetic<MUL>(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_LT:
+    PROLOGUE(2);
+    doComparison<LT>(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_GT:
+    PROLOGUE(2);
+    doComparison<GT>(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_LE:
+    PROLOGUE(2);
+    doComparison<LE>(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_GE:
+    PROLOGUE(2);
+    doComparison<GE>(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_EQ:
+    PROLOGUE(2);
+    doComparison<EQ>(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_EQ_EQ:
+    PROLOGUE(2);
+    doIdentityEquals(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_DIV_DOUBLE:
+    PROLOGUE(2);
+    doDoubleDivision(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_AT_ARRAY:
+    PROLOGUE(2);
+    doArrayAt(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_AT_PUT_ARRAY:
+    PROLOGUE(2);
+    doArrayAtPut(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+LABEL_BC_INST_VAR_NAMED:
+    PROLOGUE(2);
+    doInstVarNamed(bytecodeIndexGlobal - 2);
+    DISPATCH_GC();
+
+#ifdef TOP_OF_STACK_CACHING
+TOS_SPILL:
+    GetFrame()->Push(tos);
+    DISPATCH_NOGC();
+
+CACHED_BC_DUP:
+    PROLOGUE(1);
+    GetFrame()->Push(tos);
+    DISPATCH_CACHED();
+
+CACHED_BC_POP:
+    PROLOGUE(1);
+    DISPATCH_NOGC();
+
+CACHED_BC_POP_LOCAL:
+    PROLOGUE(3);
+    GetFrame()->SetLocal(currentBytecodes[bytecodeIndexGlobal - 2],
+                         currentBytecodes[bytecodeIndexGlobal - 1], tos);
+    DISPATCH_NOGC();
+
+CACHED_BC_POP_LOCAL_0:
+    PROLOGUE(1);
+    GetFrame()->SetLocal(0, tos);
+    DISPATCH_NOGC();
+
+CACHED_BC_POP_LOCAL_1:
+    PROLOGUE(1);
+    GetFrame()->SetLocal(1, tos);
+    DISPATCH_NOGC();
+
+CACHED_BC_POP_LOCAL_2:
+    PROLOGUE(1);
+    GetFrame()->SetLocal(2, tos);
+    DISPATCH_NOGC();
+
+    // spill, and continue directly with the uncached bytecode
+  #define TOS_SPILL_LABEL(bc)    \
+      CACHED_##bc:               \
+      GetFrame()->Push(tos);     \
+      goto LABEL_##bc;
+    TOS_SPILLING_BYTECODES(TOS_SPILL_LABEL)
+  #undef TOS_SPILL_LABEL
+#endif
+
+    // A superinstruction executes its leading bytecodes directly, and then
+    // jumps to the label of its last one, which is still in place. Since the
+    // last one may have been quickened since, it is checked first.
+#define SUPERINSTRUCTION_PART(bc)                                       \
+    PROLOGUE(Bytecode::GetBytecodeLength(bc));                          \
+    doSuperinstructionPart<bc>(bytecodeIndexGlobal -                    \
+                               Bytecode::GetBytecodeLength(bc));
+#define SUPERINSTRUCTION_LAST_PART(bc)                                  \
+    if (likely(currentBytecodes[bytecodeIndexGlobal] == (bc))) {        \
+        goto LABEL_##bc;                                                \
+    }                                                                   \
+    DISPATCH_NOGC();
+#define SUPERINSTRUCTION_PAIR_LABEL(name, first, second)                \
+    LABEL_BC_##name : SUPERINSTRUCTION_PART(BC_##first)                 \
+                          SUPERINSTRUCTION_LAST_PART(BC_##second)
+#define SUPERINSTRUCTION_TRIPLE_LABEL(name, first, second, third)       \
+    LABEL_BC_##name : SUPERINSTRUCTION_PART(BC_##first)                 \
+                          SUPERINSTRUCTION_PART(BC_##second)            \
+                              SUPERINSTRUCTION_LAST_PART(BC_##third)
+
+    SUPERINSTRUCTION_PAIRS(SUPERINSTRUCTION_PAIR_LABEL)
+    SUPERINSTRUCTION_TRIPLES(SUPERINSTRUCTION_TRIPLE_LABEL)
+
+#undef SUPERINSTRUCTION_PART
+#undef SUPERINSTRUCTION_LAST_PART
+#undef SUPERINSTRUCTION_PAIR_LABEL
+#undef SUPERINSTRUCTION_TRIPLE_LABEL
 }
 
 template vm_oop_t Interpreter::Start<true>();
 template vm_oop_t Interpreter::Start<false>();
 
 VMFrame* Interpreter::PushNewFrame(VMMethod* method) {
-    SetFrame(Universe::NewFrame(GetFrame(), method));
-    return GetFrame();
+    VMFrame* frm = FrameStack::NewFrame(GetFrame(), method);
+    if (unlikely(frm == nullptr)) {
+        // the frame stack is exhausted, fall back to the heap
+        frm = Universe::NewFrame(GetFrame(), method);
+    }
+    SetFrame(frm);
+    return frm;
 }
 
 void Interpreter::SetFrame(VMFrame* frm) {
@@ -713,10 +1030,11 @@ VMFrame* Interpreter::popFrame() {
 
     result->ClearPreviousFrame();
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    // remember this frame as free frame
-    result->GetMethod()->SetCachedFrame(result);
-#endif
+    // the memory stays valid until the next frame is pushed, which is all
+    // the callers need
+    if (result->IsOnStack()) {
+        FrameStack::Release(result);
+    }
     return result;
 }
 
@@ -733,8 +1051,42 @@ void Interpreter::popFrameAndPushResult(vm_oop_t result) {
     GetFrame()->Push(result);
 }
 
-void Interpreter::send(VMSymbol* signature, VMClass* receiverClass) {
-    VMInvokable* invokable = receiverClass->LookupInvokable(signature);
+VMInvokable* Interpreter::lookupWithInlineCache(VMSymbol* signature,
+                                                VMClass* receiverClass,
+                                                size_t bytecodeIndex) {
+    InlineCache* cache = method->GetInlineCache(bytecodeIndex);
+    VMInvokable* invokable = cache->Lookup(receiverClass);
+    if (likely(invokable != nullptr)) {
+        return invokable;
+    }
+
+    invokable = receiverClass->LookupInvokable(signature);
+    if (invokable != nullptr) {
+        cache->Update(method, receiverClass, invokable);
+    }
+    return invokable;
+}
+
+void Interpreter::enterSendSite(
+    [[maybe_unused]] VMInvokable* invokable,
+    [[maybe_unused]] size_t bytecodeIndex) {
+#if GC_TYPE == GENERATIONAL
+    if (invokable->IsSafePrimitive()) {
+        sendSite = method->GetInlineCache(bytecodeIndex);
+    }
+#endif
+}
+
+void Interpreter::leaveSendSite() {
+#if GC_TYPE == GENERATIONAL
+    sendSite = nullptr;
+#endif
+}
+
+void Interpreter::send(VMSymbol* signature, VMClass* receiverClass,
+                       size_t bytecodeIndex) {
+    VMInvokable* invokable =
+        lookupWithInlineCache(signature, receiverClass, bytecodeIndex);
 
     if (invokable != nullptr) {
 #ifdef LOG_RECEIVER_TYPES
@@ -748,12 +1100,295 @@ void Interpreter::send(VMSymbol* signature, VMClass* receiverClass) {
         }
 #endif
 
+        tryQuickening(bytecodeIndex, signature, invokable);
+        enterSendSite(invokable, bytecodeIndex);
         invokable->Invoke(GetFrame());
+        leaveSendSite();
     } else {
         triggerDoesNotUnderstand(signature);
     }
 }
 
+void Interpreter::tryQuickening(size_t bytecodeIndex, VMSymbol* signature,
+                                VMInvokable* invokable) {
+    // binary operations fall back to a send, but are not quickened further
+    if (method->GetBytecode(bytecodeIndex) != BC_SEND) {
+        return;
+    }
+
+    InlineCache* cache = method->GetInlineCache(bytecodeIndex);
+    if (cache->IsQuickeningDisabled()) {
+        return;
+    }
+
+    // only sites that so far only saw a single receiver class and that
+    // resolve to a primitive are candidates
+    uint8_t bc = BC_INVALID;
+    if (cache->GetNumberOfEntries() == 1 && invokable->IsPrimitive()) {
+        bc = quickenedBytecodeFor(signature);
+    }
+
+    if (bc == BC_INVALID) {
+        cache->DisableQuickening();
+        return;
+    }
+
+    assert(Bytecode::GetBytecodeLength(bc) ==
+           Bytecode::GetBytecodeLength(BC_SEND));
+    method->SetBytecode(bytecodeIndex, bc);
+}
+
+uint8_t Interpreter::quickenedBytecodeFor(VMSymbol* signature) {
+    const char* const sel = signature->GetRawChars();
+    size_t const length = signature->GetStringLength();
+
+    if (length == 7 && strncmp(sel, "at:put:", 7) == 0) {
+        vm_oop_t rcvr = GetFrame()->GetStackElement(2);
+        vm_oop_t idx = GetFrame()->GetStackElement(1);
+        if (CLASS_OF(rcvr) == load_ptr(arrayClass) && IS_SMALL_INT(idx)) {
+            return BC_AT_PUT_ARRAY;
+        }
+        return BC_INVALID;
+    }
+
+    vm_oop_t arg = GetFrame()->Top();
+    vm_oop_t rcvr = GetFrame()->Top2();
+
+    if (length == 13 && strncmp(sel, "instVarNamed:", 13) == 0) {
+        if (!IS_TAGGED(rcvr) && CLASS_OF(arg) == load_ptr(symbolClass)) {
+            return BC_INST_VAR_NAMED;
+        }
+        return BC_INVALID;
+    }
+
+    if (length > 3) {
+        return BC_INVALID;
+    }
+
+    if (length == 3) {
+        if (strncmp(sel, "at:", 3) == 0 &&
+            CLASS_OF(rcvr) == load_ptr(arrayClass) && IS_SMALL_INT(arg)) {
+            return BC_AT_ARRAY;
+        }
+        return BC_INVALID;
+    }
+
+    if (length == 2 && sel[0] == '/' && sel[1] == '/' && IS_DOUBLE(rcvr) &&
+        (IS_DOUBLE(arg) || IS_SMALL_INT(arg))) {
+        return BC_DIV_DOUBLE;
+    }
+    return BC_INVALID;
+}
+
+void Interpreter::deoptimizeQuickenedSend(size_t bytecodeIndex) {
+    // the operands do not match what the bytecode was specialized for,
+    // go back to a normal send, and stay there
+    method->SetBytecode(bytecodeIndex, BC_SEND);
+    method->GetInlineCache(bytecodeIndex)->DisableQuickening();
+    doSend(bytecodeIndex);
+}
+
+template <Interpreter::ArithmeticOp op>
+void Interpreter::doArithmetic(size_t bytecodeIndex) {
+    vm_oop_t arg = GetFrame()->Top();
+    vm_oop_t rcvr = GetFrame()->Top2();
+    vm_oop_t val = nullptr;
+
+    if (likely(IS_SMALL_INT(rcvr) && IS_SMALL_INT(arg))) {
+        int64_t const left = SMALL_INT_VAL(rcvr);
+        int64_t const right = SMALL_INT_VAL(arg);
+        int64_t result = 0;
+        bool overflow = false;
+
+        if constexpr (op == ADD) {
+            overflow = __builtin_add_overflow(left, right, &result);
+        } else if constexpr (op == SUB) {
+            overflow = __builtin_sub_overflow(left, right, &result);
+        } else {
+            static_assert(op == MUL, "unsupported arithmetic operation");
+            overflow = __builtin_mul_overflow(left, right, &result);
+        }
+
+        if (unlikely(overflow)) {
+            // the primitive knows how to create a big integer
+            doSend(bytecodeIndex);
+            return;
+        }
+        val = NEW_INT(result);
+    } else if (IS_DOUBLE(rcvr) && (IS_DOUBLE(arg) || IS_SMALL_INT(arg))) {
+        double const left = AS_DOUBLE(rcvr);
+        double const right =
+            IS_DOUBLE(arg) ? AS_DOUBLE(arg) : (double)SMALL_INT_VAL(arg);
+        double result = 0.0;
+
+        if constexpr (op == ADD) {
+            result = left + right;
+        } else if constexpr (op == SUB) {
+            result = left - right;
+        } else {
+            result = left * right;
+        }
+        val = NEW_DOUBLE(result);
+    } else {
+        doSend(bytecodeIndex);
+        return;
+    }
+
+    GetFrame()->PopVoid();
+    GetFrame()->SetTop(store_root(val));
+}
+
+template <Interpreter::ComparisonOp op>
+void Interpreter::doComparison(size_t bytecodeIndex) {
+    vm_oop_t arg = GetFrame()->Top();
+    vm_oop_t rcvr = GetFrame()->Top2();
+    bool result = false;
+
+    auto compare = [](auto left, auto right) {
+        if constexpr (op == LT) {
+            return left < right;
+        } else if constexpr (op == GT) {
+            return left > right;
+        } else if constexpr (op == LE) {
+            return left <= right;
+        } else if constexpr (op == GE) {
+            return left >= right;
+        } else {
+            static_assert(op == EQ, "unsupported comparison");
+            return left == right;
+        }
+    };
+
+    if (likely(IS_SMALL_INT(rcvr) && IS_SMALL_INT(arg))) {
+        result = compare(SMALL_INT_VAL(rcvr), SMALL_INT_VAL(arg));
+    } else if (IS_DOUBLE(rcvr) && (IS_DOUBLE(arg) || IS_SMALL_INT(arg))) {
+        double const right =
+            IS_DOUBLE(arg) ? AS_DOUBLE(arg) : (double)SMALL_INT_VAL(arg);
+        result = compare(AS_DOUBLE(rcvr), right);
+    } else {
+        doSend(bytecodeIndex);
+        return;
+    }
+
+    GetFrame()->PopVoid();
+    GetFrame()->SetTop(result ? trueObject : falseObject);
+}
+
+void Interpreter::doDoubleDivision(size_t bytecodeIndex) {
+    vm_oop_t arg = GetFrame()->Top();
+    vm_oop_t rcvr = GetFrame()->Top2();
+
+    double right = 0.0;
+    if (likely(IS_DOUBLE(arg))) {
+        right = AS_DOUBLE(arg);
+    } else if (IS_SMALL_INT(arg)) {
+        right = (double)SMALL_INT_VAL(arg);
+    } else {
+        deoptimizeQuickenedSend(bytecodeIndex);
+        return;
+    }
+
+    if (unlikely(!IS_DOUBLE(rcvr))) {
+        deoptimizeQuickenedSend(bytecodeIndex);
+        return;
+    }
+
+    vm_oop_t val = NEW_DOUBLE(AS_DOUBLE(rcvr) / right);
+    GetFrame()->PopVoid();
+    GetFrame()->SetTop(store_root(val));
+}
+
+void Interpreter::doArrayAt(size_t bytecodeIndex) {
+    vm_oop_t idx = GetFrame()->Top();
+    vm_oop_t rcvr = GetFrame()->Top2();
+
+    if (unlikely(!IS_SMALL_INT(idx) ||
+                 CLASS_OF(rcvr) != load_ptr(arrayClass))) {
+        deoptimizeQuickenedSend(bytecodeIndex);
+        return;
+    }
+
+    auto* array = static_cast<VMArray*>(rcvr);
+    vm_oop_t result = array->GetIndexableField(SMALL_INT_VAL(idx) - 1);
+    GetFrame()->PopVoid();
+    GetFrame()->SetTop(store_root(result));
+}
+
+void Interpreter::doArrayAtPut(size_t bytecodeIndex) {
+    vm_oop_t value = GetFrame()->Top();
+    vm_oop_t idx = GetFrame()->Top2();
+    vm_oop_t rcvr = GetFrame()->GetStackElement(2);
+
+    if (unlikely(!IS_SMALL_INT(idx) ||
+                 CLASS_OF(rcvr) != load_ptr(arrayClass))) {
+        deoptimizeQuickenedSend(bytecodeIndex);
+        return;
+    }
+
+    auto* array = static_cast<VMArray*>(rcvr);
+    array->SetIndexableField(SMALL_INT_VAL(idx) - 1, value);
+
+    // #at:put: returns the receiver, which is already on the stack
+    GetFrame()->PopVoid();
+    GetFrame()->PopVoid();
+}
+
+void Interpreter::doInstVarNamed(size_t bytecodeIndex) {
+    vm_oop_t name = GetFrame()->Top();
+    vm_oop_t rcvr = GetFrame()->Top2();
+
+    if (unlikely(IS_TAGGED(rcvr))) {
+        deoptimizeQuickenedSend(bytecodeIndex);
+        return;
+    }
+
+    VMClass* cls = CLASS_OF(rcvr);
+    InlineCache* cache = method->GetInlineCache(bytecodeIndex);
+    int64_t idx = cache->LookupFieldIndex(cls, (VMSymbol*)name);
+
+    if (unlikely(idx < 0)) {
+        // a class that is new to the site needs to inherit the primitive,
+        // and the field needs to exist, otherwise the send reports the error
+        VMInvokable* invokable = lookupWithInlineCache(
+            static_cast<VMSymbol*>(method->GetConstant(bytecodeIndex)), cls,
+            bytecodeIndex);
+        if (CLASS_OF(name) != load_ptr(symbolClass) || invokable == nullptr ||
+            !invokable->IsPrimitive() ||
+            invokable->GetHolder() != load_ptr(objectClass)) {
+            deoptimizeQuickenedSend(bytecodeIndex);
+            return;
+        }
+
+        idx = cls->LookupFieldIndex((VMSymbol*)name);
+        if (idx < 0) {
+            deoptimizeQuickenedSend(bytecodeIndex);
+            return;
+        }
+        cache->UpdateFieldIndex(method, cls, (VMSymbol*)name, idx);
+    }
+
+    vm_oop_t result = static_cast<VMObject*>(rcvr)->GetField(idx);
+    GetFrame()->PopVoid();
+    GetFrame()->SetTop(store_root(result));
+}
+
+void Interpreter::doIdentityEquals(size_t bytecodeIndex) {
+    vm_oop_t arg = GetFrame()->Top();
+    vm_oop_t rcvr = GetFrame()->Top2();
+
+    // Integer>>#== compares values. Any other class may override #==, so
+    // its receivers get a real send.
+    if (unlikely(!IS_SMALL_INT(rcvr))) {
+        doSend(bytecodeIndex);
+        return;
+    }
+
+    bool const result =
+        IS_SMALL_INT(arg) && SMALL_INT_VAL(rcvr) == SMALL_INT_VAL(arg);
+    GetFrame()->PopVoid();
+    GetFrame()->SetTop(result ? trueObject : falseObject);
+}
+
 void Interpreter::triggerDoesNotUnderstand(VMSymbol* signature) {
     uint8_t const numberOfArgs = Signature::GetNumberOfArguments(signature);
 
@@ -867,6 +1502,13 @@ void Interpreter::doPushBlock(size_t bytecodeIndex) {
 
     uint8_t const numOfArgs = blockMethod->GetNumberOfArguments();
 
+    // the block may outlive the frame, which therefore needs to move to the
+    // heap before the block refers to it
+    if (GetFrame()->IsOnStack()) {
+        GetFrame()->SetBytecodeIndex(bytecodeIndexGlobal);
+        SetFrame(FrameStack::Promote(GetFrame()));
+    }
+
     GetFrame()->Push(Universe::NewBlock(blockMethod, GetFrame(), numOfArgs));
 }
 
@@ -962,7 +1604,7 @@ void Interpreter::doSend(size_t bytecodeIndex) {
     Universe::receiverTypes[receiverClass->GetName()->GetStdString()]++;
 #endif
 
-    send(signature, receiverClass);
+    send(signature, receiverClass, bytecodeIndex);
 }
 
 void Interpreter::doUnarySend(size_t bytecodeIndex) {
@@ -985,7 +1627,8 @@ void Interpreter::doUnarySend(size_t bytecodeIndex) {
     Universe::receiverTypes[receiverClass->GetName()->GetStdString()]++;
 #endif
 
-    VMInvokable* invokable = receiverClass->LookupInvokable(signature);
+    VMInvokable* invokable =
+        lookupWithInlineCache(signature, receiverClass, bytecodeIndex);
 
     if (invokable != nullptr) {
 #ifdef LOG_RECEIVER_TYPES
@@ -998,7 +1641,9 @@ void Interpreter::doUnarySend(size_t bytecodeIndex) {
             Universe::callStats[name].noPrimitiveCalls++;
         }
 #endif
+        enterSendSite(invokable, bytecodeIndex);
         invokable->Invoke1(GetFrame());
+        leaveSendSite();
     } else {
         triggerDoesNotUnderstand(signature);
     }
@@ -1013,10 +1658,12 @@ void Interpreter::doSuperSend(size_t bytecodeIndex) {
     VMClass* holder = realMethod->GetHolder();
     assert(holder->HasSuperClass());
     auto* super = (VMClass*)holder->GetSuperClass();
-    auto* invokable = super->LookupInvokable(signature);
+    auto* invokable = lookupWithInlineCache(signature, super, bytecodeIndex);
 
     if (invokable != nullptr) {
+        enterSendSite(invokable, bytecodeIndex);
         invokable->Invoke(GetFrame());
+        leaveSendSite();
     } else {
         uint8_t const numOfArgs = Signature::GetNumberOfArguments(signature);
         vm_oop_t receiver = GetFrame()->GetStackElement(numOfArgs - 1);
@@ -1050,22 +1697,27 @@ void Interpreter::doReturnNonLocal() {
         vm_oop_t sender = outerContext->GetArgumentInCurrentContext(0);
         vm_oop_t arguments[] = {block};
 
+        // the arguments of the block, including the block itself, are still
+        // on the stack of the sender of #value
+        uint8_t const numberOfArgs =
+            GetFrame()->GetMethod()->GetNumberOfArguments();
+
         popFrame();
 
-        // Pop old arguments from stack
-        VMMethod* method = GetFrame()->GetMethod();
-        uint8_t const numberOfArgs = method->GetNumberOfArguments();
         for (uint8_t i = 0; i < numberOfArgs; ++i) {
-            GetFrame()->Pop();
+            GetFrame()->PopVoid();
         }
 
-        // check if current frame is big enough for this unplanned send
-        // #escapedBlock: needs 2 slots, one for self, and one for the block
+        // #escapedBlock: needs 2 slots, one for self, and one for the block.
+        // The block was the receiver of the send that activated it, and the
+        // compiler reserves a slot after each unary send for this case.
+        // Blocks activated otherwise, e.g., by primitives, may lack the room.
         int64_t const additionalStackSlots =
             2 - (int64_t)GetFrame()->RemainingStackSize();
-        if (additionalStackSlots > 0) {
+        if (unlikely(additionalStackSlots > 0)) {
             GetFrame()->SetBytecodeIndex(bytecodeIndexGlobal);
-            // copy current frame into a bigger one, and replace it
+            // copy current frame into a bigger one and replace the current
+            // frame
             SetFrame(
                 VMFrame::EmergencyFrameFrom(GetFrame(), additionalStackSlots));
         }
@@ -1074,11 +1726,38 @@ void Interpreter::doReturnNonLocal() {
         return;
     }
 
-    while (GetFrame() != context) {
-        popFrame();
+    // the home context is still active, and thus, on the chain of previous
+    // frames. Cut the chain below it in one go, instead of activating each
+    // frame in between, and clear the previous frames so that blocks that
+    // captured any of them see that they returned.
+    VMFrame* const senderOfContext = context->GetPreviousFrame();
+    VMFrame* lowestOnStack = nullptr;
+
+    VMFrame* current = GetFrame();
+    while (current != senderOfContext) {
+        VMFrame* const prev = current->GetPreviousFrame();
+        current->ClearPreviousFrame();
+        if (current->IsOnStack()) {
+            lowestOnStack = current;
+        }
+        current = prev;
     }
 
-    popFrameAndPushResult(result);
+    // frames on the stack are in the order of their activation, so all frames
+    // above the lowest one are dead, too
+    if (lowestOnStack != nullptr) {
+        FrameStack::Release(lowestOnStack);
+    }
+
+    // the frames are dead, there is no need to save the bytecode index
+    frame = nullptr;
+    SetFrame(senderOfContext);
+
+    uint8_t const numberOfArgs = context->GetMethod()->GetNumberOfArguments();
+    for (uint8_t i = 0; i < numberOfArgs; ++i) {
+        GetFrame()->PopVoid();
+    }
+    GetFrame()->Push(result);
 }
 
 void Interpreter::doInc() {
@@ -1088,8 +1767,8 @@ void Interpreter::doInc() {
         int64_t const result = SMALL_INT_VAL(val) + 1;
         val = NEW_INT(result);
     } else if (CLASS_OF(val) == load_ptr(doubleClass)) {
-        double const d = static_cast<VMDouble*>(val)->GetEmbeddedDouble();
-        val = Universe::NewDouble(d + 1.0);
+        double const d = AS_DOUBLE(val);
+        val = NEW_DOUBLE(d + 1.0);
     } else {
         ErrorExit("unsupported");
     }
@@ -1104,8 +1783,8 @@ void Interpreter::doDec() {
         int64_t const result = SMALL_INT_VAL(val) - 1;
         val = NEW_INT(result);
     } else if (CLASS_OF(val) == load_ptr(doubleClass)) {
-        double const d = static_cast<VMDouble*>(val)->GetEmbeddedDouble();
-        val = Universe::NewDouble(d - 1.0);
+        double const d = AS_DOUBLE(val);
+        val = NEW_DOUBLE(d - 1.0);
     } else {
         ErrorExit("unsupported");
     }
@@ -1128,8 +1807,8 @@ void Interpreter::doIncField(uint8_t fieldIndex) {
         int64_t const result = SMALL_INT_VAL(val) + 1;
         val = NEW_INT(result);
     } else if (CLASS_OF(val) == load_ptr(doubleClass)) {
-        double const d = static_cast<VMDouble*>(val)->GetEmbeddedDouble();
-        val = Universe::NewDouble(d + 1.0);
+        double const d = AS_DOUBLE(val);
+        val = NEW_DOUBLE(d + 1.0);
     } else {
         ErrorExit("unsupported");
     }
@@ -1152,8 +1831,8 @@ void Interpreter::doIncFieldPush(uint8_t fieldIndex) {
         int64_t const result = SMALL_INT_VAL(val) + 1;
         val = NEW_INT(result);
     } else if (CLASS_OF(val) == load_ptr(doubleClass)) {
-        double const d = static_cast<VMDouble*>(val)->GetEmbeddedDouble();
-        val = Universe::NewDouble(d + 1.0);
+        double const d = AS_DOUBLE(val);
+        val = NEW_DOUBLE(d + 1.0);
     } else {
         ErrorExit("unsupported");
     }
@@ -1179,10 +1858,12 @@ bool Interpreter::checkIsGreater() {
 void Interpreter::WalkGlobals(walk_heap_fn walk) {
     method = load_ptr(static_cast<GCMethod*>(walk(tmp_ptr(method))));
 
-    // Get the current frame and mark it.
-    // Since marking is done recursively, this automatically
-    // marks the whole stack
-    frame = load_ptr(static_cast<GCFrame*>(walk(tmp_ptr(frame))));
+    // Frames on the frame stack are roots, and don't move. Marking the current
+    // frame recursively marks all heap frames of the call chain.
+    FrameStack::WalkFrames(walk);
+    if (!frame->IsOnStack()) {
+        frame = load_ptr(static_cast<GCFrame*>(walk(tmp_ptr(frame))));
+    }
 }
 
 void Interpreter::startGC() {
@@ -47,6 +47,9 @@
     }
 
 class Interpreter {
+    friend class JIT;
+    friend class RegisterInterpreter;
+
 public:
     template <bool PrintBytecodes>
     static vm_oop_t Start();
@@ -64,6 +67,14 @@ public:
 
     static inline size_t GetBytecodeIndex() { return bytecodeIndexGlobal; }
 
+#if GC_TYPE == GENERATIONAL
+    /// The allocation site of the send that directly invoked the currently
+    /// executed primitive, or nullptr if it was invoked otherwise.
+    static inline AllocationSite* GetAllocationSite() {
+        return sendSite == nullptr ? nullptr : sendSite->GetAllocationSite();
+    }
+#endif
+
     static void ResetBytecodeIndex(VMFrame* forFrame) {
         assert(frame == forFrame);
         assert(forFrame != nullptr);
@@ -81,6 +92,13 @@ private:
     static size_t bytecodeIndexGlobal;
     static uint8_t* currentBytecodes;
 
+#if GC_TYPE == GENERATIONAL
+    // the inline cache of the send that invoked the currently executed safe
+    // primitive. Other invokables may reach allocating primitives only
+    // indirectly, e.g., via #perform:, and do not charge the send
+    static InlineCache* sendSite;
+#endif
+
     static const std::string unknownGlobal;
     static const std::string doesNotUnderstand;
     static const std::string escapedBlock;
@@ -91,10 +109,25 @@ private:
     static VMFrame* popFrame();
     static void popFrameAndPushResult(vm_oop_t result);
 
-    static void send(VMSymbol* signature, VMClass* receiverClass);
+    static void send(VMSymbol* signature, VMClass* receiverClass,
+                     size_t bytecodeIndex);
+    static VMInvokable* lookupWithInlineCache(VMSymbol* signature,
+                                              VMClass* receiverClass,
+                                              size_t bytecodeIndex);
+
+    /// Makes the send at the bytecode index the allocation site of its
+    /// target, if that is a safe primitive, until leaveSendSite().
+    static inline void enterSendSite(VMInvokable* invokable,
+                                     size_t bytecodeIndex);
+    static inline void leaveSendSite();
 
     static void triggerDoesNotUnderstand(VMSymbol* signature);
 
+    static void tryQuickening(size_t bytecodeIndex, VMSymbol* signature,
+                              VMInvokable* invokable);
+    static uint8_t quickenedBytecodeFor(VMSymbol* signature);
+    static void deoptimizeQuickenedSend(size_t bytecodeIndex);
+
     static void doDup();
     static void doPushLocal(size_t bytecodeIndex);
     static void doPushLocalWithIndex(uint8_t localIndex);
@@ -126,4 +159,21 @@ private:
     static void doIncField(uint8_t fieldIndex);
     static void doIncFieldPush(uint8_t fieldIndex);
     static bool checkIsGreater();
+
+    enum ArithmeticOp : uint8_t { ADD, SUB, MUL };
+    enum ComparisonOp : uint8_t { LT, GT, LE, GE, EQ };
+
+    template <ArithmeticOp op>
+    static void doArithmetic(size_t bytecodeIndex);
+    template <ComparisonOp op>
+    static void doComparison(size_t bytecodeIndex);
+    static void doDoubleDivision(size_t bytecodeIndex);
+    static void doArrayAt(size_t bytecodeIndex);
+    static void doArrayAtPut(size_t bytecodeIndex);
+    static void doInstVarNamed(size_t bytecodeIndex);
+    static void doIdentityEquals(size_t bytecodeIndex);
+
+    /// Executes one of the bytecodes that a superinstruction starts with.
+    template <uint8_t BC>
+    static void doSuperinstructionPart(size_t bytecodeIndex);
 };
@@ -0,0 +1,809 @@
+#ifdef USE_JIT
+
+  #include "JIT.h"
+
+  #include <sys/mman.h>
+  #include <unistd.h>
+
+  #include <array>
+  #include <cassert>
+  #include <cstddef>
+  #include <cstdint>
+  #include <cstring>
+  #include <utility>
+  #include <vector>
+
+  #include "../memory/Heap.h"
+  #include "../misc/defs.h"
+  #include "../vm/Globals.h"
+  #include "../vm/Print.h"
+  #include "../vm/Universe.h"
+  #include "../vmobjects/IntegerBox.h"    // NOLINT(misc-include-cleaner)
+  #include "../vmobjects/VMBigInteger.h"  // NOLINT(misc-include-cleaner)
+  #include "../vmobjects/ObjectFormats.h"
+  #include "../vmobjects/VMFrame.h"
+  #include "../vmobjects/VMMethod.h"
+  #include "Interpreter.h"
+  #include "bytecodes.h"
+
+bool JIT::bailedOut = false;
+
+CompiledCode::~CompiledCode() {
+    munmap(code, codeSize);
+}
+
+static constexpr bool isJump(uint8_t bc) {
+    return bc >= BC_JUMP && bc <= BC_JUMP2_BACKWARD;
+}
+
+static constexpr bool isUnconditionalJump(uint8_t bc) {
+    return bc == BC_JUMP || bc == BC_JUMP2 || bc == BC_JUMP_BACKWARD ||
+           bc == BC_JUMP2_BACKWARD;
+}
+
+/// Bytecodes at which the interpreter checks whether a collection is needed.
+static constexpr bool mayCollect(uint8_t bc) {
+    return bc == BC_PUSH_BLOCK || bc == BC_PUSH_GLOBAL || bc == BC_SEND ||
+           bc == BC_SEND_1 || bc == BC_SUPER_SEND ||
+           (bc == BC_INC && !USE_TAGGING) ||
+           (bc >= BC_ADD && bc <= BC_INST_VAR_NAMED);
+}
+
+/// Bytecodes that can send a message and thereby change the frame. The
+/// binary operations and quickened bytecodes fall back to a send, and #unknownGlobal: is sent when a
+/// global is not defined.
+static constexpr bool maySend(uint8_t bc) {
+    return bc == BC_PUSH_GLOBAL || bc == BC_SEND || bc == BC_SEND_1 ||
+           bc == BC_SUPER_SEND || (bc >= BC_ADD && bc <= BC_INST_VAR_NAMED);
+}
+
+static constexpr bool isReturn(uint8_t bc) {
+    return bc >= BC_RETURN_LOCAL && bc <= BC_RETURN_FIELD_2;
+}
+
+/// Bytecodes that are compiled inline for two small integers.
+static constexpr bool isSmallIntegerOperation(uint8_t bc) {
+    return bc == BC_ADD || bc == BC_SUB || (bc >= BC_LT && bc <= BC_EQ);
+}
+
+uint8_t JIT::afterSend(VMFrame* frameBefore, size_t nextBytecodeIndex) {
+    // a primitive like Block>>#restart may have moved the bytecode index
+    bool const exit = Interpreter::GetFrame() != frameBefore ||
+                      Interpreter::bytecodeIndexGlobal != nextBytecodeIndex;
+
+    if (GetHeap<HEAP_CLS>()->isCollectionTriggered()) {
+        Interpreter::startGC();
+    }
+    return exit ? EXIT : CONTINUE;
+}
+
+template <uint8_t BC>
+uint8_t JIT::handle(size_t bytecodeIndex) {
+    VMFrame* frame = Interpreter::GetFrame();
+    size_t const next = bytecodeIndex + Bytecode::GetBytecodeLength(BC);
+    Interpreter::bytecodeIndexGlobal = next;
+
+    if constexpr (BC == BC_DUP) {
+        Interpreter::doDup();
+    } else if constexpr (BC == BC_DUP_SECOND) {
+        vm_oop_t elem = frame->GetStackElement(1);
+        frame->Push(elem);
+    } else if constexpr (BC == BC_PUSH_LOCAL) {
+        Interpreter::doPushLocal(bytecodeIndex);
+    } else if constexpr (BC >= BC_PUSH_LOCAL_0 && BC <= BC_PUSH_LOCAL_2) {
+        Interpreter::doPushLocalWithIndex(BC - BC_PUSH_LOCAL_0);
+    } else if constexpr (BC == BC_PUSH_ARGUMENT) {
+        Interpreter::doPushArgument(bytecodeIndex);
+    } else if constexpr (BC >= BC_PUSH_SELF && BC <= BC_PUSH_ARG_2) {
+        vm_oop_t argument =
+            frame->GetArgumentInCurrentContext(BC - BC_PUSH_SELF);
+        frame->Push(argument);
+    } else if constexpr (BC == BC_PUSH_FIELD) {
+        Interpreter::doPushField(bytecodeIndex);
+    } else if constexpr (BC == BC_PUSH_FIELD_0 || BC == BC_PUSH_FIELD_1) {
+        Interpreter::doPushFieldWithIndex(BC - BC_PUSH_FIELD_0);
+    } else if constexpr (BC == BC_PUSH_BLOCK) {
+        Interpreter::doPushBlock(bytecodeIndex);
+    } else if constexpr (BC == BC_PUSH_CONSTANT) {
+        Interpreter::doPushConstant(bytecodeIndex);
+    } else if constexpr (BC >= BC_PUSH_CONSTANT_0 && BC <= BC_PUSH_CONSTANT_2) {
+        vm_oop_t constant =
+            Interpreter::method->GetIndexableField(BC - BC_PUSH_CONSTANT_0);
+        frame->Push(constant);
+    } else if constexpr (BC == BC_PUSH_0 || BC == BC_PUSH_1) {
+        frame->Push(NEW_INT(BC - BC_PUSH_0));
+    } else if constexpr (BC == BC_PUSH_NIL) {
+        frame->Push(load_ptr(nilObject));
+    } else if constexpr (BC == BC_PUSH_GLOBAL) {
+        Interpreter::doPushGlobal(bytecodeIndex);
+    } else if constexpr (BC == BC_POP) {
+        Interpreter::doPop();
+    } else if constexpr (BC == BC_POP_LOCAL) {
+        Interpreter::doPopLocal(bytecodeIndex);
+    } else if constexpr (BC >= BC_POP_LOCAL_0 && BC <= BC_POP_LOCAL_2) {
+        Interpreter::doPopLocalWithIndex(BC - BC_POP_LOCAL_0);
+    } else if constexpr (BC == BC_POP_ARGUMENT) {
+        Interpreter::doPopArgument(bytecodeIndex);
+    } else if constexpr (BC == BC_POP_FIELD) {
+        Interpreter::doPopField(bytecodeIndex);
+    } else if constexpr (BC == BC_POP_FIELD_0 || BC == BC_POP_FIELD_1) {
+        Interpreter::doPopFieldWithIndex(BC - BC_POP_FIELD_0);
+    } else if constexpr (BC == BC_SEND) {
+        Interpreter::doSend(bytecodeIndex);
+    } else if constexpr (BC == BC_SEND_1) {
+        Interpreter::doUnarySend(bytecodeIndex);
+    } else if constexpr (BC == BC_SUPER_SEND) {
+        Interpreter::doSuperSend(bytecodeIndex);
+    } else if constexpr (BC == BC_RETURN_LOCAL) {
+        Interpreter::doReturnLocal();
+    } else if constexpr (BC == BC_RETURN_NON_LOCAL) {
+        Interpreter::doReturnNonLocal();
+    } else if constexpr (BC == BC_RETURN_SELF) {
+        assert(frame->GetContext() == nullptr &&
+               "RETURN_SELF is not allowed in blocks");
+        Interpreter::popFrameAndPushResult(
+            frame->GetArgumentInCurrentContext(0));
+    } else if constexpr (BC >= BC_RETURN_FIELD_0 && BC <= BC_RETURN_FIELD_2) {
+        Interpreter::doReturnFieldWithIndex(BC - BC_RETURN_FIELD_0);
+    } else if constexpr (BC == BC_INC) {
+        Interpreter::doInc();
+    } else if constexpr (BC == BC_DEC) {
+        Interpreter::doDec();
+    } else if constexpr (BC == BC_INC_FIELD) {
+        Interpreter::doIncField(Interpreter::currentBytecodes[bytecodeIndex + 1]);
+    } else if constexpr (BC == BC_INC_FIELD_PUSH) {
+        Interpreter::doIncFieldPush(
+            Interpreter::currentBytecodes[bytecodeIndex + 1]);
+    } else if constexpr (BC == BC_ADD) {
+        Interpreter::doArithmetic<Interpreter::ADD>(bytecodeIndex);
+    } else if constexpr (BC == BC_SUB) {
+        Interpreter::doArithmetic<Interpreter::SUB>(bytecodeIndex);
+    } else if constexpr (BC == BC_MUL) {
+        Interpreter::doArithmetic<Interpreter::MUL>(bytecodeIndex);
+    } else if constexpr (BC == BC_LT) {
+        Interpreter::doComparison<Interpreter::LT>(bytecodeIndex);
+    } else if constexpr (BC == BC_GT) {
+        Interpreter::doComparison<Interpreter::GT>(bytecodeIndex);
+    } else if constexpr (BC == BC_LE) {
+        Interpreter::doComparison<Interpreter::LE>(bytecodeIndex);
+    } else if constexpr (BC == BC_GE) {
+        Interpreter::doComparison<Interpreter::GE>(bytecodeIndex);
+    } else if constexpr (BC == BC_EQ) {
+        Interpreter::doComparison<Interpreter::EQ>(bytecodeIndex);
+    } else if constexpr (BC == BC_EQ_EQ) {
+        Interpreter::doIdentityEquals(bytecodeIndex);
+    } else if constexpr (BC == BC_DIV_DOUBLE) {
+        Interpreter::doDoubleDivision(bytecodeIndex);
+    } else if constexpr (BC == BC_AT_ARRAY) {
+        Interpreter::doArrayAt(bytecodeIndex);
+    } else if constexpr (BC == BC_AT_PUT_ARRAY) {
+        Interpreter::doArrayAtPut(bytecodeIndex);
+    } else {
+        static_assert(BC == BC_INST_VAR_NAMED, "bytecode without handler");
+        Interpreter::doInstVarNamed(bytecodeIndex);
+    }
+
+    if constexpr (maySend(BC)) {
+        return afterSend(frame, next);
+    } else if constexpr (isReturn(BC)) {
+        return EXIT;
+    } else {
+        if constexpr (mayCollect(BC)) {
+            if (GetHeap<HEAP_CLS>()->isCollectionTriggered()) {
+                Interpreter::startGC();
+            }
+        }
+        return CONTINUE;
+    }
+}
+
+template <uint8_t BC>
+uint8_t JIT::handleJump(size_t bytecodeIndex) {
+    // the double-byte jumps behave like their single-byte counterparts
+    constexpr uint8_t kind = BC < FIRST_DOUBLE_BYTE_JUMP_BYTECODE
+                                 ? BC
+                                 : BC - NUM_SINGLE_BYTE_JUMP_BYTECODES;
+
+    VMFrame* frame = Interpreter::GetFrame();
+    vm_oop_t val = frame->Top();
+    bool taken = false;
+
+    if constexpr (kind == BC_JUMP_IF_GREATER) {
+        taken = Interpreter::checkIsGreater();
+        if (taken) {
+            frame->Pop();
+            frame->Pop();
+        }
+    } else {
+        if constexpr (kind == BC_JUMP_ON_FALSE_POP ||
+                      kind == BC_JUMP_ON_FALSE_TOP_NIL) {
+            taken = val == load_ptr(falseObject);
+        } else if constexpr (kind == BC_JUMP_ON_TRUE_POP ||
+                             kind == BC_JUMP_ON_TRUE_TOP_NIL) {
+            taken = val == load_ptr(trueObject);
+        } else if constexpr (kind == BC_JUMP_ON_NOT_NIL_POP ||
+                             kind == BC_JUMP_ON_NOT_NIL_TOP_TOP) {
+            taken = val != load_ptr(nilObject);
+        } else {
+            static_assert(
+                kind == BC_JUMP_ON_NIL_POP || kind == BC_JUMP_ON_NIL_TOP_TOP,
+                "unsupported conditional jump");
+            taken = val == load_ptr(nilObject);
+        }
+
+        if constexpr (kind == BC_JUMP_ON_FALSE_TOP_NIL ||
+                      kind == BC_JUMP_ON_TRUE_TOP_NIL) {
+            if (taken) {
+                frame->SetTop(nilObject);
+            } else {
+                frame->PopVoid();
+            }
+        } else if constexpr (kind == BC_JUMP_ON_NOT_NIL_TOP_TOP ||
+                             kind == BC_JUMP_ON_NIL_TOP_TOP) {
+            if (!taken) {
+                frame->PopVoid();
+            }
+        } else {
+            frame->PopVoid();
+        }
+    }
+
+    if (taken) {
+        Interpreter::bytecodeIndexGlobal =
+            GetJumpTarget(Interpreter::currentBytecodes, bytecodeIndex);
+        return BRANCH;
+    }
+    Interpreter::bytecodeIndexGlobal = bytecodeIndex + 3;
+    return CONTINUE;
+}
+
+uint8_t JIT::handleSendSite(size_t bytecodeIndex) {
+    // sends are quickened and deoptimized while the code runs, so the
+    // bytecode is only known at run time
+    return handlers[Interpreter::currentBytecodes[bytecodeIndex]](
+        bytecodeIndex);
+}
+
+uint8_t JIT::bailOut(size_t bytecodeIndex) {
+    bailedOut = true;
+    Interpreter::bytecodeIndexGlobal = bytecodeIndex;
+    return EXIT;
+}
+
+template <uint8_t BC>
+constexpr JIT::Handler JIT::handlerFor() {
+    if constexpr (BC == BC_HALT) {
+        return &bailOut;
+    } else if constexpr (IsSuperinstruction(BC)) {
+        return handlerFor<Bytecode::GetBaseBytecode(BC)>();
+    } else if constexpr (isUnconditionalJump(BC)) {
+        // compiled to a native jump
+        return &bailOut;
+    } else if constexpr (isJump(BC)) {
+        return &handleJump<BC>;
+    } else {
+        return &handle<BC>;
+    }
+}
+
+template <size_t... BCs>
+constexpr std::array<JIT::Handler, sizeof...(BCs)> JIT::createHandlers(
+    std::index_sequence<BCs...> /*unused*/) {
+    return {handlerFor<BCs>()...};
+}
+
+const std::array<JIT::Handler, _LAST_BYTECODE + 1> JIT::handlers =
+    createHandlers(std::make_index_sequence<_LAST_BYTECODE + 1>());
+
+/// A minimal x86-64 assembler with support for forward references to
+/// bytecode indices. It only knows the handful of instructions the templates
+/// below need, and only uses the scratch registers rax, rcx, and rdx.
+class Assembler {
+public:
+    enum Reg : uint8_t { RAX = 0, RCX = 1, RDX = 2, RBX = 3 };
+
+    void Emit8(uint8_t b) { code.push_back(b); }
+
+    void Emit32(uint32_t v) {
+        for (size_t i = 0; i < 4; i += 1) {
+            Emit8((uint8_t)(v >> (i * 8)));
+        }
+    }
+
+    void Emit64(uint64_t v) {
+        for (size_t i = 0; i < 8; i += 1) {
+            Emit8((uint8_t)(v >> (i * 8)));
+        }
+    }
+
+    /// mov dst, imm64
+    void MovImm(Reg dst, uint64_t imm) {
+        Emit8(0x48);
+        Emit8(0xB8 + dst);
+        Emit64(imm);
+    }
+
+    /// mov dst, [base + disp32]
+    void Load(Reg dst, Reg base, int32_t disp) {
+        Emit8(0x48);
+        Emit8(0x8B);
+        Emit8(0x80 | (dst << 3U) | base);
+        Emit32((uint32_t)disp);
+    }
+
+    /// mov [base + disp32], src
+    void Store(Reg base, int32_t disp, Reg src) {
+        Emit8(0x48);
+        Emit8(0x89);
+        Emit8(0x80 | (src << 3U) | base);
+        Emit32((uint32_t)disp);
+    }
+
+    /// add/sub reg, imm8
+    void AddImm(Reg reg, int8_t imm) {
+        Emit8(0x48);
+        Emit8(0x83);
+        Emit8(0xC0 | reg);
+        Emit8((uint8_t)imm);
+    }
+
+    /// add dst, src
+    void Add(Reg dst, Reg src) {
+        Emit8(0x48);
+        Emit8(0x01);
+        Emit8(0xC0 | (src << 3U) | dst);
+    }
+
+    /// sub dst, src
+    void Sub(Reg dst, Reg src) {
+        Emit8(0x48);
+        Emit8(0x29);
+        Emit8(0xC0 | (src << 3U) | dst);
+    }
+
+    /// cmp left, right
+    void Cmp(Reg left, Reg right) {
+        Emit8(0x48);
+        Emit8(0x39);
+        Emit8(0xC0 | (right << 3U) | left);
+    }
+
+    /// test the lowest bit of reg, i.e., whether it is a tagged integer
+    void TestTag(Reg reg) {
+        Emit8(0xF6);
+        Emit8(0xC0 | reg);
+        Emit8(1);
+    }
+
+    /// cmp rcx, [rdx]
+    void CmpRcxWithRdxRef() {
+        Emit8(0x48);
+        Emit8(0x3B);
+        Emit8(0x0A);
+    }
+
+    /// call the handler with the bytecode index as argument
+    void CallHandler(uint32_t bytecodeIndex, void* handler) {
+        Emit8(0xBF);  // mov edi, imm32
+        Emit32(bytecodeIndex);
+        MovImm(RAX, (uint64_t)handler);
+        Emit8(0xFF);  // call rax
+        Emit8(0xD0);
+    }
+
+    void JmpToBytecode(size_t bytecodeIndex) {
+        Emit8(0xE9);
+        emitRel32ToBytecode(bytecodeIndex);
+    }
+
+    /// je/jne rel32, the condition code is 0x84 for je, and 0x85 for jne
+    void JccToBytecode(uint8_t condition, size_t bytecodeIndex) {
+        Emit8(0x0F);
+        Emit8(condition);
+        emitRel32ToBytecode(bytecodeIndex);
+    }
+
+    void JccTo(uint8_t condition, size_t target) {
+        Emit8(0x0F);
+        Emit8(condition);
+        size_t const pos = code.size();
+        Emit32((uint32_t)(target - (pos + 4)));
+    }
+
+    /// jcc rel32 to a label that is bound later, returns the label
+    size_t JccForward(uint8_t condition) {
+        Emit8(0x0F);
+        Emit8(condition);
+        size_t const pos = code.size();
+        Emit32(0);
+        return pos;
+    }
+
+    /// jmp rel32 to a label that is bound later, returns the label
+    size_t JmpForward() {
+        Emit8(0xE9);
+        size_t const pos = code.size();
+        Emit32(0);
+        return pos;
+    }
+
+    /// lets the jump to the label continue at the current position
+    void Bind(size_t label) {
+        auto const rel = (uint32_t)(code.size() - (label + 4));
+        memcpy(&code[label], &rel, sizeof(rel));
+    }
+
+    void PatchBytecodeReferences(const std::vector<size_t>& offsets) {
+        for (auto [pos, bytecodeIndex] : fixups) {
+            assert(offsets[bytecodeIndex] != SIZE_MAX);
+            auto const rel = (uint32_t)(offsets[bytecodeIndex] - (pos + 4));
+            memcpy(&code[pos], &rel, sizeof(rel));
+        }
+    }
+
+    [[nodiscard]] size_t Position() const { return code.size(); }
+    [[nodiscard]] const uint8_t* Data() const { return code.data(); }
+
+private:
+    void emitRel32ToBytecode(size_t bytecodeIndex) {
+        fixups.emplace_back(code.size(), bytecodeIndex);
+        Emit32(0);
+    }
+
+    std::vector<uint8_t> code;
+    std::vector<std::pair<size_t, size_t>> fixups;
+};
+
+static const uint8_t JO = 0x80;
+static const uint8_t JE = 0x84;
+static const uint8_t JNE = 0x85;
+static const uint8_t JL = 0x8C;
+static const uint8_t JGE = 0x8D;
+static const uint8_t JLE = 0x8E;
+static const uint8_t JG = 0x8F;
+
+// the templates access the frame and the method directly, and thus depend on
+// their layout
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Winvalid-offsetof"
+const int32_t JIT::frameStackPtr = offsetof(VMFrame, stack_ptr);
+const int32_t JIT::frameArguments = offsetof(VMFrame, arguments);
+const int32_t JIT::frameLocals = offsetof(VMFrame, locals);
+const int32_t JIT::methodConstants = offsetof(VMMethod, indexableFields);
+  #pragma GCC diagnostic pop
+
+/// rax := the current frame
+void JIT::emitLoadFrame(Assembler& a) {
+    a.MovImm(Assembler::RAX, (uint64_t)&Interpreter::frame);
+    a.Load(Assembler::RAX, Assembler::RAX, 0);
+}
+
+/// push rcx onto the stack of the frame in rax
+void JIT::emitPushRcx(Assembler& a) {
+    a.Load(Assembler::RDX, Assembler::RAX, frameStackPtr);
+    a.AddImm(Assembler::RDX, sizeof(gc_oop_t));
+    a.Store(Assembler::RAX, frameStackPtr, Assembler::RDX);
+    a.Store(Assembler::RDX, 0, Assembler::RCX);
+}
+
+/// pop the top of the stack of the frame in rax into rcx
+void JIT::emitPopRcx(Assembler& a) {
+    a.Load(Assembler::RDX, Assembler::RAX, frameStackPtr);
+    a.Load(Assembler::RCX, Assembler::RDX, 0);
+    a.AddImm(Assembler::RDX, -(int8_t)sizeof(gc_oop_t));
+    a.Store(Assembler::RAX, frameStackPtr, Assembler::RDX);
+}
+
+/// Emits native code for the simple stack and control-flow bytecodes.
+/// Returns false if the bytecode needs to call its handler instead.
+bool JIT::emitTemplate(Assembler& a, const uint8_t* bytecodes,
+                       size_t bytecodeIndex) {
+    uint8_t const bc = Bytecode::GetBaseBytecode(bytecodes[bytecodeIndex]);
+    auto const slot = [](uint8_t idx) {
+        return (int32_t)(idx * sizeof(gc_oop_t));
+    };
+
+    switch (bc) {
+        case BC_JUMP:
+        case BC_JUMP2:
+        case BC_JUMP_BACKWARD:
+        case BC_JUMP2_BACKWARD:
+            a.JmpToBytecode(GetJumpTarget(bytecodes, bytecodeIndex));
+            return true;
+
+        case BC_DUP:
+            emitLoadFrame(a);
+            a.Load(Assembler::RDX, Assembler::RAX, frameStackPtr);
+            a.Load(Assembler::RCX, Assembler::RDX, 0);
+            emitPushRcx(a);
+            return true;
+
+        case BC_POP:
+            emitLoadFrame(a);
+            emitPopRcx(a);
+            return true;
+
+        case BC_PUSH_LOCAL_0:
+        case BC_PUSH_LOCAL_1:
+        case BC_PUSH_LOCAL_2:
+            emitLoadFrame(a);
+            a.Load(Assembler::RCX, Assembler::RAX, frameLocals);
+            a.Load(Assembler::RCX, Assembler::RCX, slot(bc - BC_PUSH_LOCAL_0));
+            emitPushRcx(a);
+            return true;
+
+        case BC_PUSH_SELF:
+        case BC_PUSH_ARG_1:
+        case BC_PUSH_ARG_2:
+            emitLoadFrame(a);
+            a.Load(Assembler::RCX, Assembler::RAX, frameArguments);
+            a.Load(Assembler::RCX, Assembler::RCX, slot(bc - BC_PUSH_SELF));
+            emitPushRcx(a);
+            return true;
+
+        case BC_PUSH_CONSTANT_0:
+        case BC_PUSH_CONSTANT_1:
+        case BC_PUSH_CONSTANT_2:
+            a.MovImm(Assembler::RCX, (uint64_t)&Interpreter::method);
+            a.Load(Assembler::RCX, Assembler::RCX, 0);
+            a.Load(Assembler::RCX, Assembler::RCX, methodConstants);
+            a.Load(Assembler::RCX, Assembler::RCX,
+                   slot(bc - BC_PUSH_CONSTANT_0));
+            emitLoadFrame(a);
+            emitPushRcx(a);
+            return true;
+
+        case BC_PUSH_NIL:
+            a.MovImm(Assembler::RCX, (uint64_t)&nilObject);
+            a.Load(Assembler::RCX, Assembler::RCX, 0);
+            emitLoadFrame(a);
+            emitPushRcx(a);
+            return true;
+
+        case BC_PUSH_0:
+        case BC_PUSH_1:
+            if (!USE_TAGGING) {
+                // boxed integers need to be allocated
+                return false;
+            }
+            a.MovImm(Assembler::RCX, (uint64_t)NEW_INT(bc - BC_PUSH_0));
+            emitLoadFrame(a);
+            emitPushRcx(a);
+            return true;
+
+        case BC_POP_LOCAL_0:
+        case BC_POP_LOCAL_1:
+        case BC_POP_LOCAL_2:
+            emitLoadFrame(a);
+            emitPopRcx(a);
+            a.Load(Assembler::RDX, Assembler::RAX, frameLocals);
+            a.Store(Assembler::RDX, slot(bc - BC_POP_LOCAL_0), Assembler::RCX);
+            return true;
+
+        case BC_JUMP_ON_FALSE_POP:
+        case BC_JUMP_ON_TRUE_POP:
+        case BC_JUMP_ON_NOT_NIL_POP:
+        case BC_JUMP_ON_NIL_POP:
+        case BC_JUMP2_ON_FALSE_POP:
+        case BC_JUMP2_ON_TRUE_POP:
+        case BC_JUMP2_ON_NOT_NIL_POP:
+        case BC_JUMP2_ON_NIL_POP: {
+            uint8_t const kind = bc < FIRST_DOUBLE_BYTE_JUMP_BYTECODE
+                                     ? bc
+                                     : bc - NUM_SINGLE_BYTE_JUMP_BYTECODES;
+            GCObject** expected = nullptr;
+            if (kind == BC_JUMP_ON_FALSE_POP) {
+                expected = &falseObject;
+            } else if (kind == BC_JUMP_ON_TRUE_POP) {
+                expected = &trueObject;
+            } else {
+                expected = &nilObject;
+            }
+
+            emitLoadFrame(a);
+            emitPopRcx(a);
+            a.MovImm(Assembler::RDX, (uint64_t)expected);
+            a.CmpRcxWithRdxRef();
+            a.JccToBytecode(kind == BC_JUMP_ON_NOT_NIL_POP ? JNE : JE,
+                            GetJumpTarget(bytecodes, bytecodeIndex));
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+/// Emits the operation inline for two small integers, and calls the handler
+/// otherwise, or when the result overflows. Tagged integers are stored as
+/// 2n + 1, and thus, compare like their values. Adding 2m to the receiver
+/// gives 2(n + m) + 1, and subtracting the argument gives 2(n - m). Both
+/// overflow exactly when the result does not fit into a tagged integer.
+void JIT::emitSmallIntegerOperation(Assembler& a, const uint8_t* bytecodes,
+                                    size_t bytecodeIndex, size_t exitLabel) {
+    uint8_t const bc = Bytecode::GetBaseBytecode(bytecodes[bytecodeIndex]);
+    constexpr auto top2 = -(int32_t)sizeof(gc_oop_t);
+
+    // rcx := argument, rbx := receiver
+    emitLoadFrame(a);
+    a.Load(Assembler::RDX, Assembler::RAX, frameStackPtr);
+    a.Load(Assembler::RCX, Assembler::RDX, 0);
+    a.Load(Assembler::RBX, Assembler::RDX, top2);
+
+    std::vector<size_t> slowPath;
+    a.TestTag(Assembler::RCX);
+    slowPath.push_back(a.JccForward(JE));
+    a.TestTag(Assembler::RBX);
+    slowPath.push_back(a.JccForward(JE));
+
+    if (bc == BC_ADD || bc == BC_SUB) {
+        if (bc == BC_ADD) {
+            a.AddImm(Assembler::RCX, -1);
+            a.Add(Assembler::RBX, Assembler::RCX);
+        } else {
+            a.Sub(Assembler::RBX, Assembler::RCX);
+        }
+        slowPath.push_back(a.JccForward(JO));
+        if (bc == BC_SUB) {
+            a.AddImm(Assembler::RBX, 1);
+        }
+        a.Store(Assembler::RDX, top2, Assembler::RBX);
+    } else {
+        uint8_t condition = JE;
+        if (bc == BC_LT) {
+            condition = JL;
+        } else if (bc == BC_GT) {
+            condition = JG;
+        } else if (bc == BC_LE) {
+            condition = JLE;
+        } else if (bc == BC_GE) {
+            condition = JGE;
+        }
+
+        a.Cmp(Assembler::RBX, Assembler::RCX);
+        a.MovImm(Assembler::RCX, (uint64_t)&trueObject);
+        size_t const isTrue = a.JccForward(condition);
+        a.MovImm(Assembler::RCX, (uint64_t)&falseObject);
+        a.Bind(isTrue);
+        a.Load(Assembler::RCX, Assembler::RCX, 0);
+        a.Store(Assembler::RDX, top2, Assembler::RCX);
+    }
+
+    a.AddImm(Assembler::RDX, top2);
+    a.Store(Assembler::RAX, frameStackPtr, Assembler::RDX);
+    size_t const done = a.JmpForward();
+
+    for (size_t const label : slowPath) {
+        a.Bind(label);
+    }
+    emitHandlerCall(a, bytecodes, bytecodeIndex, exitLabel);
+    a.Bind(done);
+}
+
+/// Emits the call of the handler, and the jump to the exit or the branch
+/// target, depending on its result.
+void JIT::emitHandlerCall(Assembler& a, const uint8_t* bytecodes,
+                          size_t bytecodeIndex, size_t exitLabel) {
+    uint8_t const bc = Bytecode::GetBaseBytecode(bytecodes[bytecodeIndex]);
+
+    Handler handler = nullptr;
+    if (bc == BC_SEND || IsQuickenedBytecode(bc)) {
+        handler = &handleSendSite;
+    } else if (bc > _LAST_BYTECODE) {
+        handler = &bailOut;
+    } else {
+        handler = handlers[bc];
+    }
+
+    a.CallHandler((uint32_t)bytecodeIndex, (void*)handler);
+
+    if (isJump(bc)) {
+        a.Emit8(0x3C);  // cmp al, BRANCH
+        a.Emit8(BRANCH);
+        a.JccToBytecode(JE, GetJumpTarget(bytecodes, bytecodeIndex));
+    } else if (!maySend(bc) && !isReturn(bc) && handler != &bailOut) {
+        // the handler never exits
+        return;
+    }
+
+    a.Emit8(0x84);  // test al, al
+    a.Emit8(0xC0);
+    a.JccTo(JNE, exitLabel);
+}
+
+void JIT::Compile(VMMethod* method) {
+    if (method->GetCompiledCode() != nullptr) {
+        return;
+    }
+
+    const uint8_t* bytecodes = method->GetBytecodes();
+    size_t const numberOfBytecodes = method->GetNumberOfBytecodes();
+
+    Assembler a;
+
+    // trampoline, called with the entry point in rdi, keeps the stack
+    // aligned for the handler calls
+    a.Emit8(0x53);  // push rbx
+    a.Emit8(0xFF);  // jmp rdi
+    a.Emit8(0xE7);
+
+    size_t const exitLabel = a.Position();
+    a.Emit8(0x5B);  // pop rbx
+    a.Emit8(0xC3);  // ret
+
+    std::vector<size_t> offsets(numberOfBytecodes, SIZE_MAX);
+
+    for (size_t i = 0; i < numberOfBytecodes;
+         i += Bytecode::GetBytecodeLength(bytecodes[i])) {
+        // superinstructions are compiled as their bytecodes
+        uint8_t const bc = Bytecode::GetBaseBytecode(bytecodes[i]);
+        offsets[i] = a.Position();
+
+        if (emitTemplate(a, bytecodes, i)) {
+            continue;
+        }
+
+        if (USE_TAGGING && isSmallIntegerOperation(bc)) {
+            emitSmallIntegerOperation(a, bytecodes, i, exitLabel);
+        } else {
+            emitHandlerCall(a, bytecodes, i, exitLabel);
+        }
+    }
+
+    // methods end in a return, falling off the end is a bug
+    a.Emit8(0x0F);  // ud2
+    a.Emit8(0x0B);
+
+    a.PatchBytecodeReferences(offsets);
+
+    auto const pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t const codeSize = a.Position();
+    size_t const mappedSize = (codeSize + pageSize - 1) & ~(pageSize - 1);
+
+    void* mem = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+        ErrorPrint("JIT: could not allocate memory for compiled code\n");
+        return;
+    }
+
+    memcpy(mem, a.Data(), codeSize);
+    if (mprotect(mem, mappedSize, PROT_READ | PROT_EXEC) != 0) {
+        ErrorPrint("JIT: could not make compiled code executable\n");
+        munmap(mem, mappedSize);
+        return;
+    }
+
+    auto* code = new CompiledCode((uint8_t*)mem, codeSize, numberOfBytecodes);
+    for (size_t i = 0; i < numberOfBytecodes; i += 1) {
+        if (offsets[i] != SIZE_MAX) {
+            code->entryPoints[i] = (uint8_t*)mem + offsets[i];
+        }
+    }
+    method->SetCompiledCode(code);
+}
+
+void JIT::Run() {
+    bailedOut = false;
+
+    while (true) {
+        if (GetHeap<HEAP_CLS>()->isCollectionTriggered()) {
+            Interpreter::startGC();
+        }
+
+        CompiledCode* code = Interpreter::method->GetCompiledCode();
+        if (code == nullptr) {
+            return;
+        }
+
+        assert(code->GetEntryPoint(Interpreter::bytecodeIndexGlobal) !=
+               nullptr);
+        code->Enter(Interpreter::bytecodeIndexGlobal);
+
+        if (bailedOut) {
+            return;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,126 @@
+#pragma once
+
+#ifdef USE_JIT
+
+  #include <array>
+  #include <cstddef>
+  #include <cstdint>
+  #include <utility>
+  #include <vector>
+
+  #include "../vmobjects/ObjectFormats.h"
+  #include "bytecodes.h"
+
+  // number of invocations, respectively loop iterations, after which a method
+  // is compiled
+  #define JIT_INVOCATION_THRESHOLD 1000
+  #define JIT_BACK_EDGE_THRESHOLD 10000
+
+class Assembler;
+
+/**
+ * The native code of a compiled method.
+ *
+ * The code is entered through a small trampoline, which jumps to the entry
+ * point of the bytecode at which the interpreter currently is. Thus, compiled
+ * code can be entered at the start of a method, after a send returned, and in
+ * the middle of a loop.
+ */
+class CompiledCode {
+public:
+    using EnterFn = void (*)(void* entryPoint);
+
+    CompiledCode(uint8_t* code, size_t codeSize, size_t numberOfBytecodes)
+        : code(code), codeSize(codeSize), entryPoints(numberOfBytecodes) {}
+    ~CompiledCode();
+
+    CompiledCode(const CompiledCode&) = delete;
+    CompiledCode& operator=(const CompiledCode&) = delete;
+
+    [[nodiscard]] inline void* GetEntryPoint(size_t bytecodeIndex) const {
+        return entryPoints[bytecodeIndex];
+    }
+
+    inline void Enter(size_t bytecodeIndex) const {
+        ((EnterFn)code)(entryPoints[bytecodeIndex]);
+    }
+
+private:
+    friend class JIT;
+
+    uint8_t* code;
+    size_t codeSize;
+    std::vector<void*> entryPoints;
+};
+
+/**
+ * A template-based baseline JIT compiler for x86-64.
+ *
+ * The simple stack bytecodes and the jumps are compiled to native code, and
+ * with tagging, so are the arithmetic and comparisons of small integers. For
+ * every other bytecode, and for operands of other types, the compiler emits
+ * a call to a handler that implements the bytecode with the same code the
+ * interpreter uses. This removes the bytecode dispatch. The compiled
+ * code contains no pointers into the heap, the handlers keep the frame and
+ * the bytecode index up to date, and collections happen at the same points
+ * as in the interpreter. Thus, compiled and interpreted code can be mixed
+ * freely.
+ *
+ * Handlers return to the compiled code whether it continues with the next
+ * bytecode, takes a branch, or has to exit. Exits happen when the current
+ * frame changed, i.e., on sends to non-primitives and on returns. JIT::Run()
+ * then continues in the compiled code of the new method, if there is any,
+ * and otherwise returns to the interpreter.
+ */
+class JIT {
+public:
+    /// Compiles the method, unless it was compiled already.
+    static void Compile(VMMethod* method);
+
+    /// Executes compiled code as long as the current method has some.
+    static void Run();
+
+private:
+    enum HandlerResult : uint8_t { CONTINUE = 0, EXIT = 1, BRANCH = 2 };
+    using Handler = uint8_t (*)(size_t bytecodeIndex);
+
+    template <uint8_t BC>
+    static uint8_t handle(size_t bytecodeIndex);
+    template <uint8_t BC>
+    static uint8_t handleJump(size_t bytecodeIndex);
+    static uint8_t handleSendSite(size_t bytecodeIndex);
+    static uint8_t bailOut(size_t bytecodeIndex);
+
+    static inline uint8_t afterSend(VMFrame* frameBefore,
+                                    size_t nextBytecodeIndex);
+
+    template <uint8_t BC>
+    static constexpr Handler handlerFor();
+    template <size_t... BCs>
+    static constexpr std::array<Handler, sizeof...(BCs)> createHandlers(
+        std::index_sequence<BCs...> /*unused*/);
+
+    static const std::array<Handler, _LAST_BYTECODE + 1> handlers;
+
+    static bool emitTemplate(Assembler& a, const uint8_t* bytecodes,
+                             size_t bytecodeIndex);
+    static void emitSmallIntegerOperation(Assembler& a,
+                                          const uint8_t* bytecodes,
+                                          size_t bytecodeIndex,
+                                          size_t exitLabel);
+    static void emitHandlerCall(Assembler& a, const uint8_t* bytecodes,
+                                size_t bytecodeIndex, size_t exitLabel);
+    static void emitLoadFrame(Assembler& a);
+    static void emitPushRcx(Assembler& a);
+    static void emitPopRcx(Assembler& a);
+
+    // offsets of the fields the native code accesses directly
+    static const int32_t frameStackPtr;
+    static const int32_t frameArguments;
+    static const int32_t frameLocals;
+    static const int32_t methodConstants;
+
+    static bool bailedOut;
+};
+
+#endif
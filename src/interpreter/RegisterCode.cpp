@@ -0,0 +1,589 @@
+#ifdef USE_REGISTER_BYTECODES
+
+  #include "RegisterCode.h"
+
+  #include <cstddef>
+  #include <cstdint>
+  #include <utility>
+  #include <vector>
+
+  #include "../misc/debug.h"
+  #include "../vm/Universe.h"
+  #include "../vmobjects/Signature.h"
+  #include "../vmobjects/VMMethod.h"
+  #include "../vmobjects/VMSymbol.h"
+  #include "bytecodes.h"
+
+static const char* registerBytecodeNames[] = {
+    "MOVE",
+    "LOAD_CONSTANT",
+    "LOAD_INT",
+    "LOAD_NIL",
+    "LOAD_FIELD",
+    "LOAD_GLOBAL",
+    "STORE_FIELD",
+    "INC_FIELD",
+    "ADD",
+    "SUB",
+    "MUL",
+    "LT",
+    "GT",
+    "LE",
+    "GE",
+    "EQ",
+    "EQ_EQ",
+    "INC",
+    "DEC",
+    "SEND",
+    "SEND_1",
+    "SUPER_SEND",
+    "JUMP",
+    "JUMP_ON_FALSE",
+    "JUMP_ON_TRUE",
+    "JUMP_ON_FALSE_TOP_NIL",
+    "JUMP_ON_TRUE_TOP_NIL",
+    "JUMP_ON_NOT_NIL",
+    "JUMP_ON_NIL",
+    "JUMP_ON_NOT_NIL_TOP_TOP",
+    "JUMP_ON_NIL_TOP_TOP",
+    "JUMP_IF_GREATER",
+    "RETURN",
+    "RETURN_FIELD",
+    "EXIT",
+};
+
+static_assert(sizeof(registerBytecodeNames) / sizeof(char*) ==
+                  NUM_REGISTER_BYTECODES,
+              "there needs to be a name for every register bytecode");
+
+static_assert(RBC_JUMP_IF_GREATER - RBC_JUMP_ON_FALSE ==
+                  BC_JUMP_IF_GREATER - BC_JUMP_ON_FALSE_POP,
+              "conditional jumps are expected in the same order as the "
+              "stack bytecodes");
+
+/**
+ * Translates stack bytecodes to register bytecodes.
+ *
+ * The translator tracks for every element of the operand stack the register
+ * that holds its value. Pushing a local or an argument does not copy it, but
+ * refers to the local's register. Values are only moved to their stack slot
+ * when the stack needs to be in the state the stack interpreter expects,
+ * i.e., before sends, jumps, and jump targets, or when the local they refer
+ * to is about to be overwritten. An instruction whose result is stored into
+ * a local right away writes it there directly.
+ */
+class RegisterTranslator {
+public:
+    explicit RegisterTranslator(VMMethod* method)
+        : method(method), bytecodes(method->GetBytecodes()),
+          numberOfBytecodes(method->GetNumberOfBytecodes()),
+          numberOfArguments(method->GetNumberOfArguments()),
+          firstStackSlot(method->GetNumberOfArguments() +
+                         method->GetNumberOfLocals()),
+          entries(numberOfBytecodes, -1), labels(numberOfBytecodes, -1),
+          labelDepths(numberOfBytecodes, -1),
+          isLabel(numberOfBytecodes, false) {}
+
+    /// Returns nullptr if the method uses bytecodes that are not supported.
+    RegisterCode* Translate();
+
+private:
+    bool translateBytecode(uint8_t bc, size_t bytecodeIndex);
+    bool translateJump(uint8_t bc, size_t bytecodeIndex);
+
+    [[nodiscard]] uint8_t stackSlot(size_t depth) const {
+        return (uint8_t)(firstStackSlot + depth);
+    }
+
+    [[nodiscard]] bool isMaterialized(size_t depth) const {
+        return stack[depth] == stackSlot(depth);
+    }
+
+    inline void push(uint8_t reg) { stack.push_back(reg); }
+
+    inline uint8_t pop() {
+        uint8_t const reg = stack.back();
+        stack.pop_back();
+        return reg;
+    }
+
+    void materialize(size_t depth);
+    void materializeAll();
+    void materializeUsesOf(uint8_t reg);
+
+    void emit(uint8_t opcode, uint8_t dst, uint8_t src1, uint8_t src2,
+              uint8_t top, uint16_t operand, size_t bytecodeIndex);
+
+    /// Emits an instruction that has no side effects other than writing its
+    /// result to the next stack slot, and pushes the result.
+    void emitProducer(uint8_t opcode, uint8_t src1, uint8_t src2, uint8_t top,
+                      uint16_t operand, size_t bytecodeIndex);
+    void emitStore(uint8_t reg, size_t bytecodeIndex);
+
+    /// Emits an exit to the interpreter, which then executes the bytecode.
+    void emitExit(size_t bytecodeIndex);
+    bool emitJump(uint8_t opcode, uint8_t dst, uint8_t src1, uint8_t src2,
+                  size_t target, size_t depthAtTarget);
+
+    bool mergeDepth(size_t bytecodeIndex, size_t depth);
+
+    VMMethod* method;
+    const uint8_t* bytecodes;
+    size_t numberOfBytecodes;
+    size_t numberOfArguments;
+    size_t firstStackSlot;
+
+    // the register that holds each element of the operand stack
+    std::vector<uint8_t> stack;
+    bool reachable{true};
+
+    // whether the last instruction only wrote the top of the stack, and can
+    // thus be changed to write somewhere else
+    bool lastIsProducer{false};
+
+    std::vector<RegisterInstruction> instructions;
+    std::vector<int32_t> entries;
+
+    // the instruction and the stack depth at each jump target
+    std::vector<int32_t> labels;
+    std::vector<int32_t> labelDepths;
+    std::vector<bool> isLabel;
+
+    // jump instructions, and the bytecode they jump to
+    std::vector<std::pair<size_t, size_t>> jumps;
+};
+
+void RegisterTranslator::materialize(size_t depth) {
+    if (!isMaterialized(depth)) {
+        emit(RBC_MOVE, stackSlot(depth), stack[depth], 0, 0, 0, 0);
+        stack[depth] = stackSlot(depth);
+    }
+}
+
+void RegisterTranslator::materializeAll() {
+    for (size_t i = 0; i < stack.size(); i += 1) {
+        materialize(i);
+    }
+}
+
+void RegisterTranslator::materializeUsesOf(uint8_t reg) {
+    for (size_t i = 0; i < stack.size(); i += 1) {
+        if (stack[i] == reg) {
+            materialize(i);
+        }
+    }
+}
+
+void RegisterTranslator::emit(uint8_t opcode, uint8_t dst, uint8_t src1,
+                              uint8_t src2, uint8_t top, uint16_t operand,
+                              size_t bytecodeIndex) {
+    instructions.push_back({opcode, dst, src1, src2, top, operand,
+                            (uint32_t)bytecodeIndex});
+    lastIsProducer = false;
+}
+
+void RegisterTranslator::emitProducer(uint8_t opcode, uint8_t src1,
+                                      uint8_t src2, uint8_t top,
+                                      uint16_t operand, size_t bytecodeIndex) {
+    uint8_t const dst = stackSlot(stack.size());
+    emit(opcode, dst, src1, src2, top, operand, bytecodeIndex);
+    push(dst);
+    lastIsProducer = true;
+}
+
+void RegisterTranslator::emitStore(uint8_t reg, size_t bytecodeIndex) {
+    uint8_t const value = pop();
+    materializeUsesOf(reg);
+
+    if (lastIsProducer && value == stackSlot(stack.size()) &&
+        instructions.back().dst == value) {
+        instructions.back().dst = reg;
+        // the value never reaches the stack, which the stack interpreter
+        // would expect here
+        entries[bytecodeIndex] = -1;
+        lastIsProducer = false;
+        return;
+    }
+    emit(RBC_MOVE, reg, value, 0, 0, 0, 0);
+}
+
+void RegisterTranslator::emitExit(size_t bytecodeIndex) {
+    materializeAll();
+    emit(RBC_EXIT, 0, 0, 0, stackSlot(stack.size()) - 1, 0, bytecodeIndex);
+    // entering here would only exit again
+    entries[bytecodeIndex] = -1;
+}
+
+bool RegisterTranslator::mergeDepth(size_t bytecodeIndex, size_t depth) {
+    if (labelDepths[bytecodeIndex] < 0) {
+        labelDepths[bytecodeIndex] = (int32_t)depth;
+        return true;
+    }
+    return labelDepths[bytecodeIndex] == (int32_t)depth;
+}
+
+bool RegisterTranslator::emitJump(uint8_t opcode, uint8_t dst, uint8_t src1,
+                                  uint8_t src2, size_t target,
+                                  size_t depthAtTarget) {
+    if (!mergeDepth(target, depthAtTarget)) {
+        return false;
+    }
+    jumps.emplace_back(instructions.size(), target);
+    emit(opcode, dst, src1, src2, 0, 0, 0);
+    return true;
+}
+
+bool RegisterTranslator::translateJump(uint8_t bc, size_t bytecodeIndex) {
+    size_t const target = GetJumpTarget(bytecodes, bytecodeIndex);
+
+    // the two-byte variants behave like their one-byte counterparts
+    if (bc >= FIRST_DOUBLE_BYTE_JUMP_BYTECODE) {
+        bc -= FIRST_DOUBLE_BYTE_JUMP_BYTECODE - BC_JUMP;
+    }
+
+    switch (bc) {
+        case BC_JUMP:
+        case BC_JUMP_BACKWARD:
+            materializeAll();
+            reachable = false;
+            return emitJump(RBC_JUMP, 0, 0, 0, target, stack.size());
+
+        case BC_JUMP_ON_FALSE_POP:
+        case BC_JUMP_ON_TRUE_POP:
+        case BC_JUMP_ON_NOT_NIL_POP:
+        case BC_JUMP_ON_NIL_POP: {
+            uint8_t const condition = pop();
+            materializeAll();
+            return emitJump(RBC_JUMP_ON_FALSE + (bc - BC_JUMP_ON_FALSE_POP),
+                            0, condition, 0, target, stack.size());
+        }
+
+        case BC_JUMP_ON_FALSE_TOP_NIL:
+        case BC_JUMP_ON_TRUE_TOP_NIL:
+        case BC_JUMP_ON_NOT_NIL_TOP_TOP:
+        case BC_JUMP_ON_NIL_TOP_TOP: {
+            // the value stays on the stack only if the jump is taken
+            uint8_t const condition = pop();
+            materializeAll();
+            return emitJump(RBC_JUMP_ON_FALSE + (bc - BC_JUMP_ON_FALSE_POP),
+                            stackSlot(stack.size()), condition, 0, target,
+                            stack.size() + 1);
+        }
+
+        case BC_JUMP_IF_GREATER: {
+            // both operands stay on the stack if the jump is not taken
+            size_t const depth = stack.size();
+            for (size_t i = 0; i < depth - 2; i += 1) {
+                materialize(i);
+            }
+            return emitJump(RBC_JUMP_IF_GREATER, 0, stack[depth - 1],
+                            stack[depth - 2], target, depth - 2);
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool RegisterTranslator::translateBytecode(uint8_t bc, size_t bytecodeIndex) {
+    uint8_t const operand = bytecodeIndex + 1 < numberOfBytecodes
+                                ? bytecodes[bytecodeIndex + 1]
+                                : 0;
+
+    switch (bc) {
+        case BC_DUP:
+            push(stack.back());
+            return true;
+
+        case BC_DUP_SECOND:
+            push(stack[stack.size() - 2]);
+            return true;
+
+        case BC_PUSH_LOCAL:
+            if (bytecodes[bytecodeIndex + 2] != 0) {
+                return false;
+            }
+            push(numberOfArguments + operand);
+            return true;
+
+        case BC_PUSH_LOCAL_0:
+        case BC_PUSH_LOCAL_1:
+        case BC_PUSH_LOCAL_2:
+            push(numberOfArguments + (bc - BC_PUSH_LOCAL_0));
+            return true;
+
+        case BC_PUSH_ARGUMENT:
+            if (bytecodes[bytecodeIndex + 2] != 0) {
+                return false;
+            }
+            push(operand);
+            return true;
+
+        case BC_PUSH_SELF:
+        case BC_PUSH_ARG_1:
+        case BC_PUSH_ARG_2:
+            push(bc - BC_PUSH_SELF);
+            return true;
+
+        case BC_PUSH_FIELD:
+            emitProducer(RBC_LOAD_FIELD, 0, 0, 0, operand, bytecodeIndex);
+            return true;
+
+        case BC_PUSH_FIELD_0:
+        case BC_PUSH_FIELD_1:
+            emitProducer(RBC_LOAD_FIELD, 0, 0, 0, bc - BC_PUSH_FIELD_0,
+                         bytecodeIndex);
+            return true;
+
+        case BC_PUSH_CONSTANT:
+            emitProducer(RBC_LOAD_CONSTANT, 0, 0, 0, operand, bytecodeIndex);
+            return true;
+
+        case BC_PUSH_CONSTANT_0:
+        case BC_PUSH_CONSTANT_1:
+        case BC_PUSH_CONSTANT_2:
+            emitProducer(RBC_LOAD_CONSTANT, 0, 0, 0, bc - BC_PUSH_CONSTANT_0,
+                         bytecodeIndex);
+            return true;
+
+        case BC_PUSH_0:
+        case BC_PUSH_1:
+            emitProducer(RBC_LOAD_INT, 0, 0, 0, bc - BC_PUSH_0, bytecodeIndex);
+            return true;
+
+        case BC_PUSH_NIL:
+            emitProducer(RBC_LOAD_NIL, 0, 0, 0, 0, bytecodeIndex);
+            return true;
+
+        case BC_PUSH_GLOBAL: {
+            materializeAll();
+            uint8_t const dst = stackSlot(stack.size());
+            emit(RBC_LOAD_GLOBAL, dst, 0, 0, dst - 1, 0, bytecodeIndex);
+            push(dst);
+            return true;
+        }
+
+        case BC_POP:
+            pop();
+            return true;
+
+        case BC_POP_LOCAL:
+            if (bytecodes[bytecodeIndex + 2] != 0) {
+                return false;
+            }
+            emitStore(numberOfArguments + operand, bytecodeIndex);
+            return true;
+
+        case BC_POP_LOCAL_0:
+        case BC_POP_LOCAL_1:
+        case BC_POP_LOCAL_2:
+            emitStore(numberOfArguments + (bc - BC_POP_LOCAL_0),
+                      bytecodeIndex);
+            return true;
+
+        case BC_POP_ARGUMENT:
+            if (bytecodes[bytecodeIndex + 2] != 0) {
+                return false;
+            }
+            emitStore(operand, bytecodeIndex);
+            return true;
+
+        case BC_POP_FIELD:
+            emit(RBC_STORE_FIELD, 0, pop(), 0, 0, operand, bytecodeIndex);
+            return true;
+
+        case BC_POP_FIELD_0:
+        case BC_POP_FIELD_1:
+            emit(RBC_STORE_FIELD, 0, pop(), 0, 0, bc - BC_POP_FIELD_0,
+                 bytecodeIndex);
+            return true;
+
+        case BC_SEND:
+        case BC_SEND_1:
+        case BC_SUPER_SEND:
+        case BC_DIV_DOUBLE:
+        case BC_AT_ARRAY:
+        case BC_AT_PUT_ARRAY:
+        case BC_INST_VAR_NAMED: {
+            materializeAll();
+            auto* signature =
+                static_cast<VMSymbol*>(method->GetConstant(bytecodeIndex));
+            size_t const receiver =
+                stack.size() - Signature::GetNumberOfArguments(signature);
+            uint8_t opcode = RBC_SEND;
+            if (bc == BC_SEND_1) {
+                opcode = RBC_SEND_1;
+            } else if (bc == BC_SUPER_SEND) {
+                opcode = RBC_SUPER_SEND;
+            }
+            emit(opcode, stackSlot(receiver), 0, 0,
+                 stackSlot(stack.size() - 1), 0, bytecodeIndex);
+            stack.resize(receiver);
+            push(stackSlot(receiver));
+            return true;
+        }
+
+        case BC_ADD:
+        case BC_SUB:
+        case BC_MUL:
+        case BC_LT:
+        case BC_GT:
+        case BC_LE:
+        case BC_GE:
+        case BC_EQ:
+        case BC_EQ_EQ: {
+            uint8_t const top = stackSlot(stack.size() - 1);
+            uint8_t const arg = pop();
+            uint8_t const rcvr = pop();
+            materializeAll();
+            emitProducer(RBC_ADD + (bc - BC_ADD), rcvr, arg, top, 0,
+                         bytecodeIndex);
+            return true;
+        }
+
+        case BC_INC:
+        case BC_DEC: {
+            uint8_t const top = stackSlot(stack.size() - 1);
+            uint8_t const value = pop();
+            materializeAll();
+            emitProducer(bc == BC_INC ? RBC_INC : RBC_DEC, value, 0, top, 0,
+                         bytecodeIndex);
+            return true;
+        }
+
+        case BC_INC_FIELD:
+            emit(RBC_INC_FIELD, 0, 0, 0, 0, operand, bytecodeIndex);
+            return true;
+
+        case BC_INC_FIELD_PUSH:
+            emit(RBC_INC_FIELD, 0, 0, 0, 0, operand, bytecodeIndex);
+            emitProducer(RBC_LOAD_FIELD, 0, 0, 0, operand, bytecodeIndex);
+            return true;
+
+        case BC_RETURN_LOCAL:
+            emit(RBC_RETURN, 0, pop(), 0, 0, 0, bytecodeIndex);
+            reachable = false;
+            return true;
+
+        case BC_RETURN_SELF:
+            emit(RBC_RETURN, 0, 0, 0, 0, 0, bytecodeIndex);
+            reachable = false;
+            return true;
+
+        case BC_RETURN_FIELD_0:
+        case BC_RETURN_FIELD_1:
+        case BC_RETURN_FIELD_2:
+            emit(RBC_RETURN_FIELD, 0, 0, 0, 0, bc - BC_RETURN_FIELD_0,
+                 bytecodeIndex);
+            reachable = false;
+            return true;
+
+        case BC_PUSH_BLOCK:
+            // the block captures the frame, which the interpreter moves to
+            // the heap, and the register code continues to work on
+            emitExit(bytecodeIndex);
+            push(stackSlot(stack.size()));
+            return true;
+
+        default:
+            if (IsJumpBytecode(bc)) {
+                return translateJump(bc, bytecodeIndex);
+            }
+            // non-local returns and BC_HALT stay in the interpreter
+            return false;
+    }
+}
+
+RegisterCode* RegisterTranslator::Translate() {
+    if (firstStackSlot + method->GetMaximumNumberOfStackElements() >
+        UINT8_MAX) {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < numberOfBytecodes;
+         i += Bytecode::GetBytecodeLength(bytecodes[i])) {
+        if (IsJumpBytecode(Bytecode::GetBaseBytecode(bytecodes[i]))) {
+            isLabel[GetJumpTarget(bytecodes, i)] = true;
+        }
+    }
+
+    for (size_t i = 0; i < numberOfBytecodes;
+         i += Bytecode::GetBytecodeLength(bytecodes[i])) {
+        if (isLabel[i]) {
+            if (reachable) {
+                materializeAll();
+                if (!mergeDepth(i, stack.size())) {
+                    return nullptr;
+                }
+            } else if (labelDepths[i] >= 0) {
+                stack.clear();
+                for (int32_t d = 0; d < labelDepths[i]; d += 1) {
+                    push(stackSlot(d));
+                }
+                reachable = true;
+            }
+            labels[i] = (int32_t)instructions.size();
+            lastIsProducer = false;
+        }
+
+        if (!reachable) {
+            continue;
+        }
+
+        bool allMaterialized = true;
+        for (size_t d = 0; d < stack.size(); d += 1) {
+            allMaterialized = allMaterialized && isMaterialized(d);
+        }
+        if (allMaterialized) {
+            entries[i] = (int32_t)instructions.size();
+        }
+
+        if (!translateBytecode(Bytecode::GetBaseBytecode(bytecodes[i]), i)) {
+            return nullptr;
+        }
+    }
+
+    if (instructions.size() > UINT16_MAX) {
+        return nullptr;
+    }
+
+    for (auto [instruction, target] : jumps) {
+        if (labels[target] < 0) {
+            return nullptr;
+        }
+        instructions[instruction].operand = (uint16_t)labels[target];
+    }
+
+    return new RegisterCode(std::move(instructions), std::move(entries));
+}
+
+void RegisterCode::Translate(VMMethod* method) {
+    if (method->GetRegisterCode() != nullptr || method->IsBlockMethod()) {
+        return;
+    }
+
+    RegisterTranslator translator(method);
+    RegisterCode* code = translator.Translate();
+    if (code == nullptr) {
+        return;
+    }
+
+    if (dumpBytecodes > 0) {
+        code->Dump(method);
+    }
+    method->SetRegisterCode(code);
+}
+
+void RegisterCode::Dump(VMMethod* method) const {
+    DebugDump("Register code of %s:\n", method->AsDebugString().c_str());
+    for (size_t i = 0; i < instructions.size(); i += 1) {
+        const RegisterInstruction& instr = instructions[i];
+        DebugPrint("  %4zu: %-24s dst: %3d src: %3d %3d top: %3d op: %5d "
+                   "bc: %d\n",
+                   i, registerBytecodeNames[instr.opcode], instr.dst,
+                   instr.src1, instr.src2, instr.top, instr.operand,
+                   instr.bytecodeIndex);
+    }
+}
+
+#endif
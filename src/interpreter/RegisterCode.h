@@ -0,0 +1,124 @@
+#pragma once
+
+#ifdef USE_REGISTER_BYTECODES
+
+  #include <cstddef>
+  #include <cstdint>
+  #include <utility>
+  #include <vector>
+
+  #include "../vmobjects/ObjectFormats.h"
+
+  // number of invocations, respectively loop iterations, after which a method
+  // is translated to register bytecodes
+  #define REGISTER_INVOCATION_THRESHOLD 100
+  #define REGISTER_BACK_EDGE_THRESHOLD 1000
+
+// register bytecodes. Registers are the slots of a frame, i.e., the
+// arguments, followed by the locals, followed by the operand stack.
+//
+// clang-format off
+  #define RBC_MOVE                      0  // dst := src1
+  #define RBC_LOAD_CONSTANT             1  // dst := literal operand
+  #define RBC_LOAD_INT                  2  // dst := operand as integer
+  #define RBC_LOAD_NIL                  3  // dst := nil
+  #define RBC_LOAD_FIELD                4  // dst := field operand of self
+  #define RBC_LOAD_GLOBAL               5  // dst := global, may send
+  #define RBC_STORE_FIELD               6  // field operand of self := src1
+  #define RBC_INC_FIELD                 7  // field operand of self += 1
+  #define RBC_ADD                       8  // dst := src1 + src2
+  #define RBC_SUB                       9
+  #define RBC_MUL                      10
+  #define RBC_LT                       11
+  #define RBC_GT                       12
+  #define RBC_LE                       13
+  #define RBC_GE                       14
+  #define RBC_EQ                       15
+  #define RBC_EQ_EQ                    16
+  #define RBC_INC                      17  // dst := src1 + 1
+  #define RBC_DEC                      18  // dst := src1 - 1
+  #define RBC_SEND                     19  // dst := send with args up to top
+  #define RBC_SEND_1                   20
+  #define RBC_SUPER_SEND               21
+  #define RBC_JUMP                     22  // jump to instruction operand
+  #define RBC_JUMP_ON_FALSE            23  // jump if src1 is false
+  #define RBC_JUMP_ON_TRUE             24
+  #define RBC_JUMP_ON_FALSE_TOP_NIL    25  // if src1 is false, dst := nil, jump
+  #define RBC_JUMP_ON_TRUE_TOP_NIL     26
+  #define RBC_JUMP_ON_NOT_NIL          27
+  #define RBC_JUMP_ON_NIL              28
+  #define RBC_JUMP_ON_NOT_NIL_TOP_TOP  29  // if src1 is not nil, dst := src1,
+  #define RBC_JUMP_ON_NIL_TOP_TOP      30  // and jump
+  #define RBC_JUMP_IF_GREATER          31  // jump if src1 > src2
+  #define RBC_RETURN                   32  // return src1
+  #define RBC_RETURN_FIELD             33  // return field operand of self
+  #define RBC_EXIT                     34  // continue in the interpreter
+
+  #define NUM_REGISTER_BYTECODES       35
+// clang-format on
+
+/**
+ * One register bytecode.
+ *
+ * Instructions that may fall back to the interpreter's implementation of the
+ * stack bytecode they were translated from record that bytecode's index, and
+ * the register that is the top of the operand stack at that point. The slow
+ * path moves the operands to the stack slots the stack bytecode expects, and
+ * thereby restores the frame the interpreter would have.
+ */
+struct RegisterInstruction {
+    uint8_t opcode;
+    uint8_t dst;
+    uint8_t src1;
+    uint8_t src2;
+    uint8_t top;
+    uint16_t operand;
+    uint32_t bytecodeIndex;
+};
+
+/**
+ * The register bytecodes of a method.
+ *
+ * The translation keeps the values of the operand stack in the registers of
+ * locals and arguments where possible, instead of copying them to the stack.
+ * Thus, the register code can only be entered at bytecodes at which all
+ * operands are materialized on the stack, which are recorded as entries.
+ * This includes the start of the method, the bytecodes after sends, and jump
+ * targets, i.e., all points at which the interpreter checks for register
+ * code.
+ */
+class RegisterCode {
+public:
+    RegisterCode(std::vector<RegisterInstruction> instructions,
+                 std::vector<int32_t> entries)
+        : instructions(std::move(instructions)), entries(std::move(entries)) {}
+
+    /// Translates the method, unless it was translated already, or it uses
+    /// bytecodes that have no register equivalent, e.g., it accesses outer
+    /// contexts. Creating a block exits to the interpreter, which continues
+    /// with the register code at the next send or loop iteration.
+    static void Translate(VMMethod* method);
+
+    [[nodiscard]] inline const RegisterInstruction* GetInstructions() const {
+        return instructions.data();
+    }
+
+    /// Returns the instruction for the bytecode, or nullptr if the register
+    /// code cannot be entered there.
+    [[nodiscard]] inline const RegisterInstruction* GetEntry(
+        size_t bytecodeIndex) const {
+        int32_t const entry = entries[bytecodeIndex];
+        if (entry < 0) {
+            return nullptr;
+        }
+        return &instructions[entry];
+    }
+
+    void Dump(VMMethod* method) const;
+
+private:
+    std::vector<RegisterInstruction> instructions;
+    std::vector<int32_t> entries;
+};
+
+#endif
@@ -0,0 +1,364 @@
+#ifdef USE_REGISTER_BYTECODES
+
+  #include "RegisterInterpreter.h"
+
+  #include <cstddef>
+  #include <cstdint>
+
+  #include "../memory/Heap.h"
+  #include "../misc/defs.h"
+  #include "../vm/Globals.h"
+  #include "../vm/Universe.h"
+  #include "../vmobjects/IntegerBox.h"    // NOLINT(misc-include-cleaner)
+  #include "../vmobjects/VMBigInteger.h"  // NOLINT(misc-include-cleaner)
+  #include "../vmobjects/ObjectFormats.h"
+  #include "../vmobjects/VMDouble.h"
+  #include "../vmobjects/VMFrame.h"
+  #include "../vmobjects/VMMethod.h"
+  #include "../vmobjects/VMObject.h"
+  #include "Interpreter.h"
+  #include "RegisterCode.h"
+
+void RegisterInterpreter::Run() {
+    while (true) {
+        if (GetHeap<HEAP_CLS>()->isCollectionTriggered()) {
+            Interpreter::startGC();
+        }
+
+        RegisterCode* code = Interpreter::method->GetRegisterCode();
+        if (code == nullptr) {
+            return;
+        }
+
+        const RegisterInstruction* entry =
+            code->GetEntry(Interpreter::bytecodeIndexGlobal);
+        if (entry == nullptr) {
+            return;
+        }
+
+        execute(code, entry);
+    }
+}
+
+  #define REG(r) load_ptr(regs[r])
+
+// registers are written like VMFrame::Push() writes the stack
+static inline void setRegister([[maybe_unused]] VMFrame* frame,
+                               gc_oop_t* regs, uint8_t reg, vm_oop_t value) {
+    regs[reg] = store_with_separate_barrier(value);
+    write_barrier_slot(frame, &regs[reg], value);
+}
+
+  #define SET_REG(r, val) setRegister(frame, regs, r, val)
+
+  #define DISPATCH() goto* targets[ip->opcode]
+
+  #define NEXT()      \
+      {               \
+          ++ip;       \
+          DISPATCH(); \
+      }
+
+  #define JUMP()                           \
+      {                                    \
+          ip = instructions + ip->operand; \
+          DISPATCH();                      \
+      }
+
+  // brings the frame into the state the stack interpreter expects after the
+  // bytecode the current instruction was translated from
+  #define SYNC(top, nextBytecodeIndex)                            \
+      {                                                           \
+          frame->stack_ptr = &regs[top];                          \
+          Interpreter::bytecodeIndexGlobal = (nextBytecodeIndex); \
+      }
+
+  // continues with the next instruction, after collecting garbage, if
+  // needed. All stack slots up to liveTop have to hold valid values
+  #define NEXT_GC(liveTop, nextBytecodeIndex)                           \
+      {                                                                 \
+          if (unlikely(GetHeap<HEAP_CLS>()->isCollectionTriggered())) { \
+              SYNC(liveTop, nextBytecodeIndex);                         \
+              Interpreter::startGC();                                   \
+              frame = Interpreter::GetFrame();                          \
+              regs = frame->arguments;                                  \
+          }                                                             \
+          NEXT();                                                       \
+      }
+
+  // moves the operands of a binary operation to the stack, and executes the
+  // stack interpreter's implementation of it
+  #define BINARY_SLOW_PATH(doOperation)                               \
+      {                                                               \
+          vm_oop_t const rcvr = REG(ip->src1);                        \
+          vm_oop_t const arg = REG(ip->src2);                         \
+          SET_REG(ip->top - 1, rcvr);                                 \
+          SET_REG(ip->top, arg);                                      \
+          SYNC(ip->top, ip->bytecodeIndex + 2);                       \
+          doOperation(ip->bytecodeIndex);                             \
+          if (Interpreter::GetFrame() != frame) {                     \
+              return;                                                 \
+          }                                                           \
+          regs[ip->dst] = regs[ip->top - 1];                          \
+          NEXT_GC(ip->dst == ip->top - 1 ? ip->top - 1 : ip->top - 2, \
+                  ip->bytecodeIndex + 2);                             \
+      }
+
+  #define ARITHMETIC(op, builtin)                                         \
+      {                                                                   \
+          vm_oop_t const left = REG(ip->src1);                            \
+          vm_oop_t const right = REG(ip->src2);                           \
+          int64_t result = 0;                                             \
+          if (likely(IS_SMALL_INT(left) && IS_SMALL_INT(right) &&         \
+                     !builtin(SMALL_INT_VAL(left), SMALL_INT_VAL(right),  \
+                              &result))) {                                \
+              SET_REG(ip->dst, NEW_INT(result));                          \
+              NEXT_GC(ip->dst == ip->top - 1 ? ip->top - 1 : ip->top - 2, \
+                      ip->bytecodeIndex + 2);                             \
+          }                                                               \
+          BINARY_SLOW_PATH(Interpreter::doArithmetic<Interpreter::op>);   \
+      }
+
+  #define COMPARISON(op, cmp)                                              \
+      {                                                                    \
+          vm_oop_t const left = REG(ip->src1);                             \
+          vm_oop_t const right = REG(ip->src2);                            \
+          if (likely(IS_SMALL_INT(left) && IS_SMALL_INT(right))) {         \
+              regs[ip->dst] = SMALL_INT_VAL(left) cmp SMALL_INT_VAL(right) \
+                                  ? trueObject                             \
+                                  : falseObject;                           \
+              NEXT();                                                      \
+          }                                                                \
+          BINARY_SLOW_PATH(Interpreter::doComparison<Interpreter::op>);    \
+      }
+
+  // sends, and everything else that may push a frame, are left to the stack
+  // interpreter
+  #define SEND(doSend)                             \
+      {                                            \
+          SYNC(ip->top, ip->bytecodeIndex + 2);    \
+          doSend(ip->bytecodeIndex);               \
+          if (Interpreter::GetFrame() != frame) {  \
+              return;                              \
+          }                                        \
+          NEXT_GC(ip->dst, ip->bytecodeIndex + 2); \
+      }
+
+  #define JUMP_IF(condition) \
+      {                      \
+          if (condition) {   \
+              JUMP();        \
+          }                  \
+          NEXT();            \
+      }
+
+  // the jumps that keep a value on the stack when they are taken
+  #define JUMP_IF_KEEP(condition, keep)         \
+      {                                         \
+          vm_oop_t const value = REG(ip->src1); \
+          if (condition) {                      \
+              regs[ip->dst] = (keep);           \
+              JUMP();                           \
+          }                                     \
+          NEXT();                               \
+      }
+
+void RegisterInterpreter::execute(const RegisterCode* code,
+                                  const RegisterInstruction* entry) {
+    // clang-format off
+    static void* targets[] = {
+        &&LABEL_RBC_MOVE,
+        &&LABEL_RBC_LOAD_CONSTANT,
+        &&LABEL_RBC_LOAD_INT,
+        &&LABEL_RBC_LOAD_NIL,
+        &&LABEL_RBC_LOAD_FIELD,
+        &&LABEL_RBC_LOAD_GLOBAL,
+        &&LABEL_RBC_STORE_FIELD,
+        &&LABEL_RBC_INC_FIELD,
+        &&LABEL_RBC_ADD,
+        &&LABEL_RBC_SUB,
+        &&LABEL_RBC_MUL,
+        &&LABEL_RBC_LT,
+        &&LABEL_RBC_GT,
+        &&LABEL_RBC_LE,
+        &&LABEL_RBC_GE,
+        &&LABEL_RBC_EQ,
+        &&LABEL_RBC_EQ_EQ,
+        &&LABEL_RBC_INC,
+        &&LABEL_RBC_DEC,
+        &&LABEL_RBC_SEND,
+        &&LABEL_RBC_SEND_1,
+        &&LABEL_RBC_SUPER_SEND,
+        &&LABEL_RBC_JUMP,
+        &&LABEL_RBC_JUMP_ON_FALSE,
+        &&LABEL_RBC_JUMP_ON_TRUE,
+        &&LABEL_RBC_JUMP_ON_FALSE_TOP_NIL,
+        &&LABEL_RBC_JUMP_ON_TRUE_TOP_NIL,
+        &&LABEL_RBC_JUMP_ON_NOT_NIL,
+        &&LABEL_RBC_JUMP_ON_NIL,
+        &&LABEL_RBC_JUMP_ON_NOT_NIL_TOP_TOP,
+        &&LABEL_RBC_JUMP_ON_NIL_TOP_TOP,
+        &&LABEL_RBC_JUMP_IF_GREATER,
+        &&LABEL_RBC_RETURN,
+        &&LABEL_RBC_RETURN_FIELD,
+        &&LABEL_RBC_EXIT,
+    };
+    // clang-format on
+    static_assert(sizeof(targets) / sizeof(void*) == NUM_REGISTER_BYTECODES,
+                  "there needs to be a label for every register bytecode");
+
+    const RegisterInstruction* instructions = code->GetInstructions();
+    const RegisterInstruction* ip = entry;
+    VMFrame* frame = Interpreter::GetFrame();
+    gc_oop_t* regs = frame->arguments;
+
+    DISPATCH();
+
+LABEL_RBC_MOVE:
+    regs[ip->dst] = regs[ip->src1];
+    NEXT();
+
+LABEL_RBC_LOAD_CONSTANT:
+    SET_REG(ip->dst, Interpreter::method->GetIndexableField(ip->operand));
+    NEXT();
+
+LABEL_RBC_LOAD_INT:
+    SET_REG(ip->dst, NEW_INT(ip->operand));
+    NEXT();
+
+LABEL_RBC_LOAD_NIL:
+    regs[ip->dst] = nilObject;
+    NEXT();
+
+LABEL_RBC_LOAD_FIELD:
+    SET_REG(ip->dst, static_cast<VMObject*>(REG(0))->GetField(ip->operand));
+    NEXT();
+
+LABEL_RBC_LOAD_GLOBAL:
+    SEND(Interpreter::doPushGlobal);
+
+LABEL_RBC_STORE_FIELD:
+    static_cast<VMObject*>(REG(0))->SetField(ip->operand, REG(ip->src1));
+    NEXT();
+
+LABEL_RBC_INC_FIELD:
+    Interpreter::doIncField(ip->operand);
+    NEXT();
+
+LABEL_RBC_ADD:
+    ARITHMETIC(ADD, __builtin_add_overflow);
+
+LABEL_RBC_SUB:
+    ARITHMETIC(SUB, __builtin_sub_overflow);
+
+LABEL_RBC_MUL:
+    ARITHMETIC(MUL, __builtin_mul_overflow);
+
+LABEL_RBC_LT:
+    COMPARISON(LT, <);
+
+LABEL_RBC_GT:
+    COMPARISON(GT, >);
+
+LABEL_RBC_LE:
+    COMPARISON(LE, <=);
+
+LABEL_RBC_GE:
+    COMPARISON(GE, >=);
+
+LABEL_RBC_EQ:
+    COMPARISON(EQ, ==);
+
+LABEL_RBC_EQ_EQ: {
+    vm_oop_t const left = REG(ip->src1);
+    vm_oop_t const right = REG(ip->src2);
+    if (likely(IS_SMALL_INT(left) && IS_SMALL_INT(right))) {
+        regs[ip->dst] = SMALL_INT_VAL(left) == SMALL_INT_VAL(right)
+                            ? trueObject
+                            : falseObject;
+        NEXT();
+    }
+    BINARY_SLOW_PATH(Interpreter::doIdentityEquals);
+}
+
+LABEL_RBC_INC:
+LABEL_RBC_DEC: {
+    vm_oop_t const value = REG(ip->src1);
+    if (likely(IS_SMALL_INT(value))) {
+        int64_t const delta = ip->opcode == RBC_INC ? 1 : -1;
+        SET_REG(ip->dst, NEW_INT(SMALL_INT_VAL(value) + delta));
+    } else {
+        SET_REG(ip->top, value);
+        SYNC(ip->top, ip->bytecodeIndex + 1);
+        if (ip->opcode == RBC_INC) {
+            Interpreter::doInc();
+        } else {
+            Interpreter::doDec();
+        }
+        regs[ip->dst] = regs[ip->top];
+    }
+    NEXT_GC(ip->dst == ip->top ? ip->top : ip->top - 1,
+            ip->bytecodeIndex + 1);
+}
+
+LABEL_RBC_SEND:
+    SEND(Interpreter::doSend);
+
+LABEL_RBC_SEND_1:
+    SEND(Interpreter::doUnarySend);
+
+LABEL_RBC_SUPER_SEND:
+    SEND(Interpreter::doSuperSend);
+
+LABEL_RBC_JUMP:
+    JUMP();
+
+LABEL_RBC_JUMP_ON_FALSE:
+    JUMP_IF(REG(ip->src1) == load_ptr(falseObject));
+
+LABEL_RBC_JUMP_ON_TRUE:
+    JUMP_IF(REG(ip->src1) == load_ptr(trueObject));
+
+LABEL_RBC_JUMP_ON_NOT_NIL:
+    JUMP_IF(REG(ip->src1) != load_ptr(nilObject));
+
+LABEL_RBC_JUMP_ON_NIL:
+    JUMP_IF(REG(ip->src1) == load_ptr(nilObject));
+
+LABEL_RBC_JUMP_ON_FALSE_TOP_NIL:
+    JUMP_IF_KEEP(value == load_ptr(falseObject), nilObject);
+
+LABEL_RBC_JUMP_ON_TRUE_TOP_NIL:
+    JUMP_IF_KEEP(value == load_ptr(trueObject), nilObject);
+
+LABEL_RBC_JUMP_ON_NOT_NIL_TOP_TOP:
+    JUMP_IF_KEEP(value != load_ptr(nilObject), regs[ip->src1]);
+
+LABEL_RBC_JUMP_ON_NIL_TOP_TOP:
+    JUMP_IF_KEEP(value == load_ptr(nilObject), regs[ip->src1]);
+
+LABEL_RBC_JUMP_IF_GREATER: {
+    vm_oop_t const top = REG(ip->src1);
+    vm_oop_t const top2 = REG(ip->src2);
+    if (IS_SMALL_INT(top) && IS_SMALL_INT(top2)) {
+        JUMP_IF(SMALL_INT_VAL(top) > SMALL_INT_VAL(top2));
+    }
+    JUMP_IF(IS_DOUBLE(top) && IS_DOUBLE(top2) &&
+            AS_DOUBLE(top) > AS_DOUBLE(top2));
+}
+
+LABEL_RBC_RETURN:
+    Interpreter::popFrameAndPushResult(REG(ip->src1));
+    return;
+
+LABEL_RBC_RETURN_FIELD:
+    Interpreter::popFrameAndPushResult(
+        static_cast<VMObject*>(REG(0))->GetField(ip->operand));
+    return;
+
+LABEL_RBC_EXIT:
+    SYNC(ip->top, ip->bytecodeIndex);
+    return;
+}
+
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+#ifdef USE_REGISTER_BYTECODES
+
+  #include "RegisterCode.h"
+
+/**
+ * Executes register bytecodes, see RegisterCode.
+ *
+ * The register interpreter works on the same frames as the stack
+ * interpreter, with the registers being the frame's slots. Integer
+ * arithmetic, comparisons, and control flow are executed directly on the
+ * registers. Everything else, e.g., sends and arithmetic on other types, is
+ * done by the stack interpreter's implementation of the original bytecode,
+ * after the operands were moved to where it expects them. Thus, collections
+ * happen at the same points as in the stack interpreter, and both can take
+ * over from each other at every entry of the register code.
+ *
+ * The register interpreter returns when the current frame changed, i.e., on
+ * sends to non-primitives and on returns. RegisterInterpreter::Run() then
+ * continues with the register code of the new method, if there is any, and
+ * otherwise returns to the stack interpreter.
+ */
+class RegisterInterpreter {
+public:
+    /// Executes register code as long as the current method has some.
+    static void Run();
+
+private:
+    static void execute(const RegisterCode* code,
+                        const RegisterInstruction* entry);
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include "SequenceProfile.h"
+
+#ifdef BYTECODE_SEQUENCE_PROFILE
+  #include <algorithm>
+  #include <cstddef>
+  #include <cstdint>
+  #include <fstream>
+  #include <string>
+  #include <tuple>
+  #include <vector>
+
+  #include "bytecodes.h"
+
+size_t SequenceProfile::pairs[FIRST_SUPERINSTRUCTION][FIRST_SUPERINSTRUCTION];
+size_t SequenceProfile::triples[FIRST_SUPERINSTRUCTION][FIRST_SUPERINSTRUCTION]
+                               [FIRST_SUPERINSTRUCTION];
+
+static uint8_t unquickened(uint8_t bc) {
+    uint8_t const base = Bytecode::GetBaseBytecode(bc);
+    return IsQuickenedBytecode(base) ? BC_SEND : base;
+}
+
+void SequenceProfile::Record(const uint8_t* bytecodes, size_t bytecodeIndex,
+                             size_t numberOfBytecodes) {
+    uint8_t const first = unquickened(bytecodes[bytecodeIndex]);
+    size_t const secondIndex =
+        bytecodeIndex + Bytecode::GetBytecodeLength(first);
+    if (secondIndex >= numberOfBytecodes) {
+        return;
+    }
+
+    uint8_t const second = unquickened(bytecodes[secondIndex]);
+    pairs[first][second] += 1;
+
+    size_t const thirdIndex = secondIndex + Bytecode::GetBytecodeLength(second);
+    if (thirdIndex >= numberOfBytecodes) {
+        return;
+    }
+
+    uint8_t const third = unquickened(bytecodes[thirdIndex]);
+    triples[first][second][third] += 1;
+}
+
+static std::string trimmedName(uint8_t bc) {
+    std::string name = Bytecode::GetBytecodeName(bc);
+    name.erase(name.find_last_not_of(' ') + 1);
+    return name;
+}
+
+void SequenceProfile::WriteCSV(const std::string& fileName) {
+    // count, first, second, third, with BC_INVALID as third for pairs
+    using Sequence = std::tuple<size_t, uint8_t, uint8_t, uint8_t>;
+    std::vector<Sequence> sequences;
+
+    for (uint8_t a = 0; a < FIRST_SUPERINSTRUCTION; a += 1) {
+        for (uint8_t b = 0; b < FIRST_SUPERINSTRUCTION; b += 1) {
+            if (pairs[a][b] != 0) {
+                sequences.emplace_back(pairs[a][b], a, b, BC_INVALID);
+            }
+            for (uint8_t c = 0; c < FIRST_SUPERINSTRUCTION; c += 1) {
+                if (triples[a][b][c] != 0) {
+                    sequences.emplace_back(triples[a][b][c], a, b, c);
+                }
+            }
+        }
+    }
+
+    std::sort(sequences.begin(), sequences.end(),
+              [](const Sequence& x, const Sequence& y) {
+                  return std::get<0>(x) > std::get<0>(y);
+              });
+
+    std::ofstream csv(fileName);
+    csv << "#count, first, second, third\n";
+    for (const Sequence& s : sequences) {
+        csv << std::get<0>(s) << ", " << trimmedName(std::get<1>(s)) << ", "
+            << trimmedName(std::get<2>(s));
+        if (std::get<3>(s) != BC_INVALID) {
+            csv << ", " << trimmedName(std::get<3>(s));
+        }
+        csv << "\n";
+    }
+}
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#ifdef BYTECODE_SEQUENCE_PROFILE
+  #include <cstddef>
+  #include <cstdint>
+  #include <string>
+
+  #include "bytecodes.h"
+
+/**
+ * Counts how often pairs and triples of bytecodes are executed.
+ *
+ * The counts are written to a CSV file on shutdown, from which
+ * scripts/generate_superinstructions.py selects the sequences that become
+ * superinstructions. Superinstructions are counted as their first bytecode,
+ * and quickened sends as BC_SEND, since this is what the compiler emits.
+ */
+class SequenceProfile {
+public:
+    /// Count the sequences starting at the given bytecode.
+    static void Record(const uint8_t* bytecodes, size_t bytecodeIndex,
+                       size_t numberOfBytecodes);
+
+    static void WriteCSV(const std::string& fileName);
+
+private:
+    static size_t pairs[FIRST_SUPERINSTRUCTION][FIRST_SUPERINSTRUCTION];
+    static size_t triples[FIRST_SUPERINSTRUCTION][FIRST_SUPERINSTRUCTION]
+                         [FIRST_SUPERINSTRUCTION];
+};
+
+  #define SEQUENCE_PROFILE_INC()                                  \
+      SequenceProfile::Record(currentBytecodes, bytecodeIndexGlobal, \
+                              method->GetNumberOfBytecodes())
+#else
+  #define SEQUENCE_PROFILE_INC() ((void)0)
+#endif
@@ -0,0 +1,54 @@
+#pragma once
+
+// Generated by scripts/generate_superinstructions.py, do not edit.
+//
+// Each superinstruction is a sequence of bytecodes, of which all but the last
+// are simple bytecodes, see CanPrecedeInSuperinstruction() in bytecodes.h.
+// It replaces only the first bytecode of the sequence. The others stay in
+// place, and the superinstruction has the length of its first bytecode.
+//
+// V(name, first, second) and V(name, first, second, third), without the BC_
+// prefix.
+
+// clang-format off
+#define BC_DUP_POP_LOCAL                            (FIRST_SUPERINSTRUCTION + 0)
+#define BC_DUP_POP_LOCAL_0                          (FIRST_SUPERINSTRUCTION + 1)
+#define BC_POP_INC                                  (FIRST_SUPERINSTRUCTION + 2)
+#define BC_POP_JUMP_BACKWARD                        (FIRST_SUPERINSTRUCTION + 3)
+#define BC_POP_LOCAL_0_POP                          (FIRST_SUPERINSTRUCTION + 4)
+#define BC_POP_LOCAL_1_PUSH_LOCAL_0                 (FIRST_SUPERINSTRUCTION + 5)
+#define BC_PUSH_CONSTANT_0_LT                       (FIRST_SUPERINSTRUCTION + 6)
+#define BC_PUSH_LOCAL_0_ADD                         (FIRST_SUPERINSTRUCTION + 7)
+#define BC_PUSH_LOCAL_0_INC                         (FIRST_SUPERINSTRUCTION + 8)
+#define BC_PUSH_LOCAL_0_PUSH_CONSTANT_0             (FIRST_SUPERINSTRUCTION + 9)
+#define BC_PUSH_LOCAL_1_PUSH_LOCAL_0                (FIRST_SUPERINSTRUCTION + 10)
+#define BC_DUP_POP_LOCAL_0_POP                      (FIRST_SUPERINSTRUCTION + 11)
+#define BC_POP_LOCAL_0_POP_JUMP_BACKWARD            (FIRST_SUPERINSTRUCTION + 12)
+#define BC_POP_LOCAL_1_PUSH_LOCAL_0_INC             (FIRST_SUPERINSTRUCTION + 13)
+#define BC_PUSH_LOCAL_0_PUSH_CONSTANT_0_LT          (FIRST_SUPERINSTRUCTION + 14)
+#define BC_PUSH_LOCAL_1_PUSH_LOCAL_0_ADD            (FIRST_SUPERINSTRUCTION + 15)
+
+#define NUM_SUPERINSTRUCTIONS 16
+
+#define SUPERINSTRUCTION_PAIRS(V) \
+    V(DUP_POP_LOCAL, DUP, POP_LOCAL) \
+    V(DUP_POP_LOCAL_0, DUP, POP_LOCAL_0) \
+    V(POP_INC, POP, INC) \
+    V(POP_JUMP_BACKWARD, POP, JUMP_BACKWARD) \
+    V(POP_LOCAL_0_POP, POP_LOCAL_0, POP) \
+    V(POP_LOCAL_1_PUSH_LOCAL_0, POP_LOCAL_1, PUSH_LOCAL_0) \
+    V(PUSH_CONSTANT_0_LT, PUSH_CONSTANT_0, LT) \
+    V(PUSH_LOCAL_0_ADD, PUSH_LOCAL_0, ADD) \
+    V(PUSH_LOCAL_0_INC, PUSH_LOCAL_0, INC) \
+    V(PUSH_LOCAL_0_PUSH_CONSTANT_0, PUSH_LOCAL_0, PUSH_CONSTANT_0) \
+    V(PUSH_LOCAL_1_PUSH_LOCAL_0, PUSH_LOCAL_1, PUSH_LOCAL_0) \
+    /* end */
+
+#define SUPERINSTRUCTION_TRIPLES(V) \
+    V(DUP_POP_LOCAL_0_POP, DUP, POP_LOCAL_0, POP) \
+    V(POP_LOCAL_0_POP_JUMP_BACKWARD, POP_LOCAL_0, POP, JUMP_BACKWARD) \
+    V(POP_LOCAL_1_PUSH_LOCAL_0_INC, POP_LOCAL_1, PUSH_LOCAL_0, INC) \
+    V(PUSH_LOCAL_0_PUSH_CONSTANT_0_LT, PUSH_LOCAL_0, PUSH_CONSTANT_0, LT) \
+    V(PUSH_LOCAL_1_PUSH_LOCAL_0_ADD, PUSH_LOCAL_1, PUSH_LOCAL_0, ADD) \
+    /* end */
+// clang-format on
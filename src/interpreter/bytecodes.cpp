@@ -29,78 +29,6 @@
 #include <cassert>
 #include <cstdint>
 
-const uint8_t Bytecode::bytecodeLengths[] = {
-    1,  // BC_HALT
-    1,  // BC_DUP
-    1,  // BC_DUP_SECOND
-    3,  // BC_PUSH_LOCAL
-    1,  // BC_PUSH_LOCAL_0
-    1,  // BC_PUSH_LOCAL_1
-    1,  // BC_PUSH_LOCAL_2
-    3,  // BC_PUSH_ARGUMENT
-    1,  // BC_PUSH_SELF
-    1,  // BC_PUSH_ARG_1
-    1,  // BC_PUSH_ARG_2
-    2,  // BC_PUSH_FIELD
-    1,  // BC_PUSH_FIELD_0
-    1,  // BC_PUSH_FIELD_1
-    2,  // BC_PUSH_BLOCK
-    2,  // BC_PUSH_CONSTANT
-    1,  // BC_PUSH_CONSTANT_0
-    1,  // BC_PUSH_CONSTANT_1
-    1,  // BC_PUSH_CONSTANT_2
-    1,  // BC_PUSH_0
-    1,  // BC_PUSH_1
-    1,  // BC_PUSH_NIL
-    2,  // BC_PUSH_GLOBAL
-    1,  // BC_POP
-    3,  // BC_POP_LOCAL
-    1,  // BC_POP_LOCAL_0
-    1,  // BC_POP_LOCAL_1
-    1,  // BC_POP_LOCAL_2
-    3,  // BC_POP_ARGUMENT
-    2,  // BC_POP_FIELD
-    1,  // BC_POP_FIELD_0
-    1,  // BC_POP_FIELD_1
-    2,  // BC_SEND
-    2,  // BC_SEND_1
-    2,  // BC_SUPER_SEND
-    1,  // BC_RETURN_LOCAL
-    1,  // BC_RETURN_NON_LOCAL
-    1,  // BC_RETURN_SELF
-    1,  // BC_RETURN_FIELD_0
-    1,  // BC_RETURN_FIELD_1
-    1,  // BC_RETURN_FIELD_2
-    1,  // BC_INC
-    1,  // BC_DEC
-    2,  // BC_INC_FIELD
-    2,  // BC_INC_FIELD_PUSH
-
-    3,  // BC_JUMP
-    3,  // BC_JUMP_ON_FALSE_POP
-    3,  // BC_JUMP_ON_TRUE_POP
-    3,  // BC_JUMP_ON_FALSE_TOP_NIL
-    3,  // BC_JUMP_ON_TRUE_TOP_NIL
-    3,  // BC_JUMP_ON_NOT_NIL_POP
-    3,  // BC_JUMP_ON_NIL_POP
-    3,  // BC_JUMP_ON_NOT_NIL_TOP_TOP
-    3,  // BC_JUMP_ON_NIL_TOP_TOP
-    3,  // BC_JUMP_IF_GREATER
-    3,  // BC_JUMP_BACKWARD
-
-    3,  // BC_JUMP2
-    3,  // BC_JUMP2_ON_FALSE_POP
-    3,  // BC_JUMP2_ON_TRUE_POP
-    3,  // BC_JUMP2_ON_FALSE_TOP_NIL
-    3,  // BC_JUMP2_ON_TRUE_TOP_NIL
-    3,  // BC_JUMP2_ON_NOT_NIL_POP
-    3,  // BC_JUMP2_ON_NIL_POP
-    3,  // BC_JUMP2_ON_NOT_NIL_TOP_TOP
-    3,  // BC_JUMP2_ON_NIL_TOP_TOP
-    3,  // BC_JUMP2_IF_GREATER
-    3,  // BC_JUMP2_BACKWARD
-};
-
 const char* Bytecode::bytecodeNames[] = {
     "HALT            ",          // 0
     "DUP             ",          // 1
@@ -169,6 +97,26 @@ const char* Bytecode::bytecodeNames[] = {
     "JUMP2_ON_NIL_TOP_TOP",      // 64
     "JUMP2_IF_GREATER",          // 65
     "JUMP2_BACKWARD  ",          // 66
+    "ADD             ",          // 67
+    "SUB             ",          // 68
+    "MUL             ",          // 69
+    "LT              ",          // 70
+    "GT              ",          // 71
+    "LE              ",          // 72
+    "GE              ",          // 73
+    "EQ              ",          // 74
+    "EQ_EQ           ",          // 75
+    "DIV_DOUBLE      ",          // 76
+    "AT_ARRAY        ",          // 77
+    "AT_PUT_ARRAY    ",          // 78
+    "INST_VAR_NAMED  ",          // 79
+
+#define SUPERINSTRUCTION_NAME_OF_PAIR(name, first, second) #name,
+#define SUPERINSTRUCTION_NAME_OF_TRIPLE(name, first, second, third) #name,
+    SUPERINSTRUCTION_PAIRS(SUPERINSTRUCTION_NAME_OF_PAIR)
+    SUPERINSTRUCTION_TRIPLES(SUPERINSTRUCTION_NAME_OF_TRIPLE)
+#undef SUPERINSTRUCTION_NAME_OF_PAIR
+#undef SUPERINSTRUCTION_NAME_OF_TRIPLE
 };
 
 bool IsJumpBytecode(uint8_t bc) {
@@ -266,10 +214,19 @@ uint8_t IsPopSmthBytecode(uint8_t bc) {
 bool Bytecode::BytecodeDefinitionsAreConsistent() {
     bool const namesAndLengthMatch =
         (sizeof(Bytecode::bytecodeNames) / sizeof(char*)) ==
-        (sizeof(Bytecode::bytecodeLengths) / sizeof(uint8_t));
+        (sizeof(Bytecode::bytecodeLengths) / sizeof(uint8_t)) +
+            NUM_SUPERINSTRUCTIONS;
     bool const lastBytecodeLinesUp =
         _LAST_BYTECODE ==
-        (sizeof(Bytecode::bytecodeLengths) - 1);  // -1 because null terminated
+        (sizeof(Bytecode::bytecodeNames) / sizeof(char*)) - 1;
+
+    bool superinstructionsAreValid = true;
+    for (uint8_t bc = FIRST_SUPERINSTRUCTION; bc <= _LAST_BYTECODE; bc += 1) {
+        superinstructionsAreValid =
+            superinstructionsAreValid &&
+            CanPrecedeInSuperinstruction(GetBaseBytecode(bc));
+    }
 
-    return namesAndLengthMatch && lastBytecodeLinesUp;
+    return namesAndLengthMatch && lastBytecodeLinesUp &&
+           superinstructionsAreValid;
 }
@@ -27,8 +27,11 @@
  */
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 
 #include "../misc/defs.h"
+#include "Superinstructions.h"
 
 // bytecode constants used by SOM++
 
@@ -101,11 +104,37 @@
 #define BC_JUMP2_IF_GREATER       65
 #define BC_JUMP2_BACKWARD         66
 
-#define _LAST_BYTECODE BC_JUMP2_BACKWARD
+// binary operations, the compiler emits them instead of BC_SEND for the
+// corresponding selectors. The interpreter handles integers and doubles
+// directly, and otherwise sends the selector, for which they keep its literal
+// index.
+#define BC_ADD                    67
+#define BC_SUB                    68
+#define BC_MUL                    69
+#define BC_LT                     70
+#define BC_GT                     71
+#define BC_LE                     72
+#define BC_GE                     73
+#define BC_EQ                     74
+#define BC_EQ_EQ                  75
+
+// quickened bytecodes, the interpreter rewrites BC_SEND into these once it
+// observed the operand types. They keep the literal index of the selector to
+// be able to fall back to a normal send.
+#define BC_DIV_DOUBLE             76
+#define BC_AT_ARRAY               77
+#define BC_AT_PUT_ARRAY           78
+#define BC_INST_VAR_NAMED         79
+
+// superinstructions, fused sequences of the bytecodes above. They are
+// generated from a profile, see Superinstructions.h
+#define FIRST_SUPERINSTRUCTION    80
 
 #define BC_INVALID           255
 // clang-format on
 
+#define _LAST_BYTECODE (FIRST_SUPERINSTRUCTION + NUM_SUPERINSTRUCTIONS - 1)
+
 // TODO(smarr): port support for these bytecodes
 //       they were already named in ported code, and it seemed nicer to just
 //       already include that code
@@ -126,14 +155,125 @@ public:
         return (char*)bytecodeNames[bc];
     }
 
-    inline static uint8_t GetBytecodeLength(uint8_t bc) {
-        return bytecodeLengths[bc];  // Return the length of the given bytecode
+    constexpr static uint8_t GetBytecodeLength(uint8_t bc) {
+        // Return the length of the given bytecode
+        return bytecodeLengths[GetBaseBytecode(bc)];
+    }
+
+    /// Returns the first bytecode of a superinstruction, and the bytecode
+    /// itself otherwise. A superinstruction replaces only the first bytecode
+    /// of the fused sequence, all others remain in place. Thus, code that
+    /// analyzes bytecodes can treat it as its first bytecode.
+    constexpr static uint8_t GetBaseBytecode(uint8_t bc) {
+        if (bc >= FIRST_SUPERINSTRUCTION && bc <= _LAST_BYTECODE) {
+            return superinstructionFirstBytecodes[bc - FIRST_SUPERINSTRUCTION];
+        }
+        return bc;
     }
 
     static bool BytecodeDefinitionsAreConsistent();
 
 private:
-    static const uint8_t bytecodeLengths[];
+    // superinstructions have the length of their first bytecode, and are not
+    // listed here
+    constexpr static uint8_t bytecodeLengths[] = {
+        1,  // BC_HALT
+        1,  // BC_DUP
+        1,  // BC_DUP_SECOND
+        3,  // BC_PUSH_LOCAL
+        1,  // BC_PUSH_LOCAL_0
+        1,  // BC_PUSH_LOCAL_1
+        1,  // BC_PUSH_LOCAL_2
+        3,  // BC_PUSH_ARGUMENT
+        1,  // BC_PUSH_SELF
+        1,  // BC_PUSH_ARG_1
+        1,  // BC_PUSH_ARG_2
+        2,  // BC_PUSH_FIELD
+        1,  // BC_PUSH_FIELD_0
+        1,  // BC_PUSH_FIELD_1
+        2,  // BC_PUSH_BLOCK
+        2,  // BC_PUSH_CONSTANT
+        1,  // BC_PUSH_CONSTANT_0
+        1,  // BC_PUSH_CONSTANT_1
+        1,  // BC_PUSH_CONSTANT_2
+        1,  // BC_PUSH_0
+        1,  // BC_PUSH_1
+        1,  // BC_PUSH_NIL
+        2,  // BC_PUSH_GLOBAL
+        1,  // BC_POP
+        3,  // BC_POP_LOCAL
+        1,  // BC_POP_LOCAL_0
+        1,  // BC_POP_LOCAL_1
+        1,  // BC_POP_LOCAL_2
+        3,  // BC_POP_ARGUMENT
+        2,  // BC_POP_FIELD
+        1,  // BC_POP_FIELD_0
+        1,  // BC_POP_FIELD_1
+        2,  // BC_SEND
+        2,  // BC_SEND_1
+        2,  // BC_SUPER_SEND
+        1,  // BC_RETURN_LOCAL
+        1,  // BC_RETURN_NON_LOCAL
+        1,  // BC_RETURN_SELF
+        1,  // BC_RETURN_FIELD_0
+        1,  // BC_RETURN_FIELD_1
+        1,  // BC_RETURN_FIELD_2
+        1,  // BC_INC
+        1,  // BC_DEC
+        2,  // BC_INC_FIELD
+        2,  // BC_INC_FIELD_PUSH
+
+        3,  // BC_JUMP
+        3,  // BC_JUMP_ON_FALSE_POP
+        3,  // BC_JUMP_ON_TRUE_POP
+        3,  // BC_JUMP_ON_FALSE_TOP_NIL
+        3,  // BC_JUMP_ON_TRUE_TOP_NIL
+        3,  // BC_JUMP_ON_NOT_NIL_POP
+        3,  // BC_JUMP_ON_NIL_POP
+        3,  // BC_JUMP_ON_NOT_NIL_TOP_TOP
+        3,  // BC_JUMP_ON_NIL_TOP_TOP
+        3,  // BC_JUMP_IF_GREATER
+        3,  // BC_JUMP_BACKWARD
+
+        3,  // BC_JUMP2
+        3,  // BC_JUMP2_ON_FALSE_POP
+        3,  // BC_JUMP2_ON_TRUE_POP
+        3,  // BC_JUMP2_ON_FALSE_TOP_NIL
+        3,  // BC_JUMP2_ON_TRUE_TOP_NIL
+        3,  // BC_JUMP2_ON_NOT_NIL_POP
+        3,  // BC_JUMP2_ON_NIL_POP
+        3,  // BC_JUMP2_ON_NOT_NIL_TOP_TOP
+        3,  // BC_JUMP2_ON_NIL_TOP_TOP
+        3,  // BC_JUMP2_IF_GREATER
+        3,  // BC_JUMP2_BACKWARD
+
+        2,  // BC_ADD
+        2,  // BC_SUB
+        2,  // BC_MUL
+        2,  // BC_LT
+        2,  // BC_GT
+        2,  // BC_LE
+        2,  // BC_GE
+        2,  // BC_EQ
+        2,  // BC_EQ_EQ
+
+        2,  // BC_DIV_DOUBLE
+        2,  // BC_AT_ARRAY
+        2,  // BC_AT_PUT_ARRAY
+        2,  // BC_INST_VAR_NAMED
+    };
+
+    // clang-format off
+#define SUPERINSTRUCTION_FIRST_OF_PAIR(name, first, second) BC_##first,
+#define SUPERINSTRUCTION_FIRST_OF_TRIPLE(name, first, second, third) BC_##first,
+    constexpr static uint8_t superinstructionFirstBytecodes[] = {
+        SUPERINSTRUCTION_PAIRS(SUPERINSTRUCTION_FIRST_OF_PAIR)
+        SUPERINSTRUCTION_TRIPLES(SUPERINSTRUCTION_FIRST_OF_TRIPLE)
+        BC_INVALID  // keeps the array non-empty
+    };
+#undef SUPERINSTRUCTION_FIRST_OF_PAIR
+#undef SUPERINSTRUCTION_FIRST_OF_TRIPLE
+    // clang-format on
 
     static const char* bytecodeNames[];
 };
@@ -142,6 +282,23 @@ inline uint16_t ComputeOffset(uint8_t byte1, uint8_t byte2) {
     return ((uint16_t)byte1) | (uint16_t)(((uint16_t)byte2) << 8U);
 }
 
+/// Returns the index of the bytecode the jump at the given index jumps to.
+inline size_t GetJumpTarget(const uint8_t* bytecodes, size_t bytecodeIndex) {
+    uint8_t const bc = bytecodes[bytecodeIndex];
+    size_t offset = 0;
+    if (bc < FIRST_DOUBLE_BYTE_JUMP_BYTECODE) {
+        offset = bytecodes[bytecodeIndex + 1];
+    } else {
+        offset = ComputeOffset(bytecodes[bytecodeIndex + 1],
+                               bytecodes[bytecodeIndex + 2]);
+    }
+
+    if (bc == BC_JUMP_BACKWARD || bc == BC_JUMP2_BACKWARD) {
+        return bytecodeIndex - offset;
+    }
+    return bytecodeIndex + offset;
+}
+
 bool IsJumpBytecode(uint8_t bc);
 uint8_t IsPushConstBytecode(uint8_t bc);
 uint8_t IsPushFieldBytecode(uint8_t bc);
@@ -149,3 +306,85 @@ uint8_t IsPushArgBytecode(uint8_t bc);
 uint8_t IsPopFieldBytecode(uint8_t bc);
 uint8_t IsPopSmthBytecode(uint8_t bc);
 uint8_t IsReturnFieldBytecode(uint8_t bc);
+
+inline bool IsBinaryOperationBytecode(uint8_t bc) {
+    return bc >= BC_ADD && bc <= BC_EQ_EQ;
+}
+
+inline bool IsQuickenedBytecode(uint8_t bc) {
+    return bc >= BC_DIV_DOUBLE && bc <= BC_INST_VAR_NAMED;
+}
+
+constexpr bool IsSuperinstruction(uint8_t bc) {
+    return bc >= FIRST_SUPERINSTRUCTION && bc <= _LAST_BYTECODE;
+}
+
+/// Bytecodes that can be part of a superinstruction, except as its last
+/// bytecode. They neither send, nor jump, nor change the frame, and thus
+/// execution can continue with the next bytecode of the sequence directly.
+/// BC_INC is excluded, because without tagging it allocates and needs to
+/// reach a GC point.
+constexpr bool CanPrecedeInSuperinstruction(uint8_t bc) {
+    switch (bc) {
+        case BC_DUP:
+        case BC_DUP_SECOND:
+        case BC_PUSH_LOCAL:
+        case BC_PUSH_LOCAL_0:
+        case BC_PUSH_LOCAL_1:
+        case BC_PUSH_LOCAL_2:
+        case BC_PUSH_ARGUMENT:
+        case BC_PUSH_SELF:
+        case BC_PUSH_ARG_1:
+        case BC_PUSH_ARG_2:
+        case BC_PUSH_FIELD:
+        case BC_PUSH_FIELD_0:
+        case BC_PUSH_FIELD_1:
+        case BC_PUSH_CONSTANT:
+        case BC_PUSH_CONSTANT_0:
+        case BC_PUSH_CONSTANT_1:
+        case BC_PUSH_CONSTANT_2:
+        case BC_PUSH_0:
+        case BC_PUSH_1:
+        case BC_PUSH_NIL:
+        case BC_POP:
+        case BC_POP_LOCAL:
+        case BC_POP_LOCAL_0:
+        case BC_POP_LOCAL_1:
+        case BC_POP_LOCAL_2:
+        case BC_POP_ARGUMENT:
+        case BC_POP_FIELD:
+        case BC_POP_FIELD_0:
+        case BC_POP_FIELD_1:
+        case BC_DEC:
+        case BC_INC_FIELD:
+        case BC_INC_FIELD_PUSH:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/// Returns the superinstruction for the given sequence, preferring triples, or
+/// BC_INVALID if there is none. For a pair, the third bytecode is ignored.
+constexpr uint8_t GetSuperinstruction(uint8_t first, uint8_t second,
+                                      uint8_t third) {
+    // clang-format off
+#define SUPERINSTRUCTION_MATCH_TRIPLE(name, a, b, c)              \
+    if (first == BC_##a && second == BC_##b && third == BC_##c) { \
+        return BC_##name;                                         \
+    }
+#define SUPERINSTRUCTION_MATCH_PAIR(name, a, b)   \
+    if (first == BC_##a && second == BC_##b) {    \
+        return BC_##name;                         \
+    }
+    SUPERINSTRUCTION_TRIPLES(SUPERINSTRUCTION_MATCH_TRIPLE)
+    SUPERINSTRUCTION_PAIRS(SUPERINSTRUCTION_MATCH_PAIR)
+#undef SUPERINSTRUCTION_MATCH_TRIPLE
+#undef SUPERINSTRUCTION_MATCH_PAIR
+    // clang-format on
+    (void)first;
+    (void)second;
+    (void)third;
+    return BC_INVALID;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../misc/defs.h"
+
+class AbstractVMObject;
+
+// the bytes a heap hands out at once, unless an object needs more
+#define ALLOCATION_BUFFER_SIZE ((size_t)32 * 1024U)  // 32 KB
+
+/**
+ * A thread-local allocation buffer (TLAB), i.e., a region of a bump-pointer
+ * heap from which only one thread allocates, without further checks or
+ * synchronization.
+ *
+ * The COPYING heap and the nursery of the GENERATIONAL heap hand out such
+ * regions when a buffer is exhausted, and request a collection once a region
+ * crosses their collection limit. Before a collection, and whenever a new
+ * region is needed, the heap retires the buffer, which returns its unused
+ * end to the heap, so that the allocated objects stay contiguous.
+ */
+struct AllocationBuffer {
+    uint8_t* top;
+    uint8_t* end;
+
+    /// Returns nullptr if the object does not fit.
+    inline AbstractVMObject* TryAllocate(size_t size) {
+        if (likely(size <= (size_t)(end - top))) {
+            auto* newObject = (AbstractVMObject*)top;
+            top += size;
+            return newObject;
+        }
+        return nullptr;
+    }
+
+    inline void Reset() {
+        top = nullptr;
+        end = nullptr;
+    }
+};
+
+// the buffer of the interpreter's thread
+inline thread_local AllocationBuffer threadAllocationBuffer{nullptr, nullptr};
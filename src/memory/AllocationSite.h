@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// a site is only judged once it allocated this many objects in the nursery
+#define PRETENURING_MIN_ALLOCATIONS 100U
+
+// the percentage of these objects that needs to survive their first minor
+// collection, for the site to allocate mature objects from then on
+#define PRETENURING_SURVIVAL_PERCENT 90U
+
+/**
+ * The survival statistics of the objects instantiated by one send site, i.e.,
+ * a send of #new from a particular method and bytecode index. It is kept with
+ * the site's inline cache.
+ *
+ * The GENERATIONAL heap records which nursery objects were allocated by which
+ * site, and counts after each minor collection how many of them were copied.
+ * Since each survivor is promoted, a site whose objects almost all survive
+ * is switched to allocate them directly as mature objects, which avoids
+ * copying them, and tracking them with the write barrier in between. This is
+ * not undone, since mature objects are not tracked by their site.
+ */
+struct AllocationSite {
+    uint32_t allocated{0};
+    uint32_t survived{0};
+    bool pretenure{false};
+};
@@ -1,10 +1,12 @@
 #include "CopyingCollector.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
 
 #include "../memory/Heap.h"
 #include "../misc/debug.h"
@@ -15,7 +17,13 @@
 #include "../vmobjects/IntegerBox.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMFrame.h"
+#include "../vmobjects/VMMethod.h"
+#include "AllocationBuffer.h"
 #include "CopyingHeap.h"
+#include "LargeObjectSpace.h"
+
+// marked large objects, of which the references still need to be copied
+static vector<AbstractVMObject*> largeObjectsToWalk;
 
 static gc_oop_t copy_if_necessary(gc_oop_t oop) {
     // don't process tagged objects
@@ -26,6 +34,17 @@ static gc_oop_t copy_if_necessary(gc_oop_t oop) {
     AbstractVMObject* obj = AS_OBJ(oop);
     assert(IsValidObject(obj));
 
+    // the objects outside of the semispace are in the large-object space,
+    // and are marked instead of being copied. They are marked as old, which,
+    // as in the GENERATIONAL heap, tells them apart from forwarded objects.
+    if (!GetHeap<CopyingHeap>()->IsInOldBuffer(obj)) {
+        if (obj->GetGCField() == 0) {
+            obj->SetGCField(MASK_OBJECT_IS_OLD);
+            largeObjectsToWalk.push_back(obj);
+        }
+        return oop;
+    }
+
     size_t const gcField = obj->GetGCField();
     // GCField is used as forwarding pointer here
     // if someone has moved before, return the moved object
@@ -49,6 +68,21 @@ static gc_oop_t copy_if_necessary(gc_oop_t oop) {
     return tmp_ptr(newObj);
 }
 
+static AbstractVMObject* survivor(AbstractVMObject* obj) {
+    if (!GetHeap<CopyingHeap>()->IsInOldBuffer(obj)) {
+        return obj->GetGCField() == MASK_OBJECT_IS_OLD ? obj : nullptr;
+    }
+    return (AbstractVMObject*)obj->GetGCField();
+}
+
+static bool sweep_large_object(AbstractVMObject* obj) {
+    if (obj->GetGCField() == MASK_OBJECT_IS_OLD) {
+        obj->SetGCField(0);
+        return true;
+    }
+    return false;
+}
+
 void CopyingCollector::Collect() {
     DebugLog("CopyGC Collect\n");
 
@@ -56,29 +90,45 @@ void CopyingCollector::Collect() {
     // reset collection trigger
     heap->resetGCTrigger();
 
-    static bool increaseMemory;
-    heap->switchBuffers(increaseMemory);
-    increaseMemory = false;
+    heap->retireAllocationBuffer();
+    heap->switchBuffers(heap->nextBufferSize);
+    heap->largeObjects.StartMarking();
 
     Universe::WalkGlobals(copy_if_necessary);
 
     // now copy all objects that are referenced by the objects we have moved so
-    // far
+    // far. They are copied into the allocation buffer, which keeps them
+    // contiguous, also when it is refilled.
     auto* curObject = (AbstractVMObject*)(heap->currentBuffer);
-    while (curObject < heap->nextFreePosition) {
-        curObject->WalkObjects(copy_if_necessary);
-        curObject =
-            (AbstractVMObject*)((size_t)curObject + curObject->GetObjectSize());
+    while (true) {
+        while ((uint8_t*)curObject < threadAllocationBuffer.top) {
+            curObject->WalkObjects(copy_if_necessary);
+            curObject = (AbstractVMObject*)((size_t)curObject +
+                                            curObject->GetObjectSize());
+        }
+
+        if (largeObjectsToWalk.empty()) {
+            break;
+        }
+        AbstractVMObject* obj = largeObjectsToWalk.back();
+        largeObjectsToWalk.pop_back();
+        obj->WalkObjects(copy_if_necessary);
     }
 
+    heap->retireAllocationBuffer();
+    VMMethod::SweepNativeMemory(&survivor, false);
     heap->invalidateOldBuffer();
 
-    // if semispace is still 50% full after collection, we have to realloc
-    // bigger ones -> done in next collection
-    if ((size_t)(heap->nextFreePosition) - (size_t)(heap->currentBuffer) >=
-        (size_t)(heap->currentBufferEnd) - (size_t)(heap->nextFreePosition)) {
-        increaseMemory = true;
-    }
+    heap->largeObjects.Sweep(&sweep_large_object);
+    heap->largeObjectsLimit =
+        max(2 * heap->largeObjects.GetSize(),
+            (size_t)heap->currentBufferEnd - (size_t)heap->currentBuffer);
+
+    // the buffers are resized with the next collection, based on the objects
+    // that survived this one
+    heap->nextBufferSize = heap->sizingPolicy.NextHeapSize(
+        (size_t)heap->nextFreePosition - (size_t)heap->currentBuffer);
 
     Timer::GCTimer.Halt();
+    heap->sizingPolicy.RecordCollection();
 }
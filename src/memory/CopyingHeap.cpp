@@ -1,10 +1,16 @@
 #include "CopyingHeap.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <string>
 
+#ifdef __GLIBC__
+  #include <malloc.h>
+#endif
+
 #include "../misc/defs.h"
 #include "../vm/Print.h"
 #include "../vmobjects/AbstractObject.h"
@@ -19,96 +25,111 @@ CopyingHeap::CopyingHeap(size_t objectSpaceSize)
       collectionLimit((void*)((size_t)currentBuffer +
                               ((size_t)((double)objectSpaceSize * 0.9)))),
       oldBufferEnd((void*)((size_t)oldBuffer + objectSpaceSize)),
-      nextFreePosition(currentBuffer) {
+      nextFreePosition(currentBuffer), largeObjectsLimit(objectSpaceSize),
+      sizingPolicy(objectSpaceSize), nextBufferSize(objectSpaceSize) {
     memset(currentBuffer, 0x0, objectSpaceSize);
     memset(oldBuffer, 0x0, objectSpaceSize);
+    threadAllocationBuffer.Reset();
 }
 
-void CopyingHeap::switchBuffers(bool increaseMemory) {
-    size_t const oldBufSizeBeforeSwitch =
-        (size_t)oldBufferEnd - (size_t)oldBuffer;
+void CopyingHeap::switchBuffers(size_t newSize) {
+    // all objects of the current buffer might survive
+    newSize =
+        max(newSize, (size_t)nextFreePosition - (size_t)currentBuffer);
 
-    void* oldBufferBeforeSwitch = oldBuffer;
-    void* oldBufferEndBeforeSwitch = oldBufferEnd;
+    void* freeBuffer = oldBuffer;
+    size_t const freeBufSize = (size_t)oldBufferEnd - (size_t)oldBuffer;
 
     // make current buffer the old one
     oldBuffer = currentBuffer;
     oldBufferEnd = currentBufferEnd;
     oldBufferIsValid = true;
 
-    size_t currentBufSize = 0;
-    if (increaseMemory) {
-        // increase memory if scheduled in collection before
-        free(oldBufferBeforeSwitch);
-        oldBufferEndBeforeSwitch = nullptr;
-
-        size_t const newSize = oldBufSizeBeforeSwitch * 2;
+    // the buffer is only shrunk once it is less than half used, so that it is
+    // not reallocated on each collection
+    if (newSize > freeBufSize || newSize < freeBufSize / 2) {
+        free(freeBuffer);
         currentBuffer = malloc(newSize);
 
         if (currentBuffer == nullptr) {
             ErrorExit("unable to allocate heap memory");
         }
-
-        currentBufferEnd = (void*)((size_t)currentBuffer + newSize);
-        collectionLimit =
-            (void*)((size_t)currentBuffer + ((size_t)((double)newSize * 0.9)));
-        nextFreePosition = currentBuffer;
-        currentBufSize = newSize;
+#ifdef __GLIBC__
+        // the freed buffer may not be mapped by malloc() on its own, its
+        // memory is only given back to the system when asked for
+        if (newSize < freeBufSize) {
+            malloc_trim(0);
+        }
+#endif
     } else {
-        currentBuffer = oldBufferBeforeSwitch;
-        currentBufferEnd = oldBufferEndBeforeSwitch;
-        currentBufSize = oldBufSizeBeforeSwitch;
-
-        collectionLimit =
-            (void*)((size_t)oldBufferBeforeSwitch +
-                    (size_t)((double)oldBufSizeBeforeSwitch * 0.9));
-        nextFreePosition = currentBuffer;
+        currentBuffer = freeBuffer;
+        newSize = freeBufSize;
     }
 
+    currentBufferEnd = (void*)((size_t)currentBuffer + newSize);
+    collectionLimit =
+        (void*)((size_t)currentBuffer + ((size_t)((double)newSize * 0.9)));
+    nextFreePosition = currentBuffer;
+
     // init currentBuffer with zeros
-    memset(currentBuffer, 0x0, currentBufSize);
+    memset(currentBuffer, 0x0, newSize);
 }
 
 void CopyingHeap::invalidateOldBuffer() {
     oldBufferIsValid = false;
 
-    size_t const currentBufSize =
-        (size_t)currentBufferEnd - (size_t)currentBuffer;
-    size_t const oldBufSize = (size_t)oldBufferEnd - (size_t)oldBuffer;
-
     if (DEBUG) {
-        memset(oldBuffer, 0xFF, oldBufSize);
+        memset(oldBuffer, 0xFF, (size_t)oldBufferEnd - (size_t)oldBuffer);
     }
+}
 
-    if (currentBufSize > oldBufSize) {
-        free(oldBuffer);
-
-        oldBuffer = malloc(currentBufSize);
-
-        if (oldBuffer == nullptr) {
-            ErrorExit("unable to allocate heap memory");
-        }
-
-        oldBufferEnd = (void*)((size_t)oldBuffer + currentBufSize);
+AbstractVMObject* CopyingHeap::refillAllocationBuffer(size_t size) {
+    if (size > LargeObjectSpace::Threshold) {
+        return allocateLarge(size);
     }
-}
 
-AbstractVMObject* CopyingHeap::AllocateObject(size_t size) {
-    auto* newObject = (AbstractVMObject*)nextFreePosition;
-    nextFreePosition = (void*)((size_t)nextFreePosition + size);
-    if (nextFreePosition > currentBufferEnd) {
+    retireAllocationBuffer();
+
+    auto* start = (uint8_t*)nextFreePosition;
+    if ((size_t)start + size > (size_t)currentBufferEnd) {
         ErrorPrint("\nFailed to allocate " + to_string(size) + " Bytes.\n");
         Quit(-1);
     }
 
+    // the buffer is not bigger than the threshold, so that large objects
+    // always take the slow path
+    size_t const bufferSize =
+        max(size, min(ALLOCATION_BUFFER_SIZE, LargeObjectSpace::Threshold));
+    nextFreePosition =
+        (void*)min((size_t)start + bufferSize, (size_t)currentBufferEnd);
+
     // let's see if we have to trigger the GC
     if (nextFreePosition > collectionLimit) {
         requestGC();
     }
 
+    threadAllocationBuffer.top = start;
+    threadAllocationBuffer.end = (uint8_t*)nextFreePosition;
+    return threadAllocationBuffer.TryAllocate(size);
+}
+
+AbstractVMObject* CopyingHeap::allocateLarge(size_t size) {
+    AbstractVMObject* newObject = largeObjects.Allocate(size);
+    if (largeObjects.GetSize() > largeObjectsLimit) {
+        requestGC();
+    }
     return newObject;
 }
 
+void CopyingHeap::retireAllocationBuffer() {
+    // the buffer is the last region that was handed out, its unused end can
+    // be handed out again
+    if (threadAllocationBuffer.end == (uint8_t*)nextFreePosition) {
+        nextFreePosition = threadAllocationBuffer.top;
+    }
+    threadAllocationBuffer.Reset();
+}
+
 bool CopyingHeap::IsInCurrentBuffer(AbstractVMObject* obj) {
     if (obj == nullptr) {
         return true;
@@ -2,20 +2,41 @@
 
 #include <cstring>
 
+#include "AllocationBuffer.h"
 #include "Heap.h"
+#include "HeapSizingPolicy.h"
+#include "LargeObjectSpace.h"
 
 class CopyingHeap : public Heap<CopyingHeap> {
     friend class CopyingCollector;
 
 public:
     explicit CopyingHeap(size_t objectSpaceSize);
-    AbstractVMObject* AllocateObject(size_t size);
+
+    inline AbstractVMObject* AllocateObject(size_t size) {
+        AbstractVMObject* newObject = threadAllocationBuffer.TryAllocate(size);
+        if (likely(newObject != nullptr)) {
+            return newObject;
+        }
+        return refillAllocationBuffer(size);
+    }
 
     bool IsInCurrentBuffer(AbstractVMObject* obj);
     bool IsInOldBufferAndOldBufferIsValid(AbstractVMObject* obj);
 
+    inline bool IsInOldBuffer(AbstractVMObject* obj) const {
+        return (size_t)oldBuffer <= (size_t)obj &&
+               (size_t)obj < (size_t)oldBufferEnd;
+    }
+
 private:
-    void switchBuffers(bool increaseMemory);
+    AbstractVMObject* refillAllocationBuffer(size_t size);
+    AbstractVMObject* allocateLarge(size_t size);
+    void retireAllocationBuffer();
+
+    /// Makes the old buffer the current one, with the given size, or bigger
+    /// if the objects of the current buffer need more.
+    void switchBuffers(size_t newSize);
     void invalidateOldBuffer();
 
     void* currentBuffer;
@@ -25,6 +46,16 @@ private:
     void* oldBuffer;
     void* oldBufferEnd;
 
+    // the end of the memory handed out to the allocation buffer
     void* nextFreePosition;
     bool oldBufferIsValid{false};
+
+    // large objects are not copied, and request a collection on their own,
+    // once they grow beyond the limit
+    LargeObjectSpace largeObjects;
+    size_t largeObjectsLimit;
+
+    // the size of the buffer after the next collection
+    HeapSizingPolicy sizingPolicy;
+    size_t nextBufferSize;
 };
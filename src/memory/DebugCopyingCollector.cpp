@@ -12,6 +12,7 @@
 #include "../vm/IsValidObject.h"
 #include "../vm/Universe.h"
 #include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMMethod.h"
 #include "DebugCopyingHeap.h"
 
 static gc_oop_t copy_if_necessary(gc_oop_t oop) {
@@ -46,6 +47,10 @@ static gc_oop_t copy_if_necessary(gc_oop_t oop) {
     return tmp_ptr(newObj);
 }
 
+static AbstractVMObject* survivor(AbstractVMObject* obj) {
+    return (AbstractVMObject*)obj->GetGCField();
+}
+
 void DebugCopyingCollector::Collect() {
     DebugLog("DebugCopyGC Collect\n");
 
@@ -68,6 +73,7 @@ void DebugCopyingCollector::Collect() {
         heap->currentHeap.at(i)->WalkObjects(copy_if_necessary);
     }
 
+    VMMethod::SweepNativeMemory(&survivor, false);
     heap->invalidateOldBuffer();
 
     // if semispace is still 50% full after collection, we have to realloc
@@ -0,0 +1,86 @@
+#include "FrameStack.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "../misc/defs.h"
+#include "../vm/LogAllocation.h"
+#include "../vm/Print.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMFrame.h"
+#include "../vmobjects/VMMethod.h"
+#include "../vmobjects/VMObject.h"
+#include "Heap.h"
+
+uint8_t* FrameStack::base = nullptr;
+uint8_t* FrameStack::top = nullptr;
+uint8_t* FrameStack::end = nullptr;
+
+void FrameStack::Initialize(size_t size) {
+    base = (uint8_t*)malloc(size);
+    if (base == nullptr) {
+        ErrorExit("unable to allocate frame stack");
+    }
+    top = base;
+    end = base + size;
+}
+
+void FrameStack::Destroy() {
+    free(base);
+    base = nullptr;
+    top = nullptr;
+    end = nullptr;
+}
+
+VMFrame* FrameStack::NewFrame(VMFrame* previousFrame, VMMethod* method) {
+    size_t const length = method->GetNumberOfArguments() +
+                          method->GetNumberOfLocals() +
+                          method->GetMaximumNumberOfStackElements();
+
+    size_t const additionalBytes = length * sizeof(VMObject*);
+    size_t const totalSize = sizeof(VMFrame) + additionalBytes;
+
+    if (unlikely((size_t)(end - top) < totalSize)) {
+        return nullptr;
+    }
+
+    // frames on the stack are not heap objects, and thus, are not allocated
+    // with the operator new of AbstractVMObject
+    auto* result = ::new (top) VMFrame(additionalBytes, method, previousFrame);
+    top += totalSize;
+    return result;
+}
+
+VMFrame* FrameStack::Promote(const VMFrame* frame) {
+    assert(Contains(frame));
+
+    size_t const additionalBytes = frame->GetObjectSize() - sizeof(VMFrame);
+    auto* result =
+        new (GetHeap<HEAP_CLS>(), additionalBytes) VMFrame(*frame);
+    memcpy(SHIFTED_PTR(result, sizeof(VMFrame)),
+           SHIFTED_PTR(frame, sizeof(VMFrame)), additionalBytes);
+
+    result->arguments = (gc_oop_t*)&(result->stack_ptr) + 1;
+    result->locals = (gc_oop_t*)SHIFTED_PTR(
+        result, (size_t)frame->locals - (size_t)frame);
+    result->stack_ptr = (gc_oop_t*)SHIFTED_PTR(
+        result, (size_t)frame->stack_ptr - (size_t)frame);
+
+    LOG_ALLOCATION("VMFrame", result->GetObjectSize());
+
+    // the frame is the topmost one, everything above it is dead already
+    Release(frame);
+    return result;
+}
+
+void FrameStack::WalkFrames(walk_heap_fn walk) {
+    uint8_t* current = base;
+    while (current < top) {
+        auto* frame = (VMFrame*)current;
+        frame->WalkObjects(walk);
+        current += frame->GetObjectSize();
+    }
+}
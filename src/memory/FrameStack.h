@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#include "../misc/defs.h"
+#include "../vmobjects/ObjectFormats.h"
+
+// size of the contiguous memory area in which frames are allocated
+#define FRAME_STACK_SIZE ((size_t)8 * 1024U * 1024U)  // 8 MB
+
+/**
+ * A contiguous, bump-allocated stack for VMFrames.
+ *
+ * Frames are allocated here instead of on the GC heap, and released again
+ * when they are popped. Thus, calls neither cost a heap allocation, nor do
+ * frames get copied by the collectors.
+ *
+ * Frames on this stack are not heap objects. They are never passed to the
+ * walk functions of the collectors. Instead, all frames on the stack are
+ * walked as roots, and a frame's previousFrame is only walked if it is on the
+ * heap. Frames that are captured by a block are promoted to the heap, before
+ * the block references them. Since blocks are the only heap objects that can
+ * refer to a frame, all context chains are on the heap, and only the
+ * previousFrame chain mixes stack and heap frames.
+ *
+ * If the stack is exhausted, frames are allocated on the heap as before.
+ */
+class FrameStack {
+public:
+    static void Initialize(size_t size);
+    static void Destroy();
+
+    /// Returns a new frame on the stack, or nullptr if there is not enough
+    /// space left.
+    static VMFrame* NewFrame(VMFrame* previousFrame, VMMethod* method);
+
+    /// Releases the memory of the given frame and all frames above it.
+    static inline void Release(const VMFrame* frame) {
+        assert(Contains(frame));
+        top = (uint8_t*)frame;
+    }
+
+    /// Copies the frame to the heap and releases its memory. The frame has to
+    /// be the topmost frame on the stack.
+    static VMFrame* Promote(const VMFrame* frame);
+
+    [[nodiscard]] static inline bool Contains(const void* ptr) {
+        return ptr >= base && ptr < end;
+    }
+
+    static void WalkFrames(walk_heap_fn walk);
+
+private:
+    static uint8_t* base;
+    static uint8_t* top;
+    static uint8_t* end;
+};
@@ -3,7 +3,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
-#include <vector>
+#include <cstring>
 
 #include "../misc/debug.h"
 #include "../misc/defs.h"
@@ -12,33 +12,78 @@
 #include "../vmobjects/IntegerBox.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMFrame.h"
+#include "../vmobjects/VMMethod.h"
 #include "../vmobjects/VMObjectBase.h"
 #include "GarbageCollector.h"
+#include "GenerationalHeap.h"
+#include "ParallelMarker.h"
+
+#ifdef INCREMENTAL_MARKING
+  #include "IncrementalMarker.h"
+#endif
 
 #define INITIAL_MAJOR_COLLECTION_THRESHOLD \
     ((uintptr_t)5 * 1024U * 1024U)  // 5 MB
 
+// the mature space is compacted after a major collection, if this share of
+// its pages could have been released when marking started
+#define COMPACTION_FRAGMENTATION_THRESHOLD 0.25
+
+// the mature pages swept with each minor collection, until the bytes that
+// survived the last major collection are known
+#define MATURE_SWEEP_PAGES ((size_t)16U)
+
 GenerationalCollector::GenerationalCollector(GenerationalHeap* heap)
     : GarbageCollector(heap),
-      majorCollectionThreshold(INITIAL_MAJOR_COLLECTION_THRESHOLD) {}
+      majorCollectionThreshold(INITIAL_MAJOR_COLLECTION_THRESHOLD),
+      sizingPolicy(INITIAL_MAJOR_COLLECTION_THRESHOLD) {}
 
-static gc_oop_t mark_object(gc_oop_t oop) {
-    // don't process tagged objects
-    if (IS_TAGGED(oop)) {
-        return oop;
+static bool try_mark_object(AbstractVMObject* obj) {
+    assert(IsValidObject(obj));
+
+#ifdef INCREMENTAL_MARKING
+    // incremental marking starts with an empty nursery, the objects in there
+    // are not part of the snapshot
+    if (GetHeap<GenerationalHeap>()->isObjectInNursery(obj)) {
+        return false;
     }
+#endif
 
-    AbstractVMObject* obj = AS_OBJ(oop);
+    size_t const gcField = obj->GetGCField();
+    if ((gcField & MASK_OBJECT_IS_MARKED) != 0) {
+        return false;
+    }
+
+    return obj->CompareAndSetGCField(
+        gcField, gcField | MASK_OBJECT_IS_OLD | MASK_OBJECT_IS_MARKED);
+}
+
+static bool sweep_mature_object(AbstractVMObject* obj) {
     assert(IsValidObject(obj));
 
-    if ((obj->GetGCField() & MASK_OBJECT_IS_MARKED) != 0) {
-        return oop;
+    size_t const gcField = obj->GetGCField();
+    if ((gcField & MASK_OBJECT_IS_MARKED) != 0) {
+        // objects in oldObjsWithRefToYoungObjs keep their other bit
+        obj->SetGCField(gcField & ~MASK_OBJECT_IS_MARKED);
+        return true;
     }
+    return false;
+}
 
-    obj->SetGCField(MASK_OBJECT_IS_OLD | MASK_OBJECT_IS_MARKED);
-    obj->WalkObjects(&mark_object);
+static AbstractVMObject* marked_survivor(AbstractVMObject* obj) {
+    return (obj->GetGCField() & MASK_OBJECT_IS_MARKED) != 0 ? obj : nullptr;
+}
 
-    return oop;
+static AbstractVMObject* nursery_survivor(AbstractVMObject* obj) {
+    if (!GetHeap<GenerationalHeap>()->isObjectInNursery(obj)) {
+        return obj;
+    }
+    return (AbstractVMObject*)obj->GetGCField();
+}
+
+static AbstractVMObject* evacuated_survivor(AbstractVMObject* obj) {
+    size_t const gcField = obj->GetGCField();
+    return gcField > MASK_BITS_ALL ? (AbstractVMObject*)gcField : obj;
 }
 
 static gc_oop_t copy_if_necessary(gc_oop_t oop) {
@@ -82,9 +127,72 @@ static gc_oop_t copy_if_necessary(gc_oop_t oop) {
     return tmp_ptr(newObj);
 }
 
+static void evacuate_object(AbstractVMObject* obj) {
+    assert(IsValidObject(obj));
+
+    AbstractVMObject* newObj = obj->CloneForMovingGC();
+
+    if (DEBUG) {
+        obj->MarkObjectAsInvalid();
+    }
+
+    obj->SetGCField((size_t)newObj);
+    newObj->SetGCField(MASK_OBJECT_IS_OLD);
+}
+
+static gc_oop_t update_reference(gc_oop_t oop) {
+    // don't process tagged objects
+    if (IS_TAGGED(oop)) {
+        return oop;
+    }
+
+    // the nursery is empty, and only evacuated objects carry a forwarding
+    // pointer instead of mark bits
+    size_t const gcField = AS_OBJ(oop)->GetGCField();
+    if (gcField > MASK_BITS_ALL) {
+        return (gc_oop_t)gcField;
+    }
+    return oop;
+}
+
+static void update_references(AbstractVMObject* obj) {
+    obj->WalkObjects(&update_reference);
+}
+
+#ifdef CARD_MARKING
+static void walkDirtyCards(AbstractVMObject* obj) {
+    if (*GenerationalHeap::GetWholeObjectCard(obj) != 0) {
+        obj->WalkObjects(&copy_if_necessary);
+    } else {
+        size_t const numCards = GenerationalHeap::GetNumberOfCards(obj);
+        size_t card = 0;
+        while (card < numCards) {
+            if (*GenerationalHeap::GetCard(obj, card) == 0) {
+                card += 1;
+                continue;
+            }
+
+            // walk runs of dirty cards at once
+            size_t end = card + 1;
+            while (end < numCards &&
+                   *GenerationalHeap::GetCard(obj, end) != 0) {
+                end += 1;
+            }
+            obj->WalkObjectsInRange(&copy_if_necessary,
+                                    (uint8_t*)obj + (card * CARD_SIZE),
+                                    (uint8_t*)obj + (end * CARD_SIZE));
+            card = end;
+        }
+    }
+    GenerationalHeap::ClearCards(obj);
+}
+#endif
+
 void GenerationalCollector::MinorCollection() {
     DebugLog("GenGC MinorCollection\n");
 
+    heap->retireAllocationBuffer();
+
     // walk all globals of universe, and implicily the interpreter
     Universe::WalkGlobals(&copy_if_necessary);
 
@@ -94,33 +202,84 @@ void GenerationalCollector::MinorCollection() {
         // because copy_if_necessary returns old objs only -> ignored by
         // write_barrier
         auto* obj = (AbstractVMObject*)oldObj;
-        obj->SetGCField(MASK_OBJECT_IS_OLD);
+        // the mark bit is kept for incremental marking
+        obj->SetGCField(obj->GetGCField() & ~MASK_SEEN_BY_WRITE_BARRIER);
+#ifdef CARD_MARKING
+        walkDirtyCards(obj);
+#else
         obj->WalkObjects(&copy_if_necessary);
+#endif
     }
     heap->oldObjsWithRefToYoungObjs.clear();
+
+    // this needs the forwarding pointers in the nursery
+    heap->updateAllocationSites();
+    VMMethod::SweepNativeMemory(&nursery_survivor, false);
+
+#ifdef INCREMENTAL_MARKING
+    // the barrier of incremental marking reads the fields of new objects
+    // before they are initialized, so they need to be empty
+    memset(heap->nursery, 0,
+           (size_t)heap->nextFreePosition - (size_t)heap->nursery);
+#endif
     heap->nextFreePosition = heap->nursery;
 }
 
 void GenerationalCollector::MajorCollection() {
     DebugLog("GenGC MajorCollection\n");
 
+    heap->matureObjects.StartMarking();
+    VMMethod::SnapshotOwnersOfNativeMemory();
+    compactAfterMarking = heap->matureObjects.GetFragmentation() >=
+                          COMPACTION_FRAGMENTATION_THRESHOLD;
+
     // first we have to mark all objects (globals and current frame recursively)
-    Universe::WalkGlobals(&mark_object);
-
-    // now that all objects are marked we can safely delete all allocated
-    // objects that are not marked
-    vector<AbstractVMObject*> survivors;
-    for (auto* obj : heap->allocatedObjects) {
-        assert(IsValidObject(obj));
-
-        if ((obj->GetGCField() & MASK_OBJECT_IS_MARKED) != 0) {
-            survivors.push_back(obj);
-            obj->SetGCField(MASK_OBJECT_IS_OLD);
-        } else {
-            heap->FreeObject(obj);
-        }
+    ParallelMarker::MarkReachableObjects(&try_mark_object);
+
+    // now that all objects are marked, the ones that are not marked are freed
+    // lazily, page by page
+    VMMethod::SweepNativeMemory(&marked_survivor, true);
+    heap->matureObjects.StartSweeping(&sweep_mature_object);
+
+    if (compactAfterMarking) {
+        compactMatureObjects();
     }
-    heap->allocatedObjects.swap(survivors);
+}
+
+void GenerationalCollector::compactMatureObjects() {
+    DebugLog("GenGC Compaction\n");
+
+    // the live objects are only known once all pages are swept
+    heap->matureObjects.FinishSweeping();
+    heap->matureObjects.StartEvacuation();
+
+    // the evacuated objects are cloned, which leaves a forwarding pointer
+    // behind, and then all references to them are updated
+    heap->matureObjects.ForEachEvacuatedObject(&evacuate_object);
+    VMMethod::SweepNativeMemory(&evacuated_survivor, false);
+    Universe::WalkGlobals(&update_reference);
+    heap->matureObjects.ForEachObject(&update_references);
+
+    heap->matureObjects.FinishEvacuation();
+    compactAfterMarking = false;
+}
+
+void GenerationalCollector::countMatureSurvivors() {
+    if (survivorsCounted) {
+        return;
+    }
+
+    heap->matureObjects.Sweep(MATURE_SWEEP_PAGES);
+    if (heap->matureObjects.IsSweeping()) {
+        return;
+    }
+
+    // from now on, matureObjectsSize includes the surviving bytes
+    survivorsCounted = true;
+    size_t const surviving = heap->matureObjects.GetSurvivingBytes();
+    heap->matureObjectsSize += surviving;
+    majorCollectionThreshold = sizingPolicy.NextHeapSize(surviving);
+    heap->matureObjects.ReleaseMemory(majorCollectionThreshold);
 }
 
 void GenerationalCollector::Collect() {
@@ -129,10 +288,54 @@ void GenerationalCollector::Collect() {
     // reset collection trigger
     heap->resetGCTrigger();
 
+#ifdef INCREMENTAL_MARKING
+    // the major collection is marked in slices, one with each minor
+    // collection. A slice runs first, while the references that the barrier
+    // recorded are still valid. If the mature space grows much faster than
+    // marking proceeds, the rest is marked at once.
+    bool finishMarking = false;
+    if (IncrementalMarker::IsMarking()) {
+        finishMarking =
+            IncrementalMarker::Step(INCREMENTAL_MARK_SLICE) ||
+            heap->matureObjectsSize > 2 * majorCollectionThreshold;
+        if (finishMarking) {
+            DebugLog("GenGC MajorCollection\n");
+            IncrementalMarker::Finish();
+        }
+    }
+
     MinorCollection();
+    countMatureSurvivors();
+
+    if (finishMarking) {
+        VMMethod::SweepNativeMemory(&marked_survivor, true);
+        heap->matureObjects.StartSweeping(&sweep_mature_object);
+        if (compactAfterMarking) {
+            compactMatureObjects();
+        }
+        heap->matureObjectsSize = 0;
+        survivorsCounted = false;
+        countMatureSurvivors();
+    } else if (!IncrementalMarker::IsMarking() &&
+               heap->matureObjectsSize > majorCollectionThreshold) {
+        // the nursery is empty now, and thus, is not part of the snapshot
+        heap->matureObjects.StartMarking();
+        VMMethod::SnapshotOwnersOfNativeMemory();
+        compactAfterMarking = heap->matureObjects.GetFragmentation() >=
+                              COMPACTION_FRAGMENTATION_THRESHOLD;
+        IncrementalMarker::Start(&try_mark_object);
+    }
+#else
+    MinorCollection();
+    countMatureSurvivors();
+
     if (heap->matureObjectsSize > majorCollectionThreshold) {
         MajorCollection();
-        majorCollectionThreshold = 2 * heap->matureObjectsSize;
+        heap->matureObjectsSize = 0;
+        survivorsCounted = false;
+        countMatureSurvivors();
     }
+#endif
     Timer::GCTimer.Halt();
+    sizingPolicy.RecordCollection();
 }
@@ -2,6 +2,7 @@
 
 #include "../misc/defs.h"
 #include "GarbageCollector.h"
+#include "HeapSizingPolicy.h"
 
 class GenerationalHeap;
 class GenerationalCollector : public GarbageCollector<GenerationalHeap> {
@@ -14,4 +15,18 @@ private:
     size_t matureObjectsSize{0};
     void MajorCollection();
     void MinorCollection();
+
+    /// Sweeps a few more mature pages after a major collection, and sets the
+    /// threshold for the next one once the surviving bytes are known.
+    void countMatureSurvivors();
+
+    /// Moves the objects of the sparsest mature pages into the free cells of
+    /// the others, once the nursery is empty and marking is complete.
+    void compactMatureObjects();
+
+    // decided when marking starts, from the fragmentation of the last cycle
+    bool compactAfterMarking{false};
+
+    HeapSizingPolicy sizingPolicy;
+    bool survivorsCounted{true};
 };
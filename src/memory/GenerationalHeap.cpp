@@ -1,5 +1,9 @@
 #include "GenerationalHeap.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <string>
@@ -12,6 +16,10 @@
 #include "GenerationalCollector.h"
 #include "Heap.h"
 
+#ifdef INCREMENTAL_MARKING
+  #include "IncrementalMarker.h"
+#endif
+
 using namespace std;
 
 GenerationalHeap::GenerationalHeap(size_t objectSpaceSize)
@@ -25,30 +33,80 @@ GenerationalHeap::GenerationalHeap(size_t objectSpaceSize)
       collectionLimit((void*)((size_t)nursery +
                               ((size_t)((double)objectSpaceSize * 0.9)))) {
     memset(nursery, 0x0, objectSpaceSize);
+    threadAllocationBuffer.Reset();
 }
 
-AbstractVMObject* GenerationalHeap::AllocateNurseryObject(size_t size) {
-    auto* newObject = (AbstractVMObject*)nextFreePosition;
-    nextFreePosition = (void*)((size_t)nextFreePosition + size);
-    if ((size_t)nextFreePosition > nursery_end) {
+AbstractVMObject* GenerationalHeap::refillAllocationBuffer(size_t size) {
+    retireAllocationBuffer();
+
+    auto* start = (uint8_t*)nextFreePosition;
+    if ((size_t)start + size > nursery_end) {
         ErrorPrint("\nFailed to allocate " + to_string(size) +
                    " Bytes in nursery.\n");
         Quit(-1);
     }
+
+    size_t const bufferSize = max(size, ALLOCATION_BUFFER_SIZE);
+    nextFreePosition = (void*)min((size_t)start + bufferSize, nursery_end);
+
     // let's see if we have to trigger the GC
     if (nextFreePosition > collectionLimit) {
         requestGC();
     }
-    return newObject;
+
+    threadAllocationBuffer.top = start;
+    threadAllocationBuffer.end = (uint8_t*)nextFreePosition;
+    return threadAllocationBuffer.TryAllocate(size);
+}
+
+void GenerationalHeap::retireAllocationBuffer() {
+    // the buffer is the last region that was handed out, its unused end can
+    // be handed out again
+    if (threadAllocationBuffer.end == (uint8_t*)nextFreePosition) {
+        nextFreePosition = threadAllocationBuffer.top;
+    }
+    threadAllocationBuffer.Reset();
+}
+
+void GenerationalHeap::updateAllocationSites() {
+    // the nursery objects that were copied carry a forwarding pointer
+    for (const auto& [obj, site] : allocationSites) {
+        site->allocated += 1;
+        if (obj->GetGCField() != 0) {
+            site->survived += 1;
+        }
+    }
+
+    // each site is judged once enough of its objects were seen, and then
+    // starts over
+    for (const auto& [obj, site] : allocationSites) {
+        if (site->allocated >= PRETENURING_MIN_ALLOCATIONS) {
+            site->pretenure = site->survived * 100 >=
+                              site->allocated * PRETENURING_SURVIVAL_PERCENT;
+            site->allocated = 0;
+            site->survived = 0;
+        }
+    }
+    allocationSites.clear();
 }
 
 AbstractVMObject* GenerationalHeap::AllocateMatureObject(size_t size) {
-    auto* newObject = (AbstractVMObject*)malloc(size);
-    if (newObject == nullptr) {
-        ErrorPrint("\nFailed to allocate " + to_string(size) + " Bytes.\n");
-        Quit(-1);
+    AbstractVMObject* newObject = matureObjects.Allocate(size);
+#ifdef CARD_MARKING
+    // the cell may have room for more cards than the object needs
+    size_t const numCards = (size + CARD_SIZE - 1) / CARD_SIZE;
+    size_t const cardTableSize = GetCardTableSize(size);
+    memset((uint8_t*)newObject - cardTableSize, 0,
+           cardTableSize - sizeof(size_t));
+    *((size_t*)newObject - 1) = numCards;
+#endif
+#ifdef INCREMENTAL_MARKING
+    // the barrier of incremental marking reads the fields of new objects
+    // before they are initialized
+    if (IncrementalMarker::IsMarking()) {
+        memset((void*)newObject, 0, size);
     }
-    allocatedObjects.push_back(newObject);
+#endif
     matureObjectsSize += size;
     return newObject;
 }
@@ -60,3 +118,27 @@ void GenerationalHeap::writeBarrier_OldHolder(VMObjectBase* holder,
         holder->SetGCField(holder->GetGCField() | MASK_SEEN_BY_WRITE_BARRIER);
     }
 }
+
+#ifdef CARD_MARKING
+// dirties the card of the slot, or the whole object if the slot is not known
+void GenerationalHeap::dirtyCard(VMObjectBase* holder, const void* slot) {
+    if (slot == nullptr) {
+        *GetWholeObjectCard(holder) = 1;
+    } else {
+        size_t const card = ((size_t)slot - (size_t)holder) / CARD_SIZE;
+        assert(card < GetNumberOfCards(holder));
+        *GetCard(holder, card) = 1;
+    }
+
+    size_t const gcfield = holder->GetGCField();
+    if ((gcfield & MASK_SEEN_BY_WRITE_BARRIER) == 0U) {
+        oldObjsWithRefToYoungObjs.push_back((size_t)holder);
+        holder->SetGCField(gcfield | MASK_SEEN_BY_WRITE_BARRIER);
+    }
+}
+
+void GenerationalHeap::ClearCards(const void* obj) {
+    size_t const cardTableSize = CARD_TABLE_SIZE(GetNumberOfCards(obj));
+    memset((uint8_t*)obj - cardTableSize, 0, cardTableSize - sizeof(size_t));
+}
+#endif
@@ -1,11 +1,18 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 
 #include "../misc/defs.h"
 #include "../vm/IsValidObject.h"
 #include "../vmobjects/VMObjectBase.h"
+#include "AllocationBuffer.h"
+#include "AllocationSite.h"
 #include "Heap.h"
+#include "LargeObjectSpace.h"
+#include "SizeClassAllocator.h"
 
 #ifdef UNITTESTS
 struct VMObjectCompare {
@@ -17,31 +24,98 @@ struct VMObjectCompare {
 };
 #endif
 
+#ifdef CARD_MARKING
+  // the number of bytes of a mature object that are covered by one card
+  #define CARD_SIZE ((size_t)512U)
+
+  // the bytes that precede a mature object with the given number of cards
+  #define CARD_TABLE_SIZE(numCards) \
+      (sizeof(size_t) + PADDED_SIZE(1 + (numCards)))
+#endif
+
 class GenerationalHeap : public Heap<GenerationalHeap> {
     friend class GenerationalCollector;
 
 public:
     explicit GenerationalHeap(size_t objectSpaceSize = 1048576);
-    AbstractVMObject* AllocateNurseryObject(size_t size);
+    inline AbstractVMObject* AllocateNurseryObject(size_t size);
     AbstractVMObject* AllocateMatureObject(size_t size);
     [[nodiscard]] size_t GetMaxNurseryObjectSize() const;
     void writeBarrier(VMObjectBase* holder, vm_oop_t referencedObject);
     inline bool isObjectInNursery(vm_oop_t obj);
+
+    /// Records the site of a nursery object, to count whether it survives
+    /// the next minor collection.
+    inline void RecordAllocationSite(AbstractVMObject* obj,
+                                     AllocationSite* site) {
+        allocationSites.emplace_back(obj, site);
+    }
+
+#ifdef CARD_MARKING
+    /**
+     * With card marking, each mature object is preceded by a card table.
+     * Directly before the object is its number of cards, followed, in
+     * descending addresses, by a card that is dirtied if the whole object
+     * needs to be scanned, and by one card for each CARD_SIZE bytes of the
+     * object.
+     *
+     * Stores into a known slot dirty only the slot's card, others dirty the
+     * whole object. Cards are dirtied unconditionally, without checking
+     * whether the stored object is in the nursery. The first dirtied card of
+     * an object adds it to oldObjsWithRefToYoungObjs, and a minor collection
+     * scans only the dirty cards of the objects in there.
+     */
+    void writeBarrier(VMObjectBase* holder, const void* slot,
+                      vm_oop_t referencedObject);
+
+    static inline size_t GetCardTableSize(size_t objectSize) {
+        return CARD_TABLE_SIZE((objectSize + CARD_SIZE - 1) / CARD_SIZE);
+    }
+    static inline size_t GetNumberOfCards(const void* obj) {
+        return *((const size_t*)obj - 1);
+    }
+    static inline uint8_t* GetWholeObjectCard(const void* obj) {
+        return (uint8_t*)obj - sizeof(size_t) - 1;
+    }
+    static inline uint8_t* GetCard(const void* obj, size_t index) {
+        return GetWholeObjectCard(obj) - 1 - index;
+    }
+    static void ClearCards(const void* obj);
+#endif
 #ifdef UNITTESTS
     std::set<pair<vm_oop_t, vm_oop_t>, VMObjectCompare> writeBarrierCalledOn;
 #endif
 private:
+    AbstractVMObject* refillAllocationBuffer(size_t size);
+    void retireAllocationBuffer();
+    void updateAllocationSites();
+
     void* nursery;
     size_t nursery_end;
     size_t nurserySize;
     size_t maxNurseryObjSize;
+
+    // the bytes of the mature objects allocated since the last major
+    // collection, plus the ones that survived it, once they are counted
     size_t matureObjectsSize{0};
+
+    // the end of the nursery memory handed out to the allocation buffer
     void* nextFreePosition;
     void writeBarrier_OldHolder(VMObjectBase* holder,
                                 vm_oop_t referencedObject);
+#ifdef CARD_MARKING
+    void dirtyCard(VMObjectBase* holder, const void* slot);
+#endif
     void* collectionLimit;
     vector<size_t> oldObjsWithRefToYoungObjs;
-    vector<AbstractVMObject*> allocatedObjects;
+
+    // the nursery objects of which the allocation site is known
+    vector<pair<AbstractVMObject*, AllocationSite*>> allocationSites;
+#ifdef CARD_MARKING
+    SizeClassAllocator matureObjects{&GetCardTableSize};
+#else
+    SizeClassAllocator matureObjects;
+#endif
 };
 
 inline bool GenerationalHeap::isObjectInNursery(vm_oop_t obj) {
@@ -50,8 +124,18 @@ inline bool GenerationalHeap::isObjectInNursery(vm_oop_t obj) {
     return (size_t)obj >= (size_t)nursery && (size_t)obj < nursery_end;
 }
 
+inline AbstractVMObject* GenerationalHeap::AllocateNurseryObject(size_t size) {
+    AbstractVMObject* newObject = threadAllocationBuffer.TryAllocate(size);
+    if (likely(newObject != nullptr)) {
+        return newObject;
+    }
+    return refillAllocationBuffer(size);
+}
+
+// bigger objects are allocated directly as mature objects, large objects
+// in the large-object space, so that they are not copied on promotion
 inline size_t GenerationalHeap::GetMaxNurseryObjectSize() const {
-    return maxNurseryObjSize;
+    return min(maxNurseryObjSize, LargeObjectSpace::Threshold);
 }
 
 inline void GenerationalHeap::writeBarrier(VMObjectBase* holder,
@@ -64,8 +148,32 @@ inline void GenerationalHeap::writeBarrier(VMObjectBase* holder,
     assert(IsValidObject(holder));
 
     const size_t gcfield = *(((size_t*)holder) + 1);
+#ifdef CARD_MARKING
+    if ((gcfield & MASK_OBJECT_IS_OLD) != 0U) {
+        dirtyCard(holder, nullptr);
+    }
+#else
     if ((gcfield & 6U /* MASK_OBJECT_IS_OLD + MASK_SEEN_BY_WRITE_BARRIER */) ==
         2U /* MASK_OBJECT_IS_OLD */) {
         writeBarrier_OldHolder(holder, referencedObject);
     }
+#endif
 }
+
+#ifdef CARD_MARKING
+inline void GenerationalHeap::writeBarrier(VMObjectBase* holder,
+                                           const void* slot,
+                                           vm_oop_t referencedObject) {
+  #ifdef UNITTESTS
+    writeBarrierCalledOn.insert(make_pair(holder, referencedObject));
+  #endif
+
+    assert(IsValidObject(referencedObject));
+    assert(IsValidObject(holder));
+
+    const size_t gcfield = *(((size_t*)holder) + 1);
+    if ((gcfield & MASK_OBJECT_IS_OLD) != 0U) {
+        dirtyCard(holder, slot);
+    }
+}
+#endif
@@ -33,6 +33,7 @@
 #include "CopyingHeap.h"       // NOLINT(misc-include-cleaner)
 #include "DebugCopyingHeap.h"  // NOLINT(misc-include-cleaner)
 #include "GenerationalHeap.h"  // NOLINT(misc-include-cleaner)
+#include "ImmixHeap.h"         // NOLINT(misc-include-cleaner)
 #include "MarkSweepHeap.h"     // NOLINT(misc-include-cleaner)
 
 template <class HEAP_T>
@@ -77,3 +78,7 @@ template Heap<CopyingHeap>::~Heap();
 class MarkSweepHeap;
 template MarkSweepHeap* Heap<MarkSweepHeap>::theHeap;
 template Heap<MarkSweepHeap>::~Heap();
+
+class ImmixHeap;
+template ImmixHeap* Heap<ImmixHeap>::theHeap;
+template Heap<ImmixHeap>::~Heap();
@@ -0,0 +1,58 @@
+#include "HeapSizingPolicy.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "../misc/Timer.h"
+#include "../vm/Print.h"
+
+size_t HeapSizingPolicy::MaxHeapSize = 0;
+double HeapSizingPolicy::PauseGoal = 0.0;
+size_t HeapSizingPolicy::GCTimeRatio = 19;
+
+HeapSizingPolicy::HeapSizingPolicy(size_t initialHeapSize)
+    : minHeapSize(MaxHeapSize == 0 ? initialHeapSize
+                                   : std::min(initialHeapSize, MaxHeapSize)),
+      periodStart(get_microseconds()) {}
+
+void HeapSizingPolicy::RecordCollection() {
+    double const pause = Timer::GCTimer.GetLastTime();
+    gcTime += pause;
+    longestPause = std::max(longestPause, pause);
+}
+
+size_t HeapSizingPolicy::NextHeapSize(size_t survivingBytes) {
+    if (MaxHeapSize != 0 && survivingBytes > MaxHeapSize) {
+        ErrorExit(("the " + std::to_string(survivingBytes) +
+                   " surviving bytes exceed the maximum heap size")
+                      .c_str());
+    }
+
+    int64_t const now = get_microseconds();
+    double const elapsed = (double)(now - periodStart) / 1000.0;
+    if (elapsed > 0.0) {
+        double const gcShare = gcTime / elapsed;
+        double const gcShareGoal = 1.0 / (1.0 + (double)GCTimeRatio);
+
+        if (PauseGoal > 0.0 && longestPause > PauseGoal) {
+            growthFactor = std::max(HEAP_MIN_GROWTH_FACTOR, growthFactor * 0.8);
+        } else if (gcShare > gcShareGoal) {
+            growthFactor = std::min(HEAP_MAX_GROWTH_FACTOR, growthFactor * 1.5);
+        } else if (gcShare < gcShareGoal / 2) {
+            growthFactor = std::max(HEAP_MIN_GROWTH_FACTOR, growthFactor * 0.9);
+        }
+    }
+
+    periodStart = now;
+    gcTime = 0.0;
+    longestPause = 0.0;
+
+    size_t size = std::max(minHeapSize,
+                           (size_t)((double)survivingBytes * growthFactor));
+    if (MaxHeapSize != 0) {
+        size = std::min(size, MaxHeapSize);
+    }
+    return size;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// the heap size is this multiple of the surviving bytes, initially, and at
+// least and at most
+#define HEAP_GROWTH_FACTOR 2.0
+#define HEAP_MIN_GROWTH_FACTOR 1.25
+#define HEAP_MAX_GROWTH_FACTOR 4.0
+
+/**
+ * Decides how big a heap may become until its next collection, from the bytes
+ * that survived the last one, and from the time the collections take.
+ *
+ * The heap size is a multiple of the surviving bytes. The factor grows while
+ * more than 1/(1 + GCTimeRatio) of the time is spent in collections. It
+ * shrinks while much less is, or while a collection pauses for longer than
+ * PauseGoal, since a smaller heap has less to sweep, and sooner becomes
+ * cheaper to collect incrementally. The size does not drop below the initial
+ * heap size, and does not grow beyond MaxHeapSize. The heaps give the memory
+ * that they do not need for the new size back to the operating system.
+ *
+ * For the COPYING heap, the size is the one of a semispace, as with -H.
+ */
+class HeapSizingPolicy {
+public:
+    /// The maximum heap size in bytes, set with -Xmax, or 0 if unlimited.
+    static size_t MaxHeapSize;
+
+    /// The longest pause in ms that collections aim for, set with -gcpause,
+    /// or 0 if there is no goal.
+    static double PauseGoal;
+
+    /// The time the mutator aims to run for each unit of GC time, set with
+    /// -gcratio.
+    static size_t GCTimeRatio;
+
+    explicit HeapSizingPolicy(size_t initialHeapSize);
+
+    /// Records the last collection, as timed by Timer::GCTimer.
+    void RecordCollection();
+
+    /// Returns the heap size until the next collection, with the growth
+    /// factor adapted to the collections since the last call.
+    size_t NextHeapSize(size_t survivingBytes);
+
+private:
+    size_t minHeapSize;
+    double growthFactor{HEAP_GROWTH_FACTOR};
+
+    // the collections since the last call to NextHeapSize()
+    int64_t periodStart;
+    double gcTime{0.0};
+    double longestPause{0.0};
+};
@@ -0,0 +1,120 @@
+#include "ImmixCollector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "../memory/Heap.h"
+#include "../misc/debug.h"
+#include "../vm/IsValidObject.h"
+#include "../vm/Universe.h"
+#include "../vmobjects/AbstractObject.h"
+#include "../vmobjects/IntegerBox.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMFrame.h"
+#include "../vmobjects/VMMethod.h"
+#include "ImmixHeap.h"
+
+// marked objects, of which the references still need to be marked
+static vector<AbstractVMObject*> markStack;
+
+static gc_oop_t mark_object(gc_oop_t oop) {
+    // don't process tagged objects
+    if (IS_TAGGED(oop)) {
+        return oop;
+    }
+
+    AbstractVMObject* obj = AS_OBJ(oop);
+
+    // the GC field is only used as forwarding pointer of evacuated objects
+    size_t const gcField = obj->GetGCField();
+    if (gcField != 0) {
+        return (gc_oop_t)gcField;
+    }
+
+    assert(IsValidObject(obj));
+
+    ImmixBlock* block = ImmixBlock::Of(obj);
+    if (block->IsMarked(obj)) {
+        return oop;
+    }
+
+    size_t const size = obj->GetObjectSize();
+    if (block->evacuate && GetHeap<ImmixHeap>()->CanEvacuate(size)) {
+        AbstractVMObject* newObj = obj->CloneForMovingGC();
+        obj->SetGCField((size_t)newObj);
+
+        ImmixBlock::Of(newObj)->Mark(newObj, size);
+        markStack.push_back(newObj);
+        return tmp_ptr(newObj);
+    }
+
+    block->Mark(obj, size);
+    markStack.push_back(obj);
+    return oop;
+}
+
+static AbstractVMObject* survivor(AbstractVMObject* obj) {
+    size_t const gcField = obj->GetGCField();
+    if (gcField != 0) {
+        return (AbstractVMObject*)gcField;
+    }
+    return ImmixBlock::Of(obj)->IsMarked(obj) ? obj : nullptr;
+}
+
+void ImmixCollector::selectEvacuationCandidates() {
+    // the objects of the candidates need to fit into the free blocks, which
+    // is estimated based on the lines they had after the last collection
+    size_t freeLines =
+        heap->freeBlocks.size() *
+        (IMMIX_LINES_PER_BLOCK - ImmixBlock::FirstUsableLine());
+
+    for (ImmixBlock* block : heap->recyclableBlocks) {
+        if (block->liveLines <= IMMIX_EVACUATION_THRESHOLD &&
+            block->liveLines <= freeLines) {
+            block->evacuate = true;
+            freeLines -= block->liveLines;
+        }
+    }
+}
+
+void ImmixCollector::clearMarks() {
+    for (ImmixBlock* block : heap->blocks) {
+        memset(block->lineMarks, 0, sizeof(block->lineMarks));
+        memset(block->markBits, 0, sizeof(block->markBits));
+    }
+}
+
+void ImmixCollector::Collect() {
+    DebugLog("Immix Collect\n");
+
+    Timer::GCTimer.Resume();
+    // reset collection trigger
+    heap->resetGCTrigger();
+
+    selectEvacuationCandidates();
+    clearMarks();
+    heap->largeObjects.StartMarking();
+
+    // while collecting, allocations are only done to evacuate objects
+    heap->isCollecting = true;
+    heap->cursor = nullptr;
+    heap->limit = nullptr;
+
+    // This walks the globals of the universe, and the interpreter
+    Universe::WalkGlobals(mark_object);
+
+    while (!markStack.empty()) {
+        AbstractVMObject* obj = markStack.back();
+        markStack.pop_back();
+        obj->WalkObjects(mark_object);
+    }
+
+    heap->isCollecting = false;
+    VMMethod::SweepNativeMemory(&survivor, false);
+    heap->sweep();
+
+    Timer::GCTimer.Halt();
+    heap->sizingPolicy.RecordCollection();
+}
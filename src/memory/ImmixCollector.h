@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../misc/defs.h"
+#include "GarbageCollector.h"
+
+class ImmixHeap;
+class ImmixCollector : public GarbageCollector<ImmixHeap> {
+public:
+    explicit ImmixCollector(ImmixHeap* heap) : GarbageCollector(heap) {}
+    void Collect() override;
+
+private:
+    void selectEvacuationCandidates();
+    void clearMarks();
+};
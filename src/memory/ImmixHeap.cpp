@@ -0,0 +1,256 @@
+#include "ImmixHeap.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../misc/defs.h"
+#include "../vm/Print.h"
+#include "../vmobjects/AbstractObject.h"
+#include "Heap.h"
+#include "ImmixCollector.h"
+
+static ImmixBlock* newBlock() {
+    void* memory = aligned_alloc(IMMIX_BLOCK_SIZE, IMMIX_BLOCK_SIZE);
+    if (memory == nullptr) {
+        ErrorExit("unable to allocate heap memory");
+    }
+
+    auto* block = (ImmixBlock*)memory;
+    memset((void*)block, 0, sizeof(ImmixBlock));
+    block->size = IMMIX_BLOCK_SIZE;
+    return block;
+}
+
+static bool sweep_large_object(AbstractVMObject* obj) {
+    ImmixBlock* block = ImmixBlock::Of(obj);
+    bool const marked = block->IsMarked(obj);
+    memset(block->markBits, 0, sizeof(block->markBits));
+    return marked;
+}
+
+ImmixHeap::ImmixHeap(size_t objectSpaceSize)
+    : Heap<ImmixHeap>(new ImmixCollector(this)),
+      // our initial collection limit is 90% of objectSpaceSize
+      collectionLimit((size_t)((double)objectSpaceSize * 0.9)),
+      sizingPolicy(collectionLimit) {}
+
+ImmixHeap::~ImmixHeap() {
+    for (ImmixBlock* block : blocks) {
+        free(block);
+    }
+}
+
+void ImmixHeap::claim(uint8_t* start, uint8_t* end) {
+    memset(start, 0, end - start);
+
+    spcAlloc += end - start;
+    if (spcAlloc >= collectionLimit) {
+        requestGC();
+    }
+}
+
+ImmixBlock* ImmixHeap::takeFreeBlock() {
+    if (!freeBlocks.empty()) {
+        ImmixBlock* block = freeBlocks.back();
+        freeBlocks.pop_back();
+        reuseBlock(block);
+        return block;
+    }
+
+    ImmixBlock* block = newBlock();
+    blocks.push_back(block);
+    return block;
+}
+
+void ImmixHeap::reuseBlock(ImmixBlock* block) {
+    // the released memory is mapped again, zeroed, when it is written to
+    if (block->released) {
+        block->released = false;
+        numReleasedBlocks -= 1;
+    }
+}
+
+void ImmixHeap::releaseFreeBlocks() {
+    static size_t const osPageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t const keptBlocks = collectionLimit / IMMIX_BLOCK_SIZE;
+
+    // the blocks at the end of freeBlocks are taken first, and keep their
+    // memory the longest
+    for (ImmixBlock* block : freeBlocks) {
+        if (blocks.size() - numReleasedBlocks <= keptBlocks) {
+            return;
+        }
+        if (block->released || osPageSize >= IMMIX_BLOCK_SIZE) {
+            continue;
+        }
+
+        // the header stays, it holds the block's marks
+        madvise((uint8_t*)block + osPageSize, IMMIX_BLOCK_SIZE - osPageSize,
+                MADV_DONTNEED);
+        block->released = true;
+        numReleasedBlocks += 1;
+    }
+}
+
+void ImmixHeap::nextHole(size_t size) {
+    assert(size <= IMMIX_LINE_SIZE);
+
+    while (true) {
+        if (currentBlock != nullptr) {
+            while (nextLine < IMMIX_LINES_PER_BLOCK &&
+                   currentBlock->lineMarks[nextLine] != 0) {
+                nextLine += 1;
+            }
+
+            size_t end = nextLine;
+            while (end < IMMIX_LINES_PER_BLOCK &&
+                   currentBlock->lineMarks[end] == 0) {
+                end += 1;
+            }
+
+            // every hole is at least a line, and thus, fits the object
+            if (end > nextLine) {
+                cursor = currentBlock->LineAddress(nextLine);
+                limit = currentBlock->LineAddress(end);
+                claim(cursor, limit);
+                nextLine = end;
+                return;
+            }
+        }
+
+        if (nextRecyclableBlock < recyclableBlocks.size()) {
+            currentBlock = recyclableBlocks[nextRecyclableBlock];
+            nextRecyclableBlock += 1;
+        } else {
+            currentBlock = takeFreeBlock();
+        }
+        nextLine = ImmixBlock::FirstUsableLine();
+    }
+}
+
+AbstractVMObject* ImmixHeap::allocateSlowPath(size_t size) {
+    if (unlikely(isCollecting)) {
+        return allocateForEvacuation(size);
+    }
+
+    if (size > IMMIX_MAX_MEDIUM_OBJECT_SIZE) {
+        return allocateLarge(size);
+    }
+
+    if (size > IMMIX_LINE_SIZE) {
+        // the object does not fit the current hole, but the next small
+        // objects might, so it goes to an empty block instead
+        if (size > (size_t)(overflowLimit - overflowCursor)) {
+            ImmixBlock* block = takeFreeBlock();
+            overflowCursor = block->LineAddress(ImmixBlock::FirstUsableLine());
+            overflowLimit = block->LineAddress(IMMIX_LINES_PER_BLOCK);
+            claim(overflowCursor, overflowLimit);
+        }
+
+        auto* newObject = (AbstractVMObject*)overflowCursor;
+        overflowCursor += size;
+        return newObject;
+    }
+
+    nextHole(size);
+
+    auto* newObject = (AbstractVMObject*)cursor;
+    cursor += size;
+    return newObject;
+}
+
+AbstractVMObject* ImmixHeap::allocateLarge(size_t size) {
+    AbstractVMObject* newObject =
+        largeObjects.Allocate(size, sizeof(ImmixBlock), IMMIX_BLOCK_SIZE);
+
+    ImmixBlock* block = ImmixBlock::Of(newObject);
+    memset((void*)block, 0, sizeof(ImmixBlock));
+    block->size = sizeof(ImmixBlock) + size;
+    block->isLarge = true;
+
+    claim((uint8_t*)newObject, (uint8_t*)newObject + size);
+    return newObject;
+}
+
+bool ImmixHeap::CanEvacuate(size_t size) {
+    if (size <= (size_t)(evacuationLimit - evacuationCursor)) {
+        return true;
+    }
+
+    // objects are only moved into blocks that were empty at the start of the
+    // collection, so that defragmenting never needs more memory
+    if (freeBlocks.empty()) {
+        return false;
+    }
+
+    ImmixBlock* block = freeBlocks.back();
+    freeBlocks.pop_back();
+    reuseBlock(block);
+
+    evacuationCursor = block->LineAddress(ImmixBlock::FirstUsableLine());
+    evacuationLimit = block->LineAddress(IMMIX_LINES_PER_BLOCK);
+    memset(evacuationCursor, 0, evacuationLimit - evacuationCursor);
+    return true;
+}
+
+AbstractVMObject* ImmixHeap::allocateForEvacuation(size_t size) {
+    assert(size <= (size_t)(evacuationLimit - evacuationCursor) &&
+           "CanEvacuate() needs to be checked before moving an object");
+
+    auto* newObject = (AbstractVMObject*)evacuationCursor;
+    evacuationCursor += size;
+    return newObject;
+}
+
+void ImmixHeap::sweep() {
+    freeBlocks.clear();
+    recyclableBlocks.clear();
+    nextRecyclableBlock = 0;
+
+    size_t const usableLines =
+        IMMIX_LINES_PER_BLOCK - ImmixBlock::FirstUsableLine();
+    size_t liveBytes = 0;
+
+    for (ImmixBlock* block : blocks) {
+        block->evacuate = false;
+
+        size_t liveLines = 0;
+        for (size_t line = ImmixBlock::FirstUsableLine();
+             line < IMMIX_LINES_PER_BLOCK;
+             line += 1) {
+            liveLines += block->lineMarks[line];
+        }
+        block->liveLines = liveLines;
+        liveBytes += liveLines * IMMIX_LINE_SIZE;
+
+        if (liveLines == 0) {
+            freeBlocks.push_back(block);
+        } else if (liveLines < usableLines) {
+            recyclableBlocks.push_back(block);
+        }
+    }
+
+    largeObjects.Sweep(&sweep_large_object);
+    liveBytes += largeObjects.GetSize();
+
+    // everything is allocated into the holes that are left now
+    cursor = nullptr;
+    limit = nullptr;
+    currentBlock = nullptr;
+    overflowCursor = nullptr;
+    overflowLimit = nullptr;
+    evacuationCursor = nullptr;
+    evacuationLimit = nullptr;
+
+    spcAlloc = liveBytes;
+    collectionLimit = sizingPolicy.NextHeapSize(liveBytes);
+    releaseFreeBlocks();
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../misc/defs.h"
+#include "Heap.h"
+#include "HeapSizingPolicy.h"
+#include "LargeObjectSpace.h"
+
+// the heap is organized in aligned blocks, which are divided into lines.
+// Objects are allocated into runs of free lines, and a collection frees
+// lines, instead of individual objects.
+#define IMMIX_BLOCK_SIZE ((size_t)32 * 1024U)  // 32 KB
+#define IMMIX_LINE_SIZE ((size_t)128U)
+#define IMMIX_LINES_PER_BLOCK (IMMIX_BLOCK_SIZE / IMMIX_LINE_SIZE)
+
+// objects larger than this get blocks of their own
+#define IMMIX_MAX_MEDIUM_OBJECT_SIZE (IMMIX_BLOCK_SIZE / 4)
+
+// blocks with at most this many live lines are evacuated during the next
+// collection, if there are enough free blocks to hold their objects
+#define IMMIX_EVACUATION_THRESHOLD (IMMIX_LINES_PER_BLOCK / 4)
+
+/**
+ * The header at the start of each block, which holds the block's mark bits.
+ * Objects are found in a block by masking their address.
+ */
+struct ImmixBlock {
+    // the size of the block, which is bigger than IMMIX_BLOCK_SIZE for blocks
+    // of large objects
+    size_t size;
+    bool isLarge;
+
+    // the block's objects are moved out of it during the current collection
+    bool evacuate;
+
+    // the number of marked lines after the last collection
+    size_t liveLines;
+
+    // the memory after the block's first OS page was given back to the system
+    bool released;
+
+    uint8_t lineMarks[IMMIX_LINES_PER_BLOCK];
+
+    // one bit for each word of the block, marking the objects starting there
+    uint64_t markBits[IMMIX_BLOCK_SIZE / sizeof(void*) / 64];
+
+    static inline ImmixBlock* Of(const void* obj) {
+        return (ImmixBlock*)((uintptr_t)obj & ~(IMMIX_BLOCK_SIZE - 1));
+    }
+
+    [[nodiscard]] static constexpr size_t FirstUsableLine() {
+        return (sizeof(ImmixBlock) + IMMIX_LINE_SIZE - 1) / IMMIX_LINE_SIZE;
+    }
+
+    [[nodiscard]] inline uint8_t* LineAddress(size_t line) {
+        return (uint8_t*)this + (line * IMMIX_LINE_SIZE);
+    }
+
+    [[nodiscard]] inline bool IsMarked(const void* obj) const {
+        size_t const word = ((uintptr_t)obj - (uintptr_t)this) / sizeof(void*);
+        return (markBits[word / 64] & (1ULL << (word % 64))) != 0;
+    }
+
+    /// Marks the object, and all the lines it occupies.
+    inline void Mark(const void* obj, size_t size) {
+        size_t const offset = (uintptr_t)obj - (uintptr_t)this;
+        size_t const word = offset / sizeof(void*);
+        markBits[word / 64] |= 1ULL << (word % 64);
+
+        if (isLarge) {
+            return;
+        }
+
+        size_t const lastLine = (offset + size - 1) / IMMIX_LINE_SIZE;
+        for (size_t line = offset / IMMIX_LINE_SIZE; line <= lastLine;
+             line += 1) {
+            lineMarks[line] = 1;
+        }
+    }
+};
+
+/**
+ * A mark-region heap after Immix (Blackburn and McKinley, PLDI'08).
+ *
+ * Small objects are bump allocated into holes, i.e., runs of lines that were
+ * free after the last collection. Objects that are bigger than a line and do
+ * not fit the current hole are bump allocated into a separate, empty block,
+ * so that the holes are not skipped. Objects bigger than
+ * IMMIX_MAX_MEDIUM_OBJECT_SIZE get blocks of their own, in the large-object
+ * space.
+ *
+ * The collector marks the live objects and the lines they occupy, without
+ * moving them, and then makes the unmarked lines available for allocation
+ * again. Blocks that were sparsely populated after the last collection are
+ * defragmented opportunistically: as long as there are empty blocks to hold
+ * them, their objects are moved out while marking, which frees the blocks
+ * completely.
+ */
+class ImmixHeap : public Heap<ImmixHeap> {
+    friend class ImmixCollector;
+
+public:
+    explicit ImmixHeap(size_t objectSpaceSize = 1048576);
+    ~ImmixHeap();
+
+    inline AbstractVMObject* AllocateObject(size_t size) {
+        if (likely(size <= (size_t)(limit - cursor))) {
+            auto* newObject = (AbstractVMObject*)cursor;
+            cursor += size;
+            return newObject;
+        }
+        return allocateSlowPath(size);
+    }
+
+    /// Returns whether an object of the given size can be evacuated into the
+    /// blocks that were free at the start of the collection.
+    bool CanEvacuate(size_t size);
+
+private:
+    AbstractVMObject* allocateSlowPath(size_t size);
+    AbstractVMObject* allocateLarge(size_t size);
+    AbstractVMObject* allocateForEvacuation(size_t size);
+
+    /// Moves the allocation to the next hole that can fit an object of the
+    /// given size, in the current, in a recyclable, or in an empty block.
+    void nextHole(size_t size);
+
+    /// Returns an empty block, which is taken from the free blocks, or newly
+    /// allocated.
+    ImmixBlock* takeFreeBlock();
+
+    /// Gives the memory of free blocks back to the system, until the blocks
+    /// that keep theirs take at most the collection limit.
+    void releaseFreeBlocks();
+    void reuseBlock(ImmixBlock* block);
+
+    void claim(uint8_t* start, uint8_t* end);
+    void sweep();
+
+    // the current hole
+    uint8_t* cursor{nullptr};
+    uint8_t* limit{nullptr};
+
+    // the block of the current hole, and the line after it
+    ImmixBlock* currentBlock{nullptr};
+    size_t nextLine{0};
+
+    // the empty block for objects that are bigger than a line
+    uint8_t* overflowCursor{nullptr};
+    uint8_t* overflowLimit{nullptr};
+
+    // the empty block objects are evacuated into
+    uint8_t* evacuationCursor{nullptr};
+    uint8_t* evacuationLimit{nullptr};
+    bool isCollecting{false};
+
+    std::vector<ImmixBlock*> blocks;
+    std::vector<ImmixBlock*> freeBlocks;
+    size_t numReleasedBlocks{0};
+    std::vector<ImmixBlock*> recyclableBlocks;
+    size_t nextRecyclableBlock{0};
+    // each large object is preceded by the header of its block
+    LargeObjectSpace largeObjects;
+
+    // bytes that were live after the last collection, plus the bytes that
+    // were handed out since
+    size_t spcAlloc{0};
+    size_t collectionLimit;
+    HeapSizingPolicy sizingPolicy;
+};
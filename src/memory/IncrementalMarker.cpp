@@ -0,0 +1,96 @@
+#include "IncrementalMarker.h"
+
+#include <cstddef>
+#include <vector>
+
+#include "../interpreter/Interpreter.h"
+#include "../misc/defs.h"
+#include "../vm/Universe.h"
+#include "../vmobjects/AbstractObject.h"
+#include "../vmobjects/IntegerBox.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMFrame.h"
+#include "FrameStack.h"
+
+bool IncrementalMarker::marking = false;
+std::vector<const void*> IncrementalMarker::overwrittenReferences;
+
+static bool (*tryMarkObject)(AbstractVMObject*) = nullptr;
+
+// the gray objects, which are marked, but whose fields are not yet marked
+static std::vector<AbstractVMObject*> markStack;
+
+static gc_oop_t markReference(gc_oop_t oop) {
+    if (IS_TAGGED(oop)) {
+        return oop;
+    }
+
+    AbstractVMObject* obj = AS_OBJ(oop);
+    if (tryMarkObject(obj)) {
+        markStack.push_back(obj);
+    }
+    return oop;
+}
+
+void IncrementalMarker::Start(bool (*tryMark)(AbstractVMObject*)) {
+    tryMarkObject = tryMark;
+    marking = true;
+
+    Universe::WalkGlobals(&markReference);
+
+    // frames on the call chain push and pop without a barrier, so their
+    // slots are snapshotted now. The frames on the frame stack were walked as
+    // roots already, the ones that were promoted to the heap are walked here.
+    for (VMFrame* frame = Interpreter::GetFrame(); frame != nullptr;
+         frame = frame->GetPreviousFrame()) {
+        if (!frame->IsOnStack()) {
+            frame->WalkObjects(&markReference);
+        }
+    }
+}
+
+void IncrementalMarker::recordOverwrittenReference(const void* holder,
+                                                   const void* ref) {
+    // frames on the stack are roots, which were walked at the start. The
+    // frames that were pushed since are not part of the snapshot, and their
+    // slots may still contain garbage.
+    if (!FrameStack::Contains(holder)) {
+        overwrittenReferences.push_back(ref);
+    }
+}
+
+void IncrementalMarker::markOverwrittenReferences() {
+    for (const void* ref : overwrittenReferences) {
+        if (ref != nullptr) {
+            markReference((gc_oop_t)ref);
+        }
+    }
+    overwrittenReferences.clear();
+}
+
+bool IncrementalMarker::Step(size_t budget) {
+    markOverwrittenReferences();
+
+    while (budget > 0 && !markStack.empty()) {
+        AbstractVMObject* obj = markStack.back();
+        markStack.pop_back();
+        obj->WalkObjects(&markReference);
+        budget -= 1;
+    }
+    return markStack.empty();
+}
+
+void IncrementalMarker::Finish() {
+    // walking an object does not record overwritten references, so this
+    // terminates once both are empty
+    markOverwrittenReferences();
+    while (!markStack.empty()) {
+        AbstractVMObject* obj = markStack.back();
+        markStack.pop_back();
+        obj->WalkObjects(&markReference);
+    }
+
+    marking = false;
+    markStack.shrink_to_fit();
+    overwrittenReferences.shrink_to_fit();
+}
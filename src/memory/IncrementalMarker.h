@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../misc/defs.h"
+
+class AbstractVMObject;
+
+// the number of objects that are marked in one slice of incremental marking
+#define INCREMENTAL_MARK_SLICE ((size_t)10000U)
+
+/**
+ * Marks the objects that are reachable from the globals of the universe and
+ * the interpreter in slices, in between which the interpreter continues.
+ *
+ * The marking preserves the snapshot of the object graph at the start, i.e.,
+ * all objects that were reachable then are marked. Start() marks the roots,
+ * and walks the frames of the call chain, which push and pop without a
+ * barrier. Afterwards, store_ptr() records the reference it overwrites, and
+ * the recorded objects are marked by the next slice. Objects that are
+ * allocated while marking are not in the snapshot. The heaps need to keep
+ * them alive until Finish() is called, and need to make sure that their
+ * fields do not contain garbage before they are initialized.
+ */
+class IncrementalMarker {
+public:
+    static void Start(bool (*tryMark)(AbstractVMObject*));
+
+    /// Marks up to budget objects, and returns true if there are none left.
+    static bool Step(size_t budget);
+
+    /// Marks all remaining objects at once, and ends the marking.
+    static void Finish();
+
+    [[nodiscard]] static inline bool IsMarking() { return marking; }
+
+    /// The snapshot-at-the-beginning barrier, which needs to be called before
+    /// a reference in a heap object is overwritten.
+    static inline void RecordOverwrittenReference(const void* holder,
+                                                  const void* ref) {
+        if (unlikely(marking)) {
+            recordOverwrittenReference(holder, ref);
+        }
+    }
+
+private:
+    static void recordOverwrittenReference(const void* holder,
+                                           const void* ref);
+    static void markOverwrittenReferences();
+
+    static bool marking;
+    static std::vector<const void*> overwrittenReferences;
+};
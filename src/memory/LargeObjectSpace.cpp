@@ -0,0 +1,114 @@
+#include "LargeObjectSpace.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "../misc/defs.h"
+#include "../vm/Print.h"
+
+size_t LargeObjectSpace::Threshold = LARGE_OBJECT_THRESHOLD;
+
+static size_t roundUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// maps the given number of bytes, starting at an address that is a multiple
+// of alignment
+static void* map(size_t numBytes, size_t alignment) {
+    // more is mapped to find an aligned start, and the rest is unmapped again
+    size_t const extra = alignment > (size_t)sysconf(_SC_PAGESIZE)
+                             ? alignment
+                             : 0;
+    void* memory = mmap(nullptr, numBytes + extra, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        ErrorExit("unable to allocate heap memory");
+    }
+    if (extra == 0) {
+        return memory;
+    }
+
+    auto* start = (uint8_t*)memory;
+    auto* aligned = (uint8_t*)roundUp((size_t)start, alignment);
+    if (aligned > start) {
+        munmap(start, aligned - start);
+    }
+    size_t const tail = extra - (aligned - start);
+    if (tail > 0) {
+        munmap(aligned + numBytes, tail);
+    }
+    return aligned;
+}
+
+LargeObjectSpace::~LargeObjectSpace() {
+    for (const LargeObject& large : objects) {
+        release(large);
+    }
+}
+
+AbstractVMObject* LargeObjectSpace::Allocate(size_t size, size_t headerSize,
+                                             size_t alignment) {
+    LargeObject large{nullptr, 0, nullptr, size};
+
+    if (size > Threshold) {
+        // mmap() returns zeroed memory
+        large.mappedSize =
+            roundUp(headerSize + size, (size_t)sysconf(_SC_PAGESIZE));
+        large.memory = map(large.mappedSize, alignment);
+    } else {
+        if (alignment == 0) {
+            large.memory = malloc(headerSize + size);
+        } else {
+            large.memory =
+                aligned_alloc(alignment, roundUp(headerSize + size, alignment));
+        }
+        if (large.memory == nullptr) {
+            ErrorExit("unable to allocate heap memory");
+        }
+    }
+
+    large.object = (AbstractVMObject*)((uint8_t*)large.memory + headerSize);
+    objects.push_back(large);
+    this->size += size;
+    return large.object;
+}
+
+void LargeObjectSpace::release(const LargeObject& large) {
+    if (large.mappedSize != 0) {
+        munmap(large.memory, large.mappedSize);
+    } else {
+        free(large.memory);
+    }
+}
+
+void LargeObjectSpace::StartMarking() {
+    objectsInSnapshot = objects.size();
+}
+
+void LargeObjectSpace::Sweep(sweep_fn sweep) {
+    size_t survivors = 0;
+    size = 0;
+    for (size_t i = 0; i < objects.size(); i += 1) {
+        LargeObject const large = objects[i];
+        if (sweep(large.object) || i >= objectsInSnapshot) {
+            objects[survivors] = large;
+            survivors += 1;
+            size += large.size;
+        } else {
+            release(large);
+        }
+    }
+    objects.resize(survivors);
+    objectsInSnapshot = 0;
+}
+
+void LargeObjectSpace::ForEachObject(object_fn fn) const {
+    for (const LargeObject& large : objects) {
+        fn(large.object);
+    }
+}
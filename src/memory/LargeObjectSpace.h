@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../misc/defs.h"
+
+class AbstractVMObject;
+
+// the default for LargeObjectSpace::Threshold
+#define LARGE_OBJECT_THRESHOLD ((size_t)64 * 1024U)  // 64 KB
+
+/// Returns whether the object survives the sweep, and clears its mark.
+typedef bool (*sweep_fn)(AbstractVMObject*);
+
+typedef void (*object_fn)(AbstractVMObject*);
+
+/**
+ * The objects that the heaps do not allocate in their regular spaces. Each
+ * of them gets memory of its own, and is marked in place, instead of being
+ * copied or compacted.
+ *
+ * Objects bigger than Threshold are mapped with mmap() and released with
+ * munmap(). The COPYING heap and the nursery of the GENERATIONAL heap
+ * allocate such objects here, instead of copying them on each collection or
+ * on promotion. The MARK_SWEEP and IMMIX heaps, and the mature space, also
+ * put the objects that are too big for their pages or blocks here, smaller
+ * ones are malloc'ed.
+ */
+class LargeObjectSpace {
+public:
+    /// The size in bytes above which objects are large, set with -lothreshold.
+    static size_t Threshold;
+
+    ~LargeObjectSpace();
+
+    /// Allocates size bytes for an object that is preceded by headerSize
+    /// bytes. The header starts at an address that is a multiple of
+    /// alignment, if one is given.
+    AbstractVMObject* Allocate(size_t size, size_t headerSize = 0,
+                               size_t alignment = 0);
+
+    /// Records which objects exist, only those can be freed by the next
+    /// Sweep(). Objects that are allocated while marking survive it.
+    void StartMarking();
+
+    /// Frees the objects for which sweep returns false.
+    void Sweep(sweep_fn sweep);
+
+    void ForEachObject(object_fn fn) const;
+
+    /// The bytes of all objects, without their headers.
+    [[nodiscard]] inline size_t GetSize() const { return size; }
+
+private:
+    struct LargeObject {
+        void* memory;
+
+        // 0 if the memory was malloc'ed
+        size_t mappedSize;
+
+        AbstractVMObject* object;
+        size_t size;
+    };
+
+    static void release(const LargeObject& large);
+
+    std::vector<LargeObject> objects;
+    size_t objectsInSnapshot{0};
+    size_t size{0};
+};
@@ -1,7 +1,6 @@
 #include "MarkSweepCollector.h"
 
 #include <cstddef>
-#include <vector>
 
 #include "../memory/Heap.h"
 #include "../misc/debug.h"
@@ -10,10 +9,40 @@
 #include "../vmobjects/IntegerBox.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMFrame.h"
+#include "../vmobjects/VMMethod.h"
 #include "MarkSweepHeap.h"
+#include "ParallelMarker.h"
+
+#ifdef INCREMENTAL_MARKING
+  #include "IncrementalMarker.h"
+#endif
 
 #define GC_MARKED 3456
 
+#ifdef INCREMENTAL_MARKING
+  // the bytes allocated in between two slices of incremental marking
+  #define INCREMENTAL_MARK_INTERVAL ((size_t)256 * 1024U)  // 256 KB
+#endif
+
+static bool try_mark_object(AbstractVMObject* obj) {
+    if (obj->GetGCField() != 0) {
+        return false;
+    }
+    return obj->CompareAndSetGCField(0, GC_MARKED);
+}
+
+static bool sweep_object(AbstractVMObject* obj) {
+    if (obj->GetGCField() == GC_MARKED) {
+        obj->SetGCField(0);
+        return true;
+    }
+    return false;
+}
+
+static AbstractVMObject* survivor(AbstractVMObject* obj) {
+    return obj->GetGCField() == GC_MARKED ? obj : nullptr;
+}
+
 void MarkSweepCollector::Collect() {
     DebugLog("MarkSweep Collect\n");
 
@@ -22,55 +51,47 @@ void MarkSweepCollector::Collect() {
     // reset collection trigger
     heap->resetGCTrigger();
 
-    // now mark all reachables
-    markReachableObjects();
-
-    // in this survivors stack we will remember all objects that survived
-    auto* survivors = new vector<AbstractVMObject*>();
-    size_t survivorsSize = 0;
-
-    vector<AbstractVMObject*>::iterator iter;
-    for (iter = heap->allocatedObjects->begin();
-         iter != heap->allocatedObjects->end();
-         iter++) {
-        if ((*iter)->GetGCField() == GC_MARKED) {
-            // object ist marked -> let it survive
-            survivors->push_back(*iter);
-            survivorsSize += (*iter)->GetObjectSize();
-            (*iter)->SetGCField(0);
-        } else {
-            // not marked -> kill it
-            heap->FreeObject(*iter);
-        }
+#ifdef INCREMENTAL_MARKING
+    if (!IncrementalMarker::IsMarking()) {
+        heap->finishSweeping();
+        heap->objects.StartMarking();
+        VMMethod::SnapshotOwnersOfNativeMemory();
+        collectionLimitAtStart = heap->collectionLimit;
+        IncrementalMarker::Start(&try_mark_object);
     }
 
-    delete heap->allocatedObjects;
-    heap->allocatedObjects = survivors;
-
-    heap->spcAlloc = survivorsSize;
-    // TODO(smarr): Maybe choose another constant to calculate new
-    // collectionLimit here
-    heap->collectionLimit = 2 * survivorsSize;
-    Timer::GCTimer.Halt();
-}
-
-static gc_oop_t mark_object(gc_oop_t oop) {
-    if (IS_TAGGED(oop)) {
-        return oop;
+    // the next slice is due after allocating INCREMENTAL_MARK_INTERVAL bytes.
+    // If the mutator allocates much faster than marking proceeds, the rest is
+    // marked at once.
+    bool const done = IncrementalMarker::Step(INCREMENTAL_MARK_SLICE);
+    if (!done && heap->spcAlloc < 2 * collectionLimitAtStart) {
+        heap->collectionLimit = heap->spcAlloc + INCREMENTAL_MARK_INTERVAL;
+        Timer::GCTimer.Halt();
+        heap->sizingPolicy.RecordCollection();
+        return;
     }
+    IncrementalMarker::Finish();
+#else
+    heap->finishSweeping();
+    heap->objects.StartMarking();
+    VMMethod::SnapshotOwnersOfNativeMemory();
 
-    AbstractVMObject* obj = AS_OBJ(oop);
-
-    if (obj->GetGCField() != 0) {
-        return oop;
-    }
+    // now mark all reachables
+    markReachableObjects();
+#endif
 
-    obj->SetGCField(GC_MARKED);
-    obj->WalkObjects(mark_object);
-    return oop;
+    // the unmarked objects are freed lazily, and the collection limit is set
+    // once the surviving ones are known
+    VMMethod::SweepNativeMemory(&survivor, true);
+    heap->objects.StartSweeping(&sweep_object);
+    heap->spcAlloc = 0;
+    heap->collectionLimit = 0;
+    heap->survivorsCounted = false;
+    Timer::GCTimer.Halt();
+    heap->sizingPolicy.RecordCollection();
 }
 
 void MarkSweepCollector::markReachableObjects() {
     // This walks the globals of the universe, and the interpreter
-    Universe::WalkGlobals(mark_object);
+    ParallelMarker::MarkReachableObjects(&try_mark_object);
 }
@@ -11,4 +11,8 @@ public:
 
 private:
     static void markReachableObjects();
+
+#ifdef INCREMENTAL_MARKING
+    size_t collectionLimitAtStart{0};
+#endif
 };
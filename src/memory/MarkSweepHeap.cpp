@@ -1,35 +1,67 @@
 #include "MarkSweepHeap.h"
 
-#include <cstdlib>
+#include <cstddef>
 #include <cstring>
-#include <string>
-#include <vector>
 
 #include "../memory/Heap.h"
-#include "../vm/Print.h"
 #include "../vmobjects/AbstractObject.h"
+#include "HeapSizingPolicy.h"
 #include "MarkSweepCollector.h"
+#include "SizeClassAllocator.h"
+
+// while the objects that survived the last collection are swept lazily, this
+// many pages are swept each time the given number of bytes was allocated
+#define LAZY_SWEEP_INTERVAL ((size_t)64 * 1024U)  // 64 KB
+#define LAZY_SWEEP_PAGES ((size_t)16U)
 
 MarkSweepHeap::MarkSweepHeap(size_t objectSpaceSize)
     : Heap<MarkSweepHeap>(new MarkSweepCollector(this)),
-      allocatedObjects(new vector<AbstractVMObject*>()),
       // our initial collection limit is 90% of objectSpaceSize
-      collectionLimit((size_t)((double)objectSpaceSize * 0.9)) {}
+      collectionLimit((size_t)((double)objectSpaceSize * 0.9)),
+      sizingPolicy(collectionLimit) {}
 
 AbstractVMObject* MarkSweepHeap::AllocateObject(size_t size) {
-    auto* newObject = (AbstractVMObject*)malloc(size);
-    if (newObject == nullptr) {
-        ErrorPrint("\nFailed to allocate " + to_string(size) + " Bytes.\n");
-        Quit(-1);
-    }
+    AbstractVMObject* newObject = objects.Allocate(size);
     spcAlloc += size;
     memset((void*)newObject, 0, size);
     // AbstractObjects (Integer,...) have no Size field anymore -> set within
     // VMObject's new operator
-    allocatedObjects->push_back(newObject);
     // let's see if we have to trigger the GC
     if (spcAlloc >= collectionLimit) {
-        requestGC();
+        collectionLimitReached();
     }
     return newObject;
 }
+
+void MarkSweepHeap::collectionLimitReached() {
+    if (!survivorsCounted) {
+        // the collection limit depends on the surviving bytes, which are only
+        // known once all pages are swept. Until then, a few pages are swept
+        // each time another LAZY_SWEEP_INTERVAL bytes were allocated.
+        objects.Sweep(LAZY_SWEEP_PAGES);
+        if (objects.IsSweeping()) {
+            collectionLimit = spcAlloc + LAZY_SWEEP_INTERVAL;
+            return;
+        }
+
+        countSurvivors();
+        if (spcAlloc < collectionLimit) {
+            return;
+        }
+    }
+    requestGC();
+}
+
+void MarkSweepHeap::countSurvivors() {
+    survivorsCounted = true;
+    spcAlloc += objects.GetSurvivingBytes();
+    collectionLimit = sizingPolicy.NextHeapSize(objects.GetSurvivingBytes());
+    objects.ReleaseMemory(collectionLimit);
+}
+
+void MarkSweepHeap::finishSweeping() {
+    if (!survivorsCounted) {
+        objects.FinishSweeping();
+        countSurvivors();
+    }
+}
@@ -2,6 +2,8 @@
 
 #include "../misc/defs.h"
 #include "Heap.h"
+#include "HeapSizingPolicy.h"
+#include "SizeClassAllocator.h"
 
 class MarkSweepHeap : public Heap<MarkSweepHeap> {
     friend class MarkSweepCollector;
@@ -11,7 +13,19 @@ public:
     AbstractVMObject* AllocateObject(size_t size);
 
 private:
-    vector<AbstractVMObject*>* allocatedObjects;
+    void collectionLimitReached();
+    void countSurvivors();
+
+    /// Completes the lazy sweep of the last collection.
+    void finishSweeping();
+
+    SizeClassAllocator objects;
+
+    // the bytes that were allocated since the last collection, plus the ones
+    // that survived it, once they are counted
     size_t spcAlloc{0};
     size_t collectionLimit;
+    bool survivorsCounted{true};
+
+    HeapSizingPolicy sizingPolicy;
 };
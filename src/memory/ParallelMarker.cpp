@@ -0,0 +1,304 @@
+#include "ParallelMarker.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../misc/defs.h"
+#include "../vm/Universe.h"
+#include "../vmobjects/AbstractObject.h"
+#include "../vmobjects/IntegerBox.h"
+#include "../vmobjects/ObjectFormats.h"
+
+#define MARK_DEQUE_INITIAL_CAPACITY ((size_t)1024U)
+
+MarkDeque::Buffer::Buffer(size_t capacity)
+    : capacity(capacity),
+      slots(new std::atomic<AbstractVMObject*>[capacity]) {}
+
+MarkDeque::Buffer::~Buffer() {
+    delete[] slots;
+}
+
+MarkDeque::MarkDeque() : buffer(new Buffer(MARK_DEQUE_INITIAL_CAPACITY)) {}
+
+MarkDeque::~MarkDeque() {
+    FreeRetiredBuffers();
+    delete buffer.load(std::memory_order_relaxed);
+}
+
+MarkDeque::Buffer* MarkDeque::grow(Buffer* old, int64_t t, int64_t b) {
+    auto* newBuffer = new Buffer(2 * old->capacity);
+    for (int64_t i = t; i < b; i += 1) {
+        newBuffer->Put(i, old->Get(i));
+    }
+    retired.push_back(old);
+    buffer.store(newBuffer, std::memory_order_release);
+    return newBuffer;
+}
+
+void MarkDeque::Push(AbstractVMObject* obj) {
+    int64_t const b = bottom.load(std::memory_order_relaxed);
+    int64_t const t = top.load(std::memory_order_acquire);
+    Buffer* buf = buffer.load(std::memory_order_relaxed);
+    if (b - t > (int64_t)buf->capacity - 1) {
+        buf = grow(buf, t, b);
+    }
+    buf->Put(b, obj);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+AbstractVMObject* MarkDeque::Pop() {
+    int64_t const b = bottom.load(std::memory_order_relaxed) - 1;
+    Buffer* buf = buffer.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    AbstractVMObject* obj = buf->Get(b);
+    if (t == b) {
+        // the last object, which a thief might take at the same time
+        if (!top.compare_exchange_strong(t,
+                                         t + 1,
+                                         std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            obj = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return obj;
+}
+
+AbstractVMObject* MarkDeque::Steal() {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t const b = bottom.load(std::memory_order_acquire);
+
+    if (t >= b) {
+        return nullptr;
+    }
+
+    Buffer* buf = buffer.load(std::memory_order_acquire);
+    AbstractVMObject* obj = buf->Get(t);
+    if (!top.compare_exchange_strong(t,
+                                     t + 1,
+                                     std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return obj;
+}
+
+void MarkDeque::FreeRetiredBuffers() {
+    for (Buffer* buf : retired) {
+        delete buf;
+    }
+    retired.clear();
+}
+
+std::vector<MarkDeque*> ParallelMarker::deques;
+std::atomic<size_t> ParallelMarker::activeWorkers{0};
+
+static std::vector<std::thread> helpers;
+static std::mutex helpersMutex;
+static std::condition_variable collectionStarted;
+static std::condition_variable helpersFinished;
+static size_t collection = 0;
+static size_t runningHelpers = 0;
+static bool shuttingDown = false;
+
+static try_mark_fn tryMarkObject = nullptr;
+static thread_local MarkDeque* markDeque = nullptr;
+
+// marking with a single thread does not need the synchronization of the
+// deques
+static std::vector<AbstractVMObject*> markStack;
+
+static gc_oop_t markReferenceSerially(gc_oop_t oop) {
+    if (IS_TAGGED(oop)) {
+        return oop;
+    }
+
+    AbstractVMObject* obj = AS_OBJ(oop);
+    if (tryMarkObject(obj)) {
+        markStack.push_back(obj);
+    }
+    return oop;
+}
+
+static gc_oop_t markReference(gc_oop_t oop) {
+    if (IS_TAGGED(oop)) {
+        return oop;
+    }
+
+    AbstractVMObject* obj = AS_OBJ(oop);
+    if (tryMarkObject(obj)) {
+        markDeque->Push(obj);
+    }
+    return oop;
+}
+
+void ParallelMarker::Initialize(size_t numThreads) {
+    if (numThreads == 1) {
+        return;
+    }
+
+    for (size_t i = 0; i < numThreads; i += 1) {
+        deques.push_back(new MarkDeque());
+    }
+    for (size_t i = 1; i < numThreads; i += 1) {
+        helpers.emplace_back(&ParallelMarker::helperLoop, i);
+    }
+}
+
+void ParallelMarker::Destroy() {
+    {
+        std::lock_guard<std::mutex> const lock(helpersMutex);
+        shuttingDown = true;
+    }
+    collectionStarted.notify_all();
+
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+    helpers.clear();
+
+    for (MarkDeque* deque : deques) {
+        delete deque;
+    }
+    deques.clear();
+}
+
+void ParallelMarker::helperLoop(size_t worker) {
+    size_t lastCollection = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(helpersMutex);
+            collectionStarted.wait(lock, [&] {
+                return shuttingDown || collection != lastCollection;
+            });
+            if (shuttingDown) {
+                return;
+            }
+            lastCollection = collection;
+        }
+
+        drain(worker);
+
+        {
+            std::lock_guard<std::mutex> const lock(helpersMutex);
+            runningHelpers -= 1;
+            if (runningHelpers == 0) {
+                helpersFinished.notify_one();
+            }
+        }
+    }
+}
+
+AbstractVMObject* ParallelMarker::steal(size_t worker) {
+    size_t const numWorkers = deques.size();
+    for (size_t i = 1; i < numWorkers; i += 1) {
+        AbstractVMObject* obj = deques[(worker + i) % numWorkers]->Steal();
+        if (obj != nullptr) {
+            return obj;
+        }
+    }
+    return nullptr;
+}
+
+bool ParallelMarker::hasWork() {
+    for (MarkDeque* deque : deques) {
+        if (!deque->IsEmpty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Each object is walked by the thread that marked it. WalkObjects() writes the
+// references back unchanged, while other threads may read them, e.g., in
+// IsValidObject(), which is benign, because marking does not move objects.
+void ParallelMarker::drain(size_t worker) {
+    markDeque = deques[worker];
+
+    AbstractVMObject* obj = nullptr;
+    while (true) {
+        while ((obj = markDeque->Pop()) != nullptr) {
+            obj->WalkObjects(&markReference);
+        }
+
+        obj = steal(worker);
+        if (obj != nullptr) {
+            obj->WalkObjects(&markReference);
+            continue;
+        }
+
+        // only active workers push objects. Thus, marking is done once no
+        // worker is active anymore. Idle workers become active again before
+        // they steal, so that a stolen object is always accounted for.
+        activeWorkers.fetch_sub(1);
+        while (true) {
+            if (activeWorkers.load() == 0) {
+                return;
+            }
+            if (hasWork()) {
+                activeWorkers.fetch_add(1);
+                obj = steal(worker);
+                if (obj != nullptr) {
+                    break;
+                }
+                activeWorkers.fetch_sub(1);
+            }
+            std::this_thread::yield();
+        }
+        obj->WalkObjects(&markReference);
+    }
+}
+
+void ParallelMarker::MarkReachableObjects(try_mark_fn tryMark) {
+    tryMarkObject = tryMark;
+
+    if (deques.empty()) {
+        Universe::WalkGlobals(&markReferenceSerially);
+        while (!markStack.empty()) {
+            AbstractVMObject* obj = markStack.back();
+            markStack.pop_back();
+            obj->WalkObjects(&markReferenceSerially);
+        }
+        return;
+    }
+
+    // the roots are pushed onto the deque of this thread, the others start
+    // by stealing them
+    markDeque = deques[0];
+    Universe::WalkGlobals(&markReference);
+
+    activeWorkers.store(deques.size());
+    {
+        std::lock_guard<std::mutex> const lock(helpersMutex);
+        collection += 1;
+        runningHelpers = helpers.size();
+    }
+    collectionStarted.notify_all();
+
+    drain(0);
+
+    {
+        std::unique_lock<std::mutex> lock(helpersMutex);
+        helpersFinished.wait(lock, [] { return runningHelpers == 0; });
+    }
+
+    for (MarkDeque* deque : deques) {
+        deque->FreeRetiredBuffers();
+    }
+}
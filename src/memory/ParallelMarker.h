@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../misc/defs.h"
+#include "../vmobjects/ObjectFormats.h"
+
+/// Marks the object atomically, and returns whether it was unmarked before.
+typedef bool (*try_mark_fn)(AbstractVMObject*);
+
+/**
+ * A work-stealing deque after Chase and Lev (SPAA'05), with the memory
+ * ordering of Lê et al. (PPoPP'13).
+ *
+ * The owning thread pushes and pops objects at the bottom, other threads
+ * steal them from the top.
+ */
+class MarkDeque {
+public:
+    MarkDeque();
+    ~MarkDeque();
+
+    void Push(AbstractVMObject* obj);
+
+    /// Returns the object at the bottom, or nullptr if the deque is empty.
+    AbstractVMObject* Pop();
+
+    /// Returns the object at the top, or nullptr if the deque is empty, or
+    /// another thread took the object first.
+    AbstractVMObject* Steal();
+
+    [[nodiscard]] inline bool IsEmpty() const {
+        return top.load(std::memory_order_acquire) >=
+               bottom.load(std::memory_order_acquire);
+    }
+
+    /// Frees the buffers that were replaced while growing the deque, which
+    /// other threads might still read from while marking.
+    void FreeRetiredBuffers();
+
+private:
+    struct Buffer {
+        explicit Buffer(size_t capacity);
+        ~Buffer();
+
+        size_t const capacity;
+        std::atomic<AbstractVMObject*>* const slots;
+
+        [[nodiscard]] inline AbstractVMObject* Get(int64_t i) const {
+            return slots[(size_t)i & (capacity - 1)].load(
+                std::memory_order_relaxed);
+        }
+        inline void Put(int64_t i, AbstractVMObject* obj) {
+            slots[(size_t)i & (capacity - 1)].store(obj,
+                                                    std::memory_order_relaxed);
+        }
+    };
+
+    Buffer* grow(Buffer* old, int64_t top, int64_t bottom);
+
+    std::atomic<int64_t> top{0};
+    std::atomic<int64_t> bottom{0};
+    std::atomic<Buffer*> buffer;
+    std::vector<Buffer*> retired;
+};
+
+/**
+ * Marks the objects that are reachable from the globals of the universe and
+ * the interpreter, with an explicit mark stack instead of recursion.
+ *
+ * With several GC threads, each thread has a MarkDeque. The roots are pushed
+ * by the thread that started the collection, and the other threads steal
+ * from it, and from each other, until all deques are empty. The helper
+ * threads are started once, and wait for the next collection in between.
+ * A single thread marks with a plain stack instead.
+ */
+class ParallelMarker {
+public:
+    static void Initialize(size_t numThreads);
+    static void Destroy();
+
+    static void MarkReachableObjects(try_mark_fn tryMark);
+
+private:
+    static void helperLoop(size_t worker);
+    static void drain(size_t worker);
+    static AbstractVMObject* steal(size_t worker);
+    static bool hasWork();
+
+    static std::vector<MarkDeque*> deques;
+    static std::atomic<size_t> activeWorkers;
+};
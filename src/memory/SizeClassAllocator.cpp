@@ -0,0 +1,363 @@
+#include "SizeClassAllocator.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifdef __GLIBC__
+  #include <malloc.h>
+#endif
+
+#include "../misc/defs.h"
+#include "../vm/Print.h"
+#include "../vmobjects/AbstractObject.h"
+
+SizeClassAllocator::SizeClassAllocator(size_t (*headerSizeFor)(size_t))
+    : headerSizeFor(headerSizeFor) {
+    // the classes are closer together for small objects, which are the most
+    // common ones, and the waste of each cell is bounded by 1/8 of its size
+    size_t size = SIZE_CLASS_MIN_CELL_SIZE;
+    while (size <= SIZE_CLASS_MAX_OBJECT_SIZE) {
+        objectSizes.push_back(size);
+        if (size < 128) {
+            size += 8;
+        } else if (size < 256) {
+            size += 16;
+        } else if (size < 1024) {
+            size += 64;
+        } else {
+            size += 256;
+        }
+    }
+
+    size_t sizeClass = 0;
+    for (size_t i = 0; i <= SIZE_CLASS_MAX_OBJECT_SIZE / 8; i += 1) {
+        while (objectSizes[sizeClass] < i * 8) {
+            sizeClass += 1;
+        }
+        sizeClassOfSize[i] = (uint8_t)sizeClass;
+    }
+
+    currentPages.resize(objectSizes.size(), nullptr);
+    pages.resize(objectSizes.size());
+    nextPages.resize(objectSizes.size(), 0);
+}
+
+SizeClassAllocator::~SizeClassAllocator() {
+    for (std::vector<SizeClassPage*>& pagesOfClass : pages) {
+        for (SizeClassPage* page : pagesOfClass) {
+            free(page);
+        }
+    }
+    for (SizeClassPage* page : emptyPages) {
+        free(page);
+    }
+}
+
+static size_t osPageSize() {
+    static size_t const pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    return pageSize;
+}
+
+SizeClassPage* SizeClassAllocator::newPage(size_t sizeClass) {
+    SizeClassPage* page = nullptr;
+    if (emptyPages.empty()) {
+        // the pages are aligned to the OS pages, so that their memory can be
+        // released
+        page = (SizeClassPage*)aligned_alloc(osPageSize(), SIZE_CLASS_PAGE_SIZE);
+        if (page == nullptr) {
+            ErrorExit("unable to allocate heap memory");
+        }
+        numPages += 1;
+    } else {
+        page = emptyPages.back();
+        emptyPages.pop_back();
+        reusePage(page);
+    }
+
+    size_t const objectSize = objectSizes[sizeClass];
+    size_t const objectOffset =
+        headerSizeFor == nullptr ? 0 : headerSizeFor(objectSize);
+
+    memset((void*)page, 0, sizeof(SizeClassPage));
+    page->sizeClass = sizeClass;
+    page->cellSize = objectOffset + objectSize;
+    page->numCells =
+        (SIZE_CLASS_PAGE_SIZE - (size_t)(page->Cells() - (uint8_t*)page)) /
+        page->cellSize;
+    page->objectOffset = objectOffset;
+    return page;
+}
+
+AbstractVMObject* SizeClassAllocator::allocateFromNextPage(size_t sizeClass) {
+    std::vector<SizeClassPage*>& pagesOfClass = pages[sizeClass];
+
+    // the pages that were not swept yet are swept now, before their free
+    // cells are used
+    while (nextPages[sizeClass] < pagesOfClass.size()) {
+        SizeClassPage* page = pagesOfClass[nextPages[sizeClass]];
+        nextPages[sizeClass] += 1;
+
+        if (page->needsSweeping) {
+            sweepPage(page);
+        }
+        if (page->numAllocated < page->numCells) {
+            reusePage(page);
+            page->nextCell = 0;
+            currentPages[sizeClass] = page;
+            return page->TakeFreeCell();
+        }
+    }
+
+    SizeClassPage* page = newPage(sizeClass);
+    pagesOfClass.push_back(page);
+    nextPages[sizeClass] = pagesOfClass.size();
+    currentPages[sizeClass] = page;
+    return page->TakeFreeCell();
+}
+
+AbstractVMObject* SizeClassAllocator::allocateLarge(size_t size) {
+    size_t const headerSize =
+        headerSizeFor == nullptr ? 0 : headerSizeFor(size);
+    return largeObjects.Allocate(size, headerSize);
+}
+
+void SizeClassAllocator::sweepPage(SizeClassPage* page) {
+    assert(page->needsSweeping);
+    page->needsSweeping = false;
+
+    size_t numAllocated = 0;
+    for (size_t word = 0; word < SIZE_CLASS_BITMAP_WORDS; word += 1) {
+        uint64_t bits = page->allocated[word];
+        while (bits != 0) {
+            size_t const bit = __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            uint64_t const mask = (uint64_t)1 << bit;
+            bool const survives =
+                sweepObject(page->ObjectAt((word * 64) + bit)) ||
+                (page->inSnapshot[word] & mask) == 0;
+            if (survives) {
+                numAllocated += 1;
+            } else {
+                page->allocated[word] &= ~mask;
+            }
+        }
+    }
+
+    page->numAllocated = numAllocated;
+    survivingBytes += numAllocated * page->cellSize;
+}
+
+void SizeClassAllocator::StartSweeping(sweep_fn sweep) {
+    assert(!IsSweeping());
+    sweepObject = sweep;
+
+    largeObjects.Sweep(sweep);
+    survivingBytes = largeObjects.GetSize();
+
+    pagesToSweep.clear();
+    sweptPages = 0;
+    for (size_t sizeClass = 0; sizeClass < pages.size(); sizeClass += 1) {
+        for (SizeClassPage* page : pages[sizeClass]) {
+            page->needsSweeping = true;
+            pagesToSweep.push_back(page);
+        }
+        currentPages[sizeClass] = nullptr;
+        nextPages[sizeClass] = 0;
+    }
+}
+
+void SizeClassAllocator::Sweep(size_t numPages) {
+    while (numPages > 0 && IsSweeping()) {
+        SizeClassPage* page = pagesToSweep[sweptPages];
+        sweptPages += 1;
+        if (page->needsSweeping) {
+            sweepPage(page);
+            numPages -= 1;
+        }
+    }
+}
+
+void SizeClassAllocator::FinishSweeping() {
+    Sweep(pagesToSweep.size());
+}
+
+void SizeClassAllocator::StartMarking() {
+    FinishSweeping();
+
+    for (size_t sizeClass = 0; sizeClass < pages.size(); sizeClass += 1) {
+        std::vector<SizeClassPage*>& pagesOfClass = pages[sizeClass];
+
+        // the empty pages, other than the one that is allocated from, are
+        // available for all size classes again
+        size_t kept = 0;
+        size_t nextPage = 0;
+        for (size_t i = 0; i < pagesOfClass.size(); i += 1) {
+            SizeClassPage* page = pagesOfClass[i];
+            if (page->numAllocated == 0 && page != currentPages[sizeClass]) {
+                emptyPages.push_back(page);
+                continue;
+            }
+            if (i < nextPages[sizeClass]) {
+                nextPage = kept + 1;
+            }
+            memcpy(page->inSnapshot, page->allocated, sizeof(page->allocated));
+            pagesOfClass[kept] = page;
+            kept += 1;
+        }
+        pagesOfClass.resize(kept);
+        nextPages[sizeClass] = nextPage;
+    }
+
+    largeObjects.StartMarking();
+}
+
+static void forEachObjectOfPage(SizeClassPage* page, object_fn fn) {
+    for (size_t word = 0; word < SIZE_CLASS_BITMAP_WORDS; word += 1) {
+        uint64_t bits = page->allocated[word];
+        while (bits != 0) {
+            size_t const bit = __builtin_ctzll(bits);
+            bits &= bits - 1;
+            fn(page->ObjectAt((word * 64) + bit));
+        }
+    }
+}
+
+double SizeClassAllocator::GetFragmentation() const {
+    if (numPages == 0) {
+        return 0.0;
+    }
+
+    size_t neededPages = 0;
+    for (const std::vector<SizeClassPage*>& pagesOfClass : pages) {
+        if (pagesOfClass.empty()) {
+            continue;
+        }
+        size_t numObjects = 0;
+        for (SizeClassPage* page : pagesOfClass) {
+            numObjects += page->numAllocated;
+        }
+        size_t const numCells = pagesOfClass[0]->numCells;
+        neededPages += (numObjects + numCells - 1) / numCells;
+    }
+    return 1.0 - ((double)neededPages / (double)numPages);
+}
+
+void SizeClassAllocator::StartEvacuation() {
+    assert(!IsSweeping());
+    assert(evacuatedPages.empty());
+
+    for (size_t sizeClass = 0; sizeClass < pages.size(); sizeClass += 1) {
+        std::vector<SizeClassPage*>& pagesOfClass = pages[sizeClass];
+        if (pagesOfClass.empty()) {
+            continue;
+        }
+
+        // the fullest pages are kept, their free cells suffice for the
+        // objects of the others
+        std::sort(pagesOfClass.begin(), pagesOfClass.end(),
+                  [](const SizeClassPage* a, const SizeClassPage* b) {
+                      return a->numAllocated > b->numAllocated;
+                  });
+
+        size_t numObjects = 0;
+        for (SizeClassPage* page : pagesOfClass) {
+            numObjects += page->numAllocated;
+        }
+        size_t const numCells = pagesOfClass[0]->numCells;
+        size_t const keptPages = (numObjects + numCells - 1) / numCells;
+
+        evacuatedPages.insert(evacuatedPages.end(),
+                              pagesOfClass.begin() + (ptrdiff_t)keptPages,
+                              pagesOfClass.end());
+        pagesOfClass.resize(keptPages);
+        currentPages[sizeClass] = nullptr;
+        nextPages[sizeClass] = 0;
+    }
+}
+
+void SizeClassAllocator::ForEachEvacuatedObject(object_fn fn) const {
+    for (SizeClassPage* page : evacuatedPages) {
+        forEachObjectOfPage(page, fn);
+    }
+}
+
+void SizeClassAllocator::ForEachObject(object_fn fn) const {
+    for (const std::vector<SizeClassPage*>& pagesOfClass : pages) {
+        for (SizeClassPage* page : pagesOfClass) {
+            forEachObjectOfPage(page, fn);
+        }
+    }
+    largeObjects.ForEachObject(fn);
+}
+
+void SizeClassAllocator::FinishEvacuation() {
+    for (SizeClassPage* page : evacuatedPages) {
+        reusePage(page);
+        free(page);
+    }
+    for (SizeClassPage* page : emptyPages) {
+        reusePage(page);
+        free(page);
+    }
+    numPages -= evacuatedPages.size() + emptyPages.size();
+    evacuatedPages.clear();
+    emptyPages.clear();
+
+#ifdef __GLIBC__
+    // the pages are too small to be mapped by malloc() individually, their
+    // memory is only given back to the system when asked for
+    malloc_trim(0);
+#endif
+}
+
+void SizeClassAllocator::releasePage(SizeClassPage* page) {
+    assert(page->numAllocated == 0);
+
+    // the header stays, the cells in the first OS page are not released
+    uint8_t* start = (uint8_t*)page + osPageSize();
+    uint8_t* end = (uint8_t*)page + SIZE_CLASS_PAGE_SIZE;
+    if (start < end) {
+        madvise(start, end - start, MADV_DONTNEED);
+    }
+    page->released = true;
+    numReleasedPages += 1;
+}
+
+void SizeClassAllocator::reusePage(SizeClassPage* page) {
+    // the released memory is mapped again, zeroed, when it is written to
+    if (page->released) {
+        page->released = false;
+        numReleasedPages -= 1;
+    }
+}
+
+void SizeClassAllocator::ReleaseMemory(size_t keptBytes) {
+    assert(!IsSweeping());
+
+    size_t const keptPages = keptBytes / SIZE_CLASS_PAGE_SIZE;
+    auto releaseIfNeeded = [&](SizeClassPage* page) {
+        if (numPages - numReleasedPages > keptPages && !page->released) {
+            releasePage(page);
+        }
+    };
+
+    for (SizeClassPage* page : emptyPages) {
+        releaseIfNeeded(page);
+    }
+    for (size_t sizeClass = 0; sizeClass < pages.size(); sizeClass += 1) {
+        for (SizeClassPage* page : pages[sizeClass]) {
+            if (page->numAllocated == 0 && page != currentPages[sizeClass]) {
+                releaseIfNeeded(page);
+            }
+        }
+    }
+}
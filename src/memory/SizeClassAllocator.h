@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../misc/defs.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "LargeObjectSpace.h"
+
+// objects up to SIZE_CLASS_MAX_OBJECT_SIZE bytes are allocated in pages, which
+// hold cells of a single size class. Larger objects are allocated in the
+// large-object space.
+#define SIZE_CLASS_PAGE_SIZE ((size_t)64 * 1024U)  // 64 KB
+#define SIZE_CLASS_MAX_OBJECT_SIZE ((size_t)2048U)
+#define SIZE_CLASS_MIN_CELL_SIZE ((size_t)16U)
+#define SIZE_CLASS_BITMAP_WORDS \
+    (SIZE_CLASS_PAGE_SIZE / SIZE_CLASS_MIN_CELL_SIZE / 64)
+
+/**
+ * The header at the start of each page. One bit per cell records whether the
+ * cell is allocated, and thus, the bitmap is also the free list.
+ */
+struct SizeClassPage {
+    size_t sizeClass;
+    size_t cellSize;
+    size_t numCells;
+    size_t numAllocated;
+
+    // the bytes in front of each object, e.g., for a card table
+    size_t objectOffset;
+
+    // the cell from which allocation searches for the next free one
+    size_t nextCell;
+
+    bool needsSweeping;
+
+    // the memory after the page's first OS page was given back to the system
+    bool released;
+
+    uint64_t allocated[SIZE_CLASS_BITMAP_WORDS];
+
+    // the cells that were allocated when marking started. Only those can be
+    // freed by the sweep, the others were allocated while marking.
+    uint64_t inSnapshot[SIZE_CLASS_BITMAP_WORDS];
+
+    [[nodiscard]] inline uint8_t* Cells() {
+        return (uint8_t*)this + ((sizeof(SizeClassPage) + 15) & ~(size_t)15);
+    }
+
+    [[nodiscard]] inline AbstractVMObject* ObjectAt(size_t cell) {
+        return (AbstractVMObject*)(Cells() + (cell * cellSize) + objectOffset);
+    }
+
+    inline AbstractVMObject* TakeFreeCell() {
+        while (nextCell < numCells) {
+            size_t const word = nextCell / 64;
+            uint64_t const free =
+                ~allocated[word] & (~(uint64_t)0 << (nextCell % 64));
+            if (free == 0) {
+                nextCell = (word + 1) * 64;
+                continue;
+            }
+
+            size_t const cell = (word * 64) + __builtin_ctzll(free);
+            if (cell >= numCells) {
+                break;
+            }
+            allocated[word] |= (uint64_t)1 << (cell % 64);
+            numAllocated += 1;
+            nextCell = cell + 1;
+            return ObjectAt(cell);
+        }
+        nextCell = numCells;
+        return nullptr;
+    }
+};
+
+/**
+ * A segregated-fit allocator for the objects of the MARK_SWEEP heap, and the
+ * mature objects of the GENERATIONAL heap.
+ *
+ * Each size class allocates from one page at a time, by searching the page's
+ * bitmap for free cells. The collectors mark objects as before. Afterwards,
+ * StartSweeping() only flags the pages. Each page is swept lazily, when
+ * allocation reaches it, or when Sweep() is called, by walking the set bits of
+ * its bitmap, and clearing the ones of the dead objects. Dead objects are not
+ * freed individually. Pages that became empty are given to other size classes
+ * when the next marking starts.
+ *
+ * Since objects are not moved, the pages of a size class can end up sparsely
+ * populated. A compacting collector can therefore evacuate the sparsest pages
+ * of each class into the free cells of the others, and release them.
+ */
+class SizeClassAllocator {
+public:
+    /// headerSizeFor returns the bytes that need to precede an object of the
+    /// given size, or is nullptr if there are none.
+    explicit SizeClassAllocator(size_t (*headerSizeFor)(size_t) = nullptr);
+    ~SizeClassAllocator();
+
+    inline AbstractVMObject* Allocate(size_t size) {
+        if (likely(size <= SIZE_CLASS_MAX_OBJECT_SIZE)) {
+            size_t const sizeClass = sizeClassOfSize[(size + 7) / 8];
+            SizeClassPage* page = currentPages[sizeClass];
+            if (likely(page != nullptr)) {
+                AbstractVMObject* newObject = page->TakeFreeCell();
+                if (likely(newObject != nullptr)) {
+                    return newObject;
+                }
+            }
+            return allocateFromNextPage(sizeClass);
+        }
+        return allocateLarge(size);
+    }
+
+    /// Completes the sweep, and records which objects are allocated now, so
+    /// that the objects allocated while marking are not freed.
+    void StartMarking();
+
+    /// Sweeps the large-object space, and flags all pages to be swept lazily,
+    /// with the given function deciding which objects survive.
+    void StartSweeping(sweep_fn sweep);
+
+    /// Sweeps up to the given number of pages that still need sweeping.
+    void Sweep(size_t numPages);
+    void FinishSweeping();
+
+    [[nodiscard]] inline bool IsSweeping() const {
+        return sweptPages < pagesToSweep.size();
+    }
+
+    /// The bytes of the objects that survived the last sweep, which is only
+    /// complete if IsSweeping() is false.
+    [[nodiscard]] inline size_t GetSurvivingBytes() const {
+        return survivingBytes;
+    }
+
+    /// The share of the pages, including the empty ones, that would be
+    /// released by evacuating the sparsest pages. Pages that were not swept
+    /// yet count with their objects before the sweep.
+    [[nodiscard]] double GetFragmentation() const;
+
+    /// Takes the sparsest pages of each size class out of allocation, as
+    /// many as the free cells of the other pages can take the objects of.
+    /// The sweep needs to be complete.
+    void StartEvacuation();
+
+    /// Calls fn for each object on the pages that are evacuated, which is
+    /// expected to move it.
+    void ForEachEvacuatedObject(object_fn fn) const;
+
+    /// Calls fn for each object that is not evacuated, including the large
+    /// ones.
+    void ForEachObject(object_fn fn) const;
+
+    /// Releases the evacuated pages, and the empty ones.
+    void FinishEvacuation();
+
+    /// Gives the memory of empty pages back to the system, until the pages
+    /// that keep theirs take at most the given number of bytes. The pages
+    /// stay allocated, and get new memory when they are used again. The
+    /// sweep needs to be complete.
+    void ReleaseMemory(size_t keptBytes);
+
+private:
+    AbstractVMObject* allocateFromNextPage(size_t sizeClass);
+    AbstractVMObject* allocateLarge(size_t size);
+    SizeClassPage* newPage(size_t sizeClass);
+    void releasePage(SizeClassPage* page);
+    void reusePage(SizeClassPage* page);
+    void sweepPage(SizeClassPage* page);
+
+    size_t (*const headerSizeFor)(size_t);
+
+    std::vector<size_t> objectSizes;
+    uint8_t sizeClassOfSize[(SIZE_CLASS_MAX_OBJECT_SIZE / 8) + 1];
+
+    std::vector<SizeClassPage*> currentPages;
+
+    // the pages of each size class, and the next one to allocate from
+    std::vector<std::vector<SizeClassPage*>> pages;
+    std::vector<size_t> nextPages;
+
+    // pages without objects, which can be used for any size class
+    std::vector<SizeClassPage*> emptyPages;
+
+    // the number of pages that are malloc'ed, and of those, the ones of which
+    // the memory was released
+    size_t numPages{0};
+    size_t numReleasedPages{0};
+
+    std::vector<SizeClassPage*> evacuatedPages;
+
+    std::vector<SizeClassPage*> pagesToSweep;
+    size_t sweptPages{0};
+    sweep_fn sweepObject{nullptr};
+    size_t survivingBytes{0};
+
+    LargeObjectSpace largeObjects;
+};
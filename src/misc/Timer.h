@@ -27,6 +27,7 @@ static int64_t get_microseconds() {
 class Timer {
 private:
     int64_t total;
+    int64_t last;
     int64_t last_start;
 
 public:
@@ -35,8 +36,12 @@ public:
     inline void Halt() {
         const int64_t end = get_microseconds();
 
-        total = end - last_start;
+        last = end - last_start;
+        total += last;
     }
 
     [[nodiscard]] double GetTotalTime() const { return (double)total / 1000.0; }
+
+    /// The time between the last Resume() and Halt().
+    [[nodiscard]] double GetLastTime() const { return (double)last / 1000.0; }
 };
@@ -68,12 +68,17 @@
 #define COPYING 2
 #define MARK_SWEEP 3
 #define DEBUG_COPYING 4
+#define IMMIX 5
 
 #if GC_TYPE == GENERATIONAL
 class GenerationalHeap;
 typedef GenerationalHeap HEAP_CLS;
   #define write_barrier(obj, value_ptr) \
       ((GetHeap<GenerationalHeap>())->writeBarrier(obj, value_ptr))
+  #ifdef CARD_MARKING
+    #define write_barrier_slot(obj, slot, value_ptr) \
+        ((GetHeap<GenerationalHeap>())->writeBarrier(obj, slot, value_ptr))
+  #endif
   #define ALLOC_MATURE , true
   #define ALLOC_OUTSIDE_NURSERY(X) , (X)
   #define ALLOC_OUTSIDE_NURSERY_DECL , bool outsideNursery = false
@@ -98,6 +103,29 @@ typedef DebugCopyingHeap HEAP_CLS;
   #define ALLOC_MATURE
   #define ALLOC_OUTSIDE_NURSERY(X)
   #define ALLOC_OUTSIDE_NURSERY_DECL
+#elif GC_TYPE == IMMIX
+class ImmixHeap;
+typedef ImmixHeap HEAP_CLS;
+  #define write_barrier(obj, value_ptr)
+  #define ALLOC_MATURE
+  #define ALLOC_OUTSIDE_NURSERY(X)
+  #define ALLOC_OUTSIDE_NURSERY_DECL
+#endif
+
+// the write barrier for a store into a known slot of the object. Only card
+// marking makes use of the slot.
+#ifndef write_barrier_slot
+  #define write_barrier_slot(obj, slot, value_ptr) \
+      write_barrier(obj, value_ptr)
+#endif
+
+// the snapshot-at-the-beginning barrier of incremental marking, which is given
+// the reference that a store into the object is about to overwrite
+#ifdef INCREMENTAL_MARKING
+  #define satb_write_barrier(obj, overwritten) \
+      IncrementalMarker::RecordOverwrittenReference(obj, overwritten)
+#else
+  #define satb_write_barrier(obj, overwritten)
 #endif
 
 //
@@ -107,6 +135,14 @@ typedef DebugCopyingHeap HEAP_CLS;
   #define USE_TAGGING false
 #endif
 
+#ifndef TAGGED_DOUBLES
+  #define TAGGED_DOUBLES false
+#endif
+
+#if TAGGED_DOUBLES && !USE_TAGGING
+  #error Immediate doubles need USE_TAGGING
+#endif
+
 #ifdef CACHE_INTEGER
   // Sanity check
   #if CACHE_INTEGER && USE_TAGGING
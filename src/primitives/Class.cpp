@@ -26,6 +26,7 @@
 
 #include "Class.h"
 
+#include "../interpreter/Interpreter.h"
 #include "../vm/Universe.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMClass.h"
@@ -34,7 +35,11 @@
 
 static vm_oop_t clsNew(vm_oop_t rcvr) {
     auto* self = static_cast<VMClass*>(rcvr);
+#if GC_TYPE == GENERATIONAL
+    return Universe::NewInstance(self, Interpreter::GetAllocationSite());
+#else
     return Universe::NewInstance(self);
+#endif
 }
 
 static vm_oop_t clsName(vm_oop_t rcvr) {
@@ -68,46 +68,43 @@ static double coerceDouble(vm_oop_t x) {
  * extract the left-hand operand as an immediate Double. Afterwards, left and
  * right are prepared for the operation.
  */
-#define PREPARE_OPERANDS                                 \
-    double const right = coerceDouble(rightObj);         \
-    VMDouble* leftObj = static_cast<VMDouble*>(leftPtr); \
-    double const left = leftObj->GetEmbeddedDouble();
+#define PREPARE_OPERANDS                         \
+    double const right = coerceDouble(rightObj); \
+    double const left = AS_DOUBLE(leftPtr);
 
 static vm_oop_t dblPlus(vm_oop_t leftPtr, vm_oop_t rightObj) {
     PREPARE_OPERANDS;
-    return Universe::NewDouble(left + right);
+    return NEW_DOUBLE(left + right);
 }
 
 static vm_oop_t dblMinus(vm_oop_t leftPtr, vm_oop_t rightObj) {
     PREPARE_OPERANDS;
-    return Universe::NewDouble(left - right);
+    return NEW_DOUBLE(left - right);
 }
 
 static vm_oop_t dblStar(vm_oop_t leftPtr, vm_oop_t rightObj) {
     PREPARE_OPERANDS;
-    return Universe::NewDouble(left * right);
+    return NEW_DOUBLE(left * right);
 }
 
 static vm_oop_t dblCos(vm_oop_t rcvr) {
-    auto* self = (VMDouble*)rcvr;
-    double const result = cos(self->GetEmbeddedDouble());
-    return Universe::NewDouble(result);
+    double const result = cos(AS_DOUBLE(rcvr));
+    return NEW_DOUBLE(result);
 }
 
 static vm_oop_t dblSin(vm_oop_t rcvr) {
-    auto* self = (VMDouble*)rcvr;
-    double const result = sin(self->GetEmbeddedDouble());
-    return Universe::NewDouble(result);
+    double const result = sin(AS_DOUBLE(rcvr));
+    return NEW_DOUBLE(result);
 }
 
 static vm_oop_t dblSlashslash(vm_oop_t leftPtr, vm_oop_t rightObj) {
     PREPARE_OPERANDS;
-    return Universe::NewDouble(left / right);
+    return NEW_DOUBLE(left / right);
 }
 
 vm_oop_t dblPercent(vm_oop_t leftPtr, vm_oop_t rightObj) {
     PREPARE_OPERANDS;
-    return Universe::NewDouble((double)((int64_t)left % (int64_t)right));
+    return NEW_DOUBLE((double)((int64_t)left % (int64_t)right));
 }
 
 /*
@@ -131,9 +128,7 @@ static vm_oop_t dblLowerthan(vm_oop_t leftPtr, vm_oop_t rightObj) {
 }
 
 static vm_oop_t dblAsString(vm_oop_t rcvr) {
-    auto* self = static_cast<VMDouble*>(rcvr);
-
-    double const dbl = self->GetEmbeddedDouble();
+    double const dbl = AS_DOUBLE(rcvr);
     ostringstream Str;
     Str.precision(17);
     Str << dbl;
@@ -141,34 +136,30 @@ static vm_oop_t dblAsString(vm_oop_t rcvr) {
 }
 
 static vm_oop_t dblSqrt(vm_oop_t rcvr) {
-    auto* self = static_cast<VMDouble*>(rcvr);
-    VMDouble* result = Universe::NewDouble(sqrt(self->GetEmbeddedDouble()));
-    return result;
+    return NEW_DOUBLE(sqrt(AS_DOUBLE(rcvr)));
 }
 
 static vm_oop_t dblRound(vm_oop_t rcvr) {
-    auto* self = (VMDouble*)rcvr;
-    int64_t const rounded = llround(self->GetEmbeddedDouble());
+    int64_t const rounded = llround(AS_DOUBLE(rcvr));
 
     return NEW_INT(rounded);
 }
 
 static vm_oop_t dblAsInteger(vm_oop_t rcvr) {
-    auto* self = (VMDouble*)rcvr;
-    auto const rounded = (int64_t)self->GetEmbeddedDouble();
+    auto const rounded = (int64_t)AS_DOUBLE(rcvr);
 
     return NEW_INT(rounded);
 }
 
 static vm_oop_t dblPositiveInfinity(vm_oop_t /*unused*/) {
-    return Universe::NewDouble(INFINITY);
+    return NEW_DOUBLE(INFINITY);
 }
 
 static vm_oop_t dblFromString(vm_oop_t /*unused*/, vm_oop_t rightObj) {
     auto* self = (VMString*)rightObj;
     double const value =
         stod(std::string(self->GetRawChars(), self->GetStringLength()));
-    return Universe::NewDouble(value);
+    return NEW_DOUBLE(value);
 }
 
 static vm_oop_t dblLowerThanEqual(vm_oop_t leftPtr, vm_oop_t rightObj) {
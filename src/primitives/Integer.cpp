@@ -54,7 +54,7 @@
     {                                                    \
         double const leftDbl = (double)(leftInt);        \
         double const rightDbl = AS_DOUBLE(rightObj);     \
-        return Universe::NewDouble(leftDbl op rightDbl); \
+        return NEW_DOUBLE(leftDbl op rightDbl); \
     }
 
 static vm_oop_t intPlus(vm_oop_t leftObj, vm_oop_t rightObj) {
@@ -209,7 +209,7 @@ static vm_oop_t intSlashslash(vm_oop_t leftObj, vm_oop_t rightObj) {
     }
 
     double const result = left / right;
-    return Universe::NewDouble(result);
+    return NEW_DOUBLE(result);
 }
 
 static vm_oop_t intSlash(vm_oop_t leftObj, vm_oop_t rightObj) {
@@ -529,7 +529,7 @@ static vm_oop_t intAsDouble(vm_oop_t self) {
         assert(IS_BIG_INT(self) && "assume big int");
         value = AS_BIG_INT(self)->embeddedInteger.toDouble();
     }
-    return Universe::NewDouble(value);
+    return NEW_DOUBLE(value);
 }
 
 static vm_oop_t intAs32BitSigned(vm_oop_t self) {
@@ -560,7 +560,7 @@ static vm_oop_t intSqrt(vm_oop_t self) {
     if (result == rint(result)) {
         return NEW_INT((int64_t)result);
     }
-    return Universe::NewDouble(result);
+    return NEW_DOUBLE(result);
 }
 
 static vm_oop_t intAtRandom(vm_oop_t self) {
@@ -28,16 +28,21 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <string>
 
 #include "../vm/Globals.h"
+#include "../vm/Print.h"
 #include "../vm/Universe.h"  // NOLINT(misc-include-cleaner) it's required to make the types complete
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMArray.h"
 #include "../vmobjects/VMBigInteger.h"  // NOLINT(misc-include-cleaner)
 #include "../vmobjects/VMClass.h"  // NOLINT(misc-include-cleaner) it's required to make the types complete
+#include "../vmobjects/VMDouble.h"
 #include "../vmobjects/VMFrame.h"
 #include "../vmobjects/VMInvokable.h"
 #include "../vmobjects/VMObject.h"
+#include "../vmobjects/VMSymbol.h"
 
 static vm_oop_t objEqualequal(vm_oop_t op2, vm_oop_t op1) {
     return load_ptr(op1 == op2 ? trueObject : falseObject);
@@ -48,6 +53,15 @@ static vm_oop_t objObjectSize(vm_oop_t self) {
 }
 
 static vm_oop_t objHashcode(vm_oop_t self) {
+#if TAGGED_DOUBLES
+    // like boxed doubles, immediate ones hash to their bits
+    if (IS_TAGGED_DOUBLE(self)) {
+        double const value = AS_DOUBLE(self);
+        int64_t bits = 0;
+        memcpy(&bits, &value, sizeof(bits));
+        return NEW_INT(bits);
+    }
+#endif
     if (IS_TAGGED(self)) {
         return self;
     }
@@ -130,6 +144,12 @@ static vm_oop_t objInstVarAtPut(vm_oop_t self, vm_oop_t idx, vm_oop_t value) {
 static vm_oop_t objInstVarNamed(vm_oop_t self, vm_oop_t nameObj) {
     auto* name = (VMSymbol*)nameObj;
     int64_t const fieldIdx = AS_OBJ(self)->GetFieldIndex(name);
+    if (fieldIdx < 0) {
+        std::string const cls = CLASS_OF(self)->GetName()->GetStdString();
+        ErrorExit(("instVarNamed: " + cls + " has no field named " +
+                   name->GetStdString())
+                      .c_str());
+    }
     return static_cast<VMObject*>(self)->GetField(fieldIdx);
 }
 
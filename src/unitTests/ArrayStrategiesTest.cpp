@@ -0,0 +1,267 @@
+#include "ArrayStrategiesTest.h"
+
+#include <cppunit/TestAssert.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../misc/defs.h"
+#include "../vm/Globals.h"
+#include "../vm/Symbols.h"
+#include "../vm/Universe.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMArray.h"
+#include "../vmobjects/VMBigInteger.h"  // NOLINT(misc-include-cleaner)
+#include "../vmobjects/VMDouble.h"      // NOLINT(misc-include-cleaner)
+#include "../vmobjects/VMSymbol.h"
+
+// the strategies that integers and doubles get, depending on the build
+#if USE_TAGGING
+static const ArrayStrategy IntegerStrategy = ARRAY_INTEGERS;
+#else
+static const ArrayStrategy IntegerStrategy = ARRAY_OBJECTS;
+#endif
+
+#if TAGGED_DOUBLES
+static const ArrayStrategy DoubleStrategy = ARRAY_DOUBLES;
+#else
+static const ArrayStrategy DoubleStrategy = ARRAY_OBJECTS;
+#endif
+
+static vm_oop_t nil() {
+    return load_ptr(nilObject);
+}
+
+void ArrayStrategiesTest::testAllNil() {
+    VMArray* arr = Universe::NewArray(3);
+    CPPUNIT_ASSERT_EQUAL(ARRAY_ALL_NIL, arr->GetStrategy());
+
+    arr->SetIndexableField(1, nil());
+    CPPUNIT_ASSERT_EQUAL(ARRAY_ALL_NIL, arr->GetStrategy());
+    for (size_t i = 0; i < 3; i += 1) {
+        CPPUNIT_ASSERT_EQUAL(nil(), arr->GetIndexableField(i));
+    }
+
+    arr->SetIndexableField(2, SymbolFor("sym"));
+    CPPUNIT_ASSERT_EQUAL(ARRAY_OBJECTS, arr->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(nil(), arr->GetIndexableField(0));
+    CPPUNIT_ASSERT_EQUAL(nil(), arr->GetIndexableField(1));
+    CPPUNIT_ASSERT_EQUAL((vm_oop_t)SymbolFor("sym"),
+                         arr->GetIndexableField(2));
+}
+
+void ArrayStrategiesTest::testIntegersToObjects() {
+    VMArray* arr = Universe::NewArray(3);
+    arr->SetIndexableField(1, NEW_INT(5));
+    CPPUNIT_ASSERT_EQUAL(IntegerStrategy, arr->GetStrategy());
+    arr->SetIndexableField(2, NEW_INT(-7));
+    CPPUNIT_ASSERT_EQUAL(IntegerStrategy, arr->GetStrategy());
+
+    CPPUNIT_ASSERT_EQUAL(nil(), arr->GetIndexableField(0));
+    CPPUNIT_ASSERT_EQUAL((int64_t)5, SMALL_INT_VAL(arr->GetIndexableField(1)));
+    CPPUNIT_ASSERT_EQUAL((int64_t)-7,
+                         SMALL_INT_VAL(arr->GetIndexableField(2)));
+
+    // a double generalizes the array, and the integers are boxed in place
+    vm_oop_t dbl = NEW_DOUBLE(1.5);
+    arr->SetIndexableField(0, dbl);
+    CPPUNIT_ASSERT_EQUAL(ARRAY_OBJECTS, arr->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(dbl, arr->GetIndexableField(0));
+    CPPUNIT_ASSERT_EQUAL((int64_t)5, SMALL_INT_VAL(arr->GetIndexableField(1)));
+    CPPUNIT_ASSERT_EQUAL((int64_t)-7,
+                         SMALL_INT_VAL(arr->GetIndexableField(2)));
+
+    // OBJECTS is never undone
+    arr->SetIndexableField(0, NEW_INT(1));
+    CPPUNIT_ASSERT_EQUAL(ARRAY_OBJECTS, arr->GetStrategy());
+}
+
+void ArrayStrategiesTest::testDoublesToObjects() {
+    VMArray* arr = Universe::NewArray(3);
+    arr->SetIndexableField(0, NEW_DOUBLE(2.5));
+    CPPUNIT_ASSERT_EQUAL(DoubleStrategy, arr->GetStrategy());
+    arr->SetIndexableField(1, NEW_DOUBLE(-0.25));
+    CPPUNIT_ASSERT_EQUAL(DoubleStrategy, arr->GetStrategy());
+
+    CPPUNIT_ASSERT_EQUAL(2.5, AS_DOUBLE(arr->GetIndexableField(0)));
+    CPPUNIT_ASSERT_EQUAL(-0.25, AS_DOUBLE(arr->GetIndexableField(1)));
+    CPPUNIT_ASSERT_EQUAL(nil(), arr->GetIndexableField(2));
+
+    arr->SetIndexableField(2, NEW_INT(3));
+    CPPUNIT_ASSERT_EQUAL(ARRAY_OBJECTS, arr->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(2.5, AS_DOUBLE(arr->GetIndexableField(0)));
+    CPPUNIT_ASSERT_EQUAL(-0.25, AS_DOUBLE(arr->GetIndexableField(1)));
+    CPPUNIT_ASSERT_EQUAL((int64_t)3, SMALL_INT_VAL(arr->GetIndexableField(2)));
+}
+
+void ArrayStrategiesTest::testDoublesKeepIdentity() {
+    // boxed doubles are stored as references, immediate ones compare equal
+    VMArray* arr = Universe::NewArray(2);
+    vm_oop_t dbl = NEW_DOUBLE(4.75);
+    arr->SetIndexableField(0, dbl);
+    CPPUNIT_ASSERT_EQUAL(dbl, arr->GetIndexableField(0));
+    CPPUNIT_ASSERT_EQUAL(dbl, arr->GetIndexableField(0));
+
+    // a double that cannot be immediate is always boxed
+    vm_oop_t inf = NEW_DOUBLE(1.0 / 0.0);
+    arr->SetIndexableField(1, inf);
+    CPPUNIT_ASSERT_EQUAL(ARRAY_OBJECTS, arr->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(inf, arr->GetIndexableField(1));
+    CPPUNIT_ASSERT_EQUAL(dbl, arr->GetIndexableField(0));
+}
+
+void ArrayStrategiesTest::testNilIntegerSentinel() {
+    VMArray* arr = Universe::NewArray(3);
+    arr->SetIndexableField(0, NEW_INT(1));
+    arr->SetIndexableField(1, NEW_INT(2));
+
+    // nil is stored as the sentinel, and keeps the strategy
+    arr->SetIndexableField(1, nil());
+    CPPUNIT_ASSERT_EQUAL(IntegerStrategy, arr->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(nil(), arr->GetIndexableField(1));
+    CPPUNIT_ASSERT_EQUAL((int64_t)1, SMALL_INT_VAL(arr->GetIndexableField(0)));
+
+    // the value of the sentinel is not an immediate integer, and is kept as
+    // a reference
+    vm_oop_t minInt = Universe::NewBigIntegerFromInt(ARRAY_NIL_INTEGER);
+    arr->SetIndexableField(2, minInt);
+    CPPUNIT_ASSERT_EQUAL(ARRAY_OBJECTS, arr->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(minInt, arr->GetIndexableField(2));
+    CPPUNIT_ASSERT_EQUAL(nil(), arr->GetIndexableField(1));
+    CPPUNIT_ASSERT_EQUAL((int64_t)1, SMALL_INT_VAL(arr->GetIndexableField(0)));
+}
+
+void ArrayStrategiesTest::testNilDoubleSentinel() {
+    VMArray* arr = Universe::NewArray(3);
+    arr->SetIndexableField(0, NEW_DOUBLE(1.5));
+    arr->SetIndexableField(1, NEW_DOUBLE(2.5));
+
+    arr->SetIndexableField(1, nil());
+    CPPUNIT_ASSERT_EQUAL(DoubleStrategy, arr->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(nil(), arr->GetIndexableField(1));
+    CPPUNIT_ASSERT_EQUAL(1.5, AS_DOUBLE(arr->GetIndexableField(0)));
+
+    // a double with the bits of the sentinel is not taken for nil
+    uint64_t const bits = ARRAY_NIL_DOUBLE_BITS;
+    double sentinel = 0.0;
+    memcpy(&sentinel, &bits, sizeof(sentinel));
+    vm_oop_t sentinelDouble = NEW_DOUBLE(sentinel);
+    arr->SetIndexableField(2, sentinelDouble);
+    CPPUNIT_ASSERT_EQUAL(ARRAY_OBJECTS, arr->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(sentinelDouble, arr->GetIndexableField(2));
+    CPPUNIT_ASSERT_EQUAL(nil(), arr->GetIndexableField(1));
+
+    double const read = AS_DOUBLE(arr->GetIndexableField(2));
+    uint64_t readBits = 0;
+    memcpy(&readBits, &read, sizeof(readBits));
+    CPPUNIT_ASSERT_EQUAL(bits, readBits);
+}
+
+void ArrayStrategiesTest::testCopyRange() {
+    // one array per strategy, with 1, 2, nil, 4, 5, 6
+    vm_oop_t const values[3][6] = {
+        {NEW_INT(1), NEW_INT(2), nil(), NEW_INT(4), NEW_INT(5), NEW_INT(6)},
+        {NEW_DOUBLE(1.0), NEW_DOUBLE(2.0), nil(), NEW_DOUBLE(4.0),
+         NEW_DOUBLE(5.0), NEW_DOUBLE(6.0)},
+        {SymbolFor("a"), SymbolFor("b"), nil(), SymbolFor("d"),
+         SymbolFor("e"), SymbolFor("f")}};
+
+    for (const auto& elements : values) {
+        VMArray* from = Universe::NewArray(6);
+        for (size_t i = 0; i < 6; i += 1) {
+            from->SetIndexableField(i, elements[i]);
+        }
+
+        VMArray* to = Universe::NewArray(4);
+        from->CopyIndexableFieldsTo(to, 1, 3);
+        CPPUNIT_ASSERT_EQUAL(from->GetStrategy(), to->GetStrategy());
+        for (size_t i = 0; i < 3; i += 1) {
+            CPPUNIT_ASSERT_EQUAL(elements[i + 1], to->GetIndexableField(i));
+        }
+        CPPUNIT_ASSERT_EQUAL(nil(), to->GetIndexableField(3));
+
+        VMArray* copy = from->Copy();
+        CPPUNIT_ASSERT_EQUAL(from->GetStrategy(), copy->GetStrategy());
+        for (size_t i = 0; i < 6; i += 1) {
+            CPPUNIT_ASSERT_EQUAL(elements[i], copy->GetIndexableField(i));
+        }
+    }
+}
+
+void ArrayStrategiesTest::testCopyRangeOfAllNil() {
+    VMArray* from = Universe::NewArray(4);
+    VMArray* to = Universe::NewArray(2);
+    from->CopyIndexableFieldsTo(to, 2, 2);
+    CPPUNIT_ASSERT_EQUAL(ARRAY_ALL_NIL, to->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(nil(), to->GetIndexableField(0));
+    CPPUNIT_ASSERT_EQUAL(nil(), to->GetIndexableField(1));
+}
+
+void ArrayStrategiesTest::testMoveOverlapping() {
+    vm_oop_t const values[3][5] = {
+        {NEW_INT(1), NEW_INT(2), NEW_INT(3), nil(), NEW_INT(5)},
+        {NEW_DOUBLE(1.0), NEW_DOUBLE(2.0), NEW_DOUBLE(3.0), nil(),
+         NEW_DOUBLE(5.0)},
+        {SymbolFor("a"), SymbolFor("b"), SymbolFor("c"), nil(),
+         SymbolFor("e")}};
+
+    for (const auto& elements : values) {
+        VMArray* arr = Universe::NewArray(5);
+        for (size_t i = 0; i < 5; i += 1) {
+            arr->SetIndexableField(i, elements[i]);
+        }
+        ArrayStrategy const strategy = arr->GetStrategy();
+
+        // towards the front: 2, 3, nil, 5, 5
+        arr->MoveIndexableFields(1, 0, 4);
+        CPPUNIT_ASSERT_EQUAL(strategy, arr->GetStrategy());
+        CPPUNIT_ASSERT_EQUAL(elements[1], arr->GetIndexableField(0));
+        CPPUNIT_ASSERT_EQUAL(elements[2], arr->GetIndexableField(1));
+        CPPUNIT_ASSERT_EQUAL(nil(), arr->GetIndexableField(2));
+        CPPUNIT_ASSERT_EQUAL(elements[4], arr->GetIndexableField(3));
+        CPPUNIT_ASSERT_EQUAL(elements[4], arr->GetIndexableField(4));
+
+        // towards the back: 2, 3, 2, 3, nil
+        arr->MoveIndexableFields(0, 2, 3);
+        CPPUNIT_ASSERT_EQUAL(elements[1], arr->GetIndexableField(0));
+        CPPUNIT_ASSERT_EQUAL(elements[2], arr->GetIndexableField(1));
+        CPPUNIT_ASSERT_EQUAL(elements[1], arr->GetIndexableField(2));
+        CPPUNIT_ASSERT_EQUAL(elements[2], arr->GetIndexableField(3));
+        CPPUNIT_ASSERT_EQUAL(nil(), arr->GetIndexableField(4));
+    }
+}
+
+/// Runs the access in a child process, and returns whether it exited with
+/// ERR_FAIL, as the VM does on an index out of bounds.
+static bool exitsWithError(void (*access)(VMArray*), VMArray* arr) {
+    fflush(nullptr);
+    pid_t const pid = fork();
+    if (pid == 0) {
+        if (freopen("/dev/null", "w", stderr) == nullptr) {
+            _exit(2);
+        }
+        access(arr);
+        _exit(0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == ERR_FAIL;
+}
+
+void ArrayStrategiesTest::testIndexEqualToLengthIsRejected() {
+    VMArray* arr = Universe::NewArray(3);
+    arr->SetIndexableField(2, SymbolFor("last"));
+    CPPUNIT_ASSERT_EQUAL((vm_oop_t)SymbolFor("last"),
+                         arr->GetIndexableField(2));
+
+    CPPUNIT_ASSERT(exitsWithError(
+        [](VMArray* a) { (void)a->GetIndexableField(3); }, arr));
+    CPPUNIT_ASSERT(exitsWithError(
+        [](VMArray* a) { a->SetIndexableField(3, load_ptr(nilObject)); },
+        arr));
+    CPPUNIT_ASSERT(!exitsWithError(
+        [](VMArray* a) { (void)a->GetIndexableField(2); }, arr));
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+using namespace std;
+
+class ArrayStrategiesTest : public CPPUNIT_NS::TestCase {
+    CPPUNIT_TEST_SUITE(ArrayStrategiesTest);  // NOLINT(misc-const-correctness)
+    CPPUNIT_TEST(testAllNil);
+    CPPUNIT_TEST(testIntegersToObjects);
+    CPPUNIT_TEST(testDoublesToObjects);
+    CPPUNIT_TEST(testDoublesKeepIdentity);
+    CPPUNIT_TEST(testNilIntegerSentinel);
+    CPPUNIT_TEST(testNilDoubleSentinel);
+    CPPUNIT_TEST(testCopyRange);
+    CPPUNIT_TEST(testCopyRangeOfAllNil);
+    CPPUNIT_TEST(testMoveOverlapping);
+    CPPUNIT_TEST(testIndexEqualToLengthIsRejected);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    static void testAllNil();
+    static void testIntegersToObjects();
+    static void testDoublesToObjects();
+    static void testDoublesKeepIdentity();
+    static void testNilIntegerSentinel();
+    static void testNilDoubleSentinel();
+    static void testCopyRange();
+    static void testCopyRangeOfAllNil();
+    static void testMoveOverlapping();
+    static void testIndexEqualToLengthIsRejected();
+};
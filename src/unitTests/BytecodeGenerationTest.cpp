@@ -732,7 +732,7 @@ void BytecodeGenerationTest::testNestedIfs() {
         bytecodes,
         {BC_PUSH_CONSTANT_0, BC(BC_JUMP_ON_FALSE_TOP_NIL, 12, 0),
          BC_PUSH_CONSTANT_1, BC(BC_JUMP_ON_TRUE_TOP_NIL, 8, 0), BC_PUSH_FIELD_0,
-         BC_PUSH_ARG_1, BC(BC_SEND, 2), BC_RETURN_LOCAL, BC_RETURN_SELF});
+         BC_PUSH_ARG_1, BC(BC_SUB, 2), BC_RETURN_LOCAL, BC_RETURN_SELF});
 }
 
 void BytecodeGenerationTest::testNestedIfsAndLocals() {
@@ -764,13 +764,13 @@ void BytecodeGenerationTest::testNestedIfsAndLocals() {
                       BC(BC_POP_LOCAL, 7, 0),
                       BC(BC_PUSH_LOCAL, 8, 0),
                       BC(BC_PUSH_LOCAL, 9, 0),
-                      BC(BC_SEND, 4),
+                      BC(BC_SUB, 4),
                       BC(BC_PUSH_LOCAL, 5, 0),
-                      BC(BC_SEND, 4),
+                      BC(BC_SUB, 4),
                       BC(BC_PUSH_LOCAL, 6, 0),
-                      BC(BC_SEND, 4),
+                      BC(BC_SUB, 4),
                       BC(BC_PUSH_LOCAL, 3, 0),
-                      BC(BC_SEND, 4),
+                      BC(BC_SUB, 4),
                       BC_RETURN_LOCAL,
                       BC_RETURN_SELF});
 }
@@ -790,6 +790,31 @@ void BytecodeGenerationTest::incDecBytecodes(const std::string& sel,
     tearDown();
 }
 
+void BytecodeGenerationTest::testBinaryOperationBytecodes() {
+    binaryOperationBytecodes("+", BC_ADD);
+    binaryOperationBytecodes("-", BC_SUB);
+    binaryOperationBytecodes("*", BC_MUL);
+    binaryOperationBytecodes("<", BC_LT);
+    binaryOperationBytecodes(">", BC_GT);
+    binaryOperationBytecodes("<=", BC_LE);
+    binaryOperationBytecodes(">=", BC_GE);
+    binaryOperationBytecodes("=", BC_EQ);
+    binaryOperationBytecodes("==", BC_EQ_EQ);
+    binaryOperationBytecodes("~=", BC_SEND);
+    binaryOperationBytecodes("//", BC_SEND);
+}
+
+void BytecodeGenerationTest::binaryOperationBytecodes(const std::string& sel,
+                                                      uint8_t bc) {
+    std::string source = "test: arg = ( ^ arg " + sel + " arg )";
+    auto bytecodes = methodToBytecode(source.data());
+
+    check(bytecodes,
+          {BC_PUSH_ARG_1, BC_PUSH_ARG_1, BC(bc, 0), BC_RETURN_LOCAL});
+
+    tearDown();
+}
+
 void BytecodeGenerationTest::testIfTrueAndIncField() {
     addField("field");
 
@@ -1268,7 +1293,7 @@ void BytecodeGenerationTest::testFieldReadIncWrite() {
                       BC_PUSH_CONSTANT_0, BC_POP_LOCAL_0,
 
                       // iter > 0
-                      BC_PUSH_LOCAL_0, BC_PUSH_0, BC(BC_SEND, 1),
+                      BC_PUSH_LOCAL_0, BC_PUSH_0, BC(BC_GT, 1),
 
                       // whileTrue
                       BC(BC_JUMP_ON_FALSE_POP, 14, 0),
@@ -65,6 +65,7 @@ class BytecodeGenerationTest : public TestWithParsing {
     CPPUNIT_TEST(testNestedIfsAndLocals);
 
     CPPUNIT_TEST(testIncDecBytecodes);
+    CPPUNIT_TEST(testBinaryOperationBytecodes);
     CPPUNIT_TEST(testIfTrueAndIncField);
     CPPUNIT_TEST(testIfTrueAndIncArg);
 
@@ -162,6 +163,8 @@ private:
 
     void testIncDecBytecodes();
     void incDecBytecodes(const std::string& sel, uint8_t bc);
+    void testBinaryOperationBytecodes();
+    void binaryOperationBytecodes(const std::string& sel, uint8_t bc);
 
     void testIfTrueAndIncField();
     void testIfTrueAndIncArg();
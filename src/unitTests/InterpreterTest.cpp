@@ -0,0 +1,346 @@
+#include "InterpreterTest.h"
+
+#include <cppunit/TestAssert.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "../compiler/SourcecodeCompiler.h"
+#include "../interpreter/Interpreter.h"
+#include "../interpreter/JIT.h"
+#include "../interpreter/bytecodes.h"
+#include "../interpreter/RegisterCode.h"
+#include "../memory/FrameStack.h"
+#include "../memory/Heap.h"
+#include "../vm/Globals.h"
+#include "../vm/Symbols.h"
+#include "../vm/Universe.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMClass.h"
+#include "../vmobjects/InlineCache.h"
+#include "../vmobjects/VMFrame.h"
+#include "../vmobjects/VMMethod.h"
+#include "../vmobjects/VMSymbol.h"
+
+VMClass* InterpreterTest::compileClass(const std::string& source) {
+    VMClass* cls = SourcecodeCompiler::CompileClassString(source, nullptr);
+    CPPUNIT_ASSERT(cls != nullptr);
+    Universe::SetGlobal(cls->GetName(), cls);
+    return cls;
+}
+
+vm_oop_t InterpreterTest::run(const std::string& source,
+                              const char* selector) {
+    VMClass* cls = compileClass(source);
+    vm_oop_t result =
+        Universe::interpret(cls->GetName()->GetStdString(), selector);
+    CPPUNIT_ASSERT(result != nullptr);
+    return result;
+}
+
+VMMethod* InterpreterTest::classMethod(const char* className,
+                                       const char* selector) {
+    auto* cls =
+        static_cast<VMClass*>(Universe::GetGlobal(SymbolFor(className)));
+    CPPUNIT_ASSERT(cls != nullptr);
+    auto* method = static_cast<VMMethod*>(
+        cls->GetClass()->LookupInvokable(SymbolFor(selector)));
+    CPPUNIT_ASSERT(method != nullptr);
+    return method;
+}
+
+InlineCache* InterpreterTest::firstSendSite(VMMethod* method) {
+    size_t i = 0;
+    while (i < method->GetNumberOfBytecodes()) {
+        uint8_t const bc = Bytecode::GetBaseBytecode(method->GetBytecode(i));
+        if (bc == BC_SEND || bc == BC_SEND_1) {
+            return method->GetInlineCache(i);
+        }
+        i += Bytecode::GetBytecodeLength(bc);
+    }
+    CPPUNIT_FAIL("the method has no send");
+    return nullptr;
+}
+
+bool InterpreterTest::hasBytecode(VMMethod* method, uint8_t bytecode) {
+    size_t i = 0;
+    while (i < method->GetNumberOfBytecodes()) {
+        uint8_t const bc = method->GetBytecode(i);
+        if (bc == bytecode) {
+            return true;
+        }
+        i += Bytecode::GetBytecodeLength(bc);
+    }
+    return false;
+}
+
+void InterpreterTest::testIdentityEqualsSendsOverride() {
+    vm_oop_t result = run(
+        "EqEqOverride = ( == other = ( ^ true ) ---- "
+        "test = ( ^ self new == 42 ) )",
+        "test");
+    CPPUNIT_ASSERT_EQUAL(load_ptr(trueObject), result);
+
+    result = run(
+        "EqEqOverrideInLoop = ( == other = ( ^ other ) ---- "
+        "test = ( | o r | o := self new. "
+        "1 to: 10 do: [:i | r := o == i ]. ^ r ) )",
+        "test");
+    CPPUNIT_ASSERT_EQUAL((int64_t)10, SMALL_INT_VAL(result));
+}
+
+void InterpreterTest::testIdentityEqualsOfIntegers() {
+    vm_oop_t result =
+        run("EqEqIntegers = ( ---- test = ( ^ 3 == (1 + 2) ) )", "test");
+    CPPUNIT_ASSERT_EQUAL(load_ptr(trueObject), result);
+
+    result = run(
+        "EqEqObjects = ( ---- test = ( | o | o := Object new. "
+        "^ (o == o) and: [ (o == Object new) not ] ) )",
+        "test");
+    CPPUNIT_ASSERT_EQUAL(load_ptr(trueObject), result);
+}
+
+void InterpreterTest::testDoesNotUnderstandWithFullStack() {
+    // the stack of #full is full when #zork is sent, so the frame is replaced
+    // by a bigger one for the send of #doesNotUnderstand:arguments:
+    vm_oop_t result = run(
+        "DnuFullStack = ( ---- "
+        "full = ( ^ 1 + (2 + (3 + self zork)) ) "
+        "doesNotUnderstand: selector arguments: args = ( ^ 4 ) "
+        "test = ( | r | 1 to: 1000 do: [:i | r := self full ]. ^ r ) )",
+        "test");
+    CPPUNIT_ASSERT_EQUAL((int64_t)10, SMALL_INT_VAL(result));
+}
+
+void InterpreterTest::testUnknownGlobalWithFullStack() {
+    vm_oop_t result = run(
+        "UnknownGlobalFullStack = ( ---- "
+        "full = ( ^ 1 + (2 + (3 + Zork)) ) "
+        "unknownGlobal: name = ( ^ 4 ) "
+        "test = ( | r | 1 to: 1000 do: [:i | r := self full ]. ^ r ) )",
+        "test");
+    CPPUNIT_ASSERT_EQUAL((int64_t)10, SMALL_INT_VAL(result));
+}
+
+void InterpreterTest::testEmergencyFrameReleasesStackFrame() {
+    VMFrame* current = Interpreter::GetFrame();
+    VMFrame* frame = FrameStack::NewFrame(current, current->GetMethod());
+    CPPUNIT_ASSERT(frame != nullptr);
+
+    VMFrame* bigger = VMFrame::EmergencyFrameFrom(frame, 3);
+    CPPUNIT_ASSERT(!bigger->IsOnStack());
+    CPPUNIT_ASSERT(bigger->GetPreviousFrame() == current);
+
+    // the next frame reuses the memory of the replaced one
+    VMFrame* next = FrameStack::NewFrame(current, current->GetMethod());
+    CPPUNIT_ASSERT_EQUAL(frame, next);
+    FrameStack::Release(next);
+}
+
+void InterpreterTest::testNonLocalReturnThroughSeveralFrames() {
+    // the block returns from #find: through the frames of #deeper:for:do:,
+    // #check:for:do:, and the loop block
+    vm_oop_t result = run(
+        "NonLocalReturn = ( ---- "
+        "find: n = ( 1 to: 10 do: [:i | "
+        "self check: i for: n do: [ ^ i * 10 ] ]. ^ 0 ) "
+        "check: i for: n do: blk = ( ^ self deeper: i for: n do: blk ) "
+        "deeper: i for: n do: blk = ( i = n ifTrue: [ blk value ]. ^ nil ) "
+        "test = ( | r | 1 to: 1000 do: [:k | "
+        "r := (self find: 7) + (self find: 20) ]. ^ r ) )",
+        "test");
+    CPPUNIT_ASSERT_EQUAL((int64_t)70, SMALL_INT_VAL(result));
+}
+
+void InterpreterTest::testEscapedBlockAfterHomeWasCut() {
+    // the non-local return of the block passed to #home: cuts the frame of
+    // #home:, so the block stored in #saved escaped. It is activated by a
+    // unary send and by #perform:, the latter with a full stack
+    vm_oop_t result = run(
+        "EscapedBlock = ( ---- | saved | "
+        "home: outer = ( saved := [ ^ 2 ]. outer value. ^ 3 ) "
+        "cut = ( self home: [ ^ 1 ]. ^ 0 ) "
+        "escapedBlock: block = ( ^ block == saved ifTrue: [ 5 ] ) "
+        "test = ( | r | 1 to: 1000 do: [:i | "
+        "r := self cut + saved value + "
+        "(1 + (2 + (saved perform: #value))) ]. ^ r ) )",
+        "test");
+    CPPUNIT_ASSERT_EQUAL((int64_t)14, SMALL_INT_VAL(result));
+}
+
+#if GC_TYPE == GENERATIONAL
+void InterpreterTest::testAllocationSitesOfNew() {
+    // #new is charged to the send that invokes it, but not to the send of
+    // #perform: that reaches it only indirectly
+    run("AllocationSites = ( ---- "
+        "direct = ( ^ self new ) "
+        "indirect = ( ^ self perform: #new ) "
+        "test = ( 1 to: 10 do: [:i | self direct. self indirect ] ) )",
+        "test");
+    GetHeap<HEAP_CLS>()->FullGC();
+
+    AllocationSite* direct =
+        firstSendSite(classMethod("AllocationSites", "direct"))
+            ->GetAllocationSite();
+    AllocationSite* indirect =
+        firstSendSite(classMethod("AllocationSites", "indirect"))
+            ->GetAllocationSite();
+    CPPUNIT_ASSERT_EQUAL(10U, direct->allocated);
+    CPPUNIT_ASSERT_EQUAL(0U, indirect->allocated);
+}
+#endif
+
+void InterpreterTest::testInstVarNamedOfInheritedFields() {
+    // the fields of FieldsBase come first in instances of FieldsSub
+    compileClass("FieldsBase = ( | a b | init = ( a := 10. b := 20 ) )");
+    vm_oop_t result = run(
+        "FieldsSub = FieldsBase ( | c | init = ( super init. c := 30 ) ---- "
+        "field: name of: o = ( ^ o instVarNamed: name ) "
+        "test = ( | o r | o := self new init. r := 0. "
+        "1 to: 10 do: [:i | "
+        "(self field: #a of: o) = (o instVarAt: 1) ifTrue: [ r := r + 1 ]. "
+        "(self field: #b of: o) = (o instVarAt: 2) ifTrue: [ r := r + 1 ]. "
+        "(self field: #c of: o) = (o instVarAt: 3) ifTrue: [ r := r + 1 ] ]. "
+        "^ (self field: #c of: o) * 100 + r ) )",
+        "test");
+    CPPUNIT_ASSERT_EQUAL((int64_t)3030, SMALL_INT_VAL(result));
+    CPPUNIT_ASSERT(
+        hasBytecode(classMethod("FieldsSub", "field:of:"), BC_INST_VAR_NAMED));
+}
+
+void InterpreterTest::testInstVarNamedWithManyReceiverClasses() {
+    // the site sees more receiver classes than its field index cache holds,
+    // and the field is at a different index in each of them
+    compileClass("ManyFields1 = ( | x | init = ( x := 1 ) )");
+    compileClass("ManyFields2 = ( | a x | init = ( x := 2 ) )");
+    compileClass("ManyFields3 = ( | a b x | init = ( x := 3 ) )");
+    compileClass("ManyFields4 = ( | a b c x | init = ( x := 4 ) )");
+    compileClass("ManyFields5 = ( | a b c d x | init = ( x := 5 ) )");
+    compileClass("ManyFields6 = ( | a b c d e x | init = ( x := 6 ) )");
+    vm_oop_t result = run(
+        "ManyFieldsSite = ( ---- "
+        "x: o = ( ^ o instVarNamed: #x ) "
+        "test = ( | s | s := 0. 1 to: 10 do: [:i | "
+        "s := s + (self x: ManyFields1 new init) "
+        "+ (self x: ManyFields2 new init) + (self x: ManyFields3 new init) "
+        "+ (self x: ManyFields4 new init) + (self x: ManyFields5 new init) "
+        "+ (self x: ManyFields6 new init) ]. ^ s ) )",
+        "test");
+    CPPUNIT_ASSERT_EQUAL((int64_t)210, SMALL_INT_VAL(result));
+    CPPUNIT_ASSERT(
+        hasBytecode(classMethod("ManyFieldsSite", "x:"), BC_INST_VAR_NAMED));
+}
+
+void InterpreterTest::testInstVarNamedOverride() {
+    // the site is quickened for PlainField, and goes back to a send once it
+    // sees a class that overrides #instVarNamed:
+    compileClass("PlainField = ( | x | init = ( x := 1 ) )");
+    compileClass(
+        "OverriddenField = ( | x | init = ( x := 1 ) "
+        "instVarNamed: name = ( ^ 42 ) )");
+    vm_oop_t result = run(
+        "OverrideSite = ( ---- "
+        "x: o = ( ^ o instVarNamed: #x ) "
+        "test = ( | s | s := 0. 1 to: 10 do: [:i | "
+        "s := s + (self x: PlainField new init) ]. "
+        "^ s + (self x: OverriddenField new init) ) )",
+        "test");
+    CPPUNIT_ASSERT_EQUAL((int64_t)52, SMALL_INT_VAL(result));
+
+    VMMethod* method = classMethod("OverrideSite", "x:");
+    CPPUNIT_ASSERT(!hasBytecode(method, BC_INST_VAR_NAMED));
+    CPPUNIT_ASSERT(firstSendSite(method)->IsQuickeningDisabled());
+}
+
+void InterpreterTest::testInstVarNamedAfterClassChange() {
+    compileClass("EpochOverride = ( instVarNamed: name = ( ^ 42 ) )");
+    VMClass* cls = compileClass("EpochField = ( | x | init = ( x := 1 ) )");
+    vm_oop_t result = run(
+        "EpochSite = ( ---- "
+        "x: o = ( ^ o instVarNamed: #x ) "
+        "test = ( | o s | o := EpochField new init. s := 0. "
+        "1 to: 10 do: [:i | s := s + (self x: o) ]. ^ s ) )",
+        "test");
+    CPPUNIT_ASSERT_EQUAL((int64_t)10, SMALL_INT_VAL(result));
+    CPPUNIT_ASSERT(
+        hasBytecode(classMethod("EpochSite", "x:"), BC_INST_VAR_NAMED));
+
+    // changing the superclass starts a new epoch, in which the cached index
+    // is not used, and the site finds the override
+    cls->SetSuperClass(
+        static_cast<VMClass*>(Universe::GetGlobal(SymbolFor("EpochOverride"))));
+    result = Universe::interpret("EpochSite", "test");
+    CPPUNIT_ASSERT_EQUAL((int64_t)420, SMALL_INT_VAL(result));
+    CPPUNIT_ASSERT(
+        !hasBytecode(classMethod("EpochSite", "x:"), BC_INST_VAR_NAMED));
+}
+
+#ifdef USE_REGISTER_BYTECODES
+void InterpreterTest::testHotLoopContinuesInRegisterCode() {
+    useRegisterBytecodes = true;
+    vm_oop_t result = run(
+        "HotLoop = ( ---- "
+        "test = ( | i | i := 0. "
+        "[ i < 5000 ] whileTrue: [ i := i + 1 ]. ^ i ) )",
+        "test");
+    useRegisterBytecodes = false;
+    CPPUNIT_ASSERT_EQUAL((int64_t)5000, SMALL_INT_VAL(result));
+
+    // the method was invoked only once, and translated at a back edge. The
+    // stack interpreter counts back edges, so it did not execute the loop
+    // after that
+    VMMethod* method = classMethod("HotLoop", "test");
+    CPPUNIT_ASSERT(method->GetRegisterCode() != nullptr);
+    CPPUNIT_ASSERT_EQUAL((uint32_t)REGISTER_BACK_EDGE_THRESHOLD,
+                         method->backEdgeCount);
+}
+
+void InterpreterTest::testHotLoopThatCreatesBlocks() {
+    // the register code returns to the stack interpreter to create the block
+    useRegisterBytecodes = true;
+    vm_oop_t result = run(
+        "HotLoopWithBlock = ( ---- "
+        "test = ( | i b | i := 0. "
+        "[ i < 5000 ] whileTrue: [ i := i + 1. b := [ i ] ]. ^ b value ) )",
+        "test");
+    useRegisterBytecodes = false;
+    CPPUNIT_ASSERT_EQUAL((int64_t)5000, SMALL_INT_VAL(result));
+    VMMethod* method = classMethod("HotLoopWithBlock", "test");
+    CPPUNIT_ASSERT(method->GetRegisterCode() != nullptr);
+}
+#endif
+
+#ifdef USE_JIT
+void InterpreterTest::testCompiledMethods() {
+    compileClass(
+        "JitTrace = ( ---- "
+        "inner: n = ( system printStackTrace. ^ n < 40 ifTrue: [ n - 1 ] ) "
+        "outer = ( ^ (self inner: 39) + 3 ) "
+        "test = ( ^ self outer ) )");
+
+    // the next invocation compiles them
+    VMMethod* inner = classMethod("JitTrace", "inner:");
+    VMMethod* outer = classMethod("JitTrace", "outer");
+    inner->invocationCount = JIT_INVOCATION_THRESHOLD - 1;
+    outer->invocationCount = JIT_INVOCATION_THRESHOLD - 1;
+
+    std::stringstream trace;
+    std::streambuf* out = std::cout.rdbuf(trace.rdbuf());
+    useJIT = true;
+    vm_oop_t result = Universe::interpret("JitTrace", "test");
+    useJIT = false;
+    std::cout.rdbuf(out);
+
+    CPPUNIT_ASSERT(inner->GetCompiledCode() != nullptr);
+    CPPUNIT_ASSERT(outer->GetCompiledCode() != nullptr);
+    CPPUNIT_ASSERT_EQUAL((int64_t)41, SMALL_INT_VAL(result));
+
+    // the frames of compiled methods are the same as the interpreter's
+    std::string const expected =
+        "JitTrace class>>#inner:\n"
+        "JitTrace class>>#outer\n"
+        "JitTrace class>>#test\n";
+    CPPUNIT_ASSERT_EQUAL(expected, trace.str().substr(0, expected.size()));
+}
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <string>
+
+#include "../vmobjects/ObjectFormats.h"
+
+class InlineCache;
+
+using namespace std;
+
+/**
+ * Runs class-side methods of classes that are compiled from source, to test
+ * how the interpreter executes them.
+ */
+class InterpreterTest : public CPPUNIT_NS::TestCase {
+    CPPUNIT_TEST_SUITE(InterpreterTest);  // NOLINT(misc-const-correctness)
+    CPPUNIT_TEST(testIdentityEqualsSendsOverride);
+    CPPUNIT_TEST(testIdentityEqualsOfIntegers);
+    CPPUNIT_TEST(testDoesNotUnderstandWithFullStack);
+    CPPUNIT_TEST(testUnknownGlobalWithFullStack);
+    CPPUNIT_TEST(testEmergencyFrameReleasesStackFrame);
+    CPPUNIT_TEST(testNonLocalReturnThroughSeveralFrames);
+    CPPUNIT_TEST(testEscapedBlockAfterHomeWasCut);
+#if GC_TYPE == GENERATIONAL
+    CPPUNIT_TEST(testAllocationSitesOfNew);
+#endif
+    CPPUNIT_TEST(testInstVarNamedOfInheritedFields);
+    CPPUNIT_TEST(testInstVarNamedWithManyReceiverClasses);
+    CPPUNIT_TEST(testInstVarNamedOverride);
+    CPPUNIT_TEST(testInstVarNamedAfterClassChange);
+#ifdef USE_REGISTER_BYTECODES
+    CPPUNIT_TEST(testHotLoopContinuesInRegisterCode);
+    CPPUNIT_TEST(testHotLoopThatCreatesBlocks);
+#endif
+#ifdef USE_JIT
+    CPPUNIT_TEST(testCompiledMethods);
+#endif
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    static VMClass* compileClass(const std::string& source);
+    static vm_oop_t run(const std::string& source, const char* selector);
+    static VMMethod* classMethod(const char* className, const char* selector);
+    static InlineCache* firstSendSite(VMMethod* method);
+    static bool hasBytecode(VMMethod* method, uint8_t bytecode);
+
+    static void testIdentityEqualsSendsOverride();
+    static void testIdentityEqualsOfIntegers();
+    static void testDoesNotUnderstandWithFullStack();
+    static void testUnknownGlobalWithFullStack();
+    static void testEmergencyFrameReleasesStackFrame();
+    static void testNonLocalReturnThroughSeveralFrames();
+    static void testEscapedBlockAfterHomeWasCut();
+#if GC_TYPE == GENERATIONAL
+    static void testAllocationSitesOfNew();
+#endif
+    static void testInstVarNamedOfInheritedFields();
+    static void testInstVarNamedWithManyReceiverClasses();
+    static void testInstVarNamedOverride();
+    static void testInstVarNamedAfterClassChange();
+#ifdef USE_REGISTER_BYTECODES
+    static void testHotLoopContinuesInRegisterCode();
+    static void testHotLoopThatCreatesBlocks();
+#endif
+#ifdef USE_JIT
+    static void testCompiledMethods();
+#endif
+};
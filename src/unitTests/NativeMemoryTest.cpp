@@ -0,0 +1,104 @@
+#include "NativeMemoryTest.h"
+
+#include <cppunit/TestAssert.h>
+#include <string>
+
+#include "../compiler/SourcecodeCompiler.h"
+#include "../interpreter/JIT.h"
+#include "../memory/Heap.h"
+#include "../vm/Symbols.h"
+#include "../vm/Universe.h"
+#include "../vmobjects/InlineCache.h"
+#include "../vmobjects/VMClass.h"
+#include "../vmobjects/VMMethod.h"
+#include "../vmobjects/VMSymbol.h"
+
+#ifdef INCREMENTAL_MARKING
+  #include "../memory/IncrementalMarker.h"
+#endif
+
+VMMethod* NativeMemoryTest::compileMethod(const std::string& source,
+                                          bool asGlobal) {
+    VMClass* cls = SourcecodeCompiler::CompileClassString(source, nullptr);
+    CPPUNIT_ASSERT(cls != nullptr);
+    if (asGlobal) {
+        Universe::SetGlobal(cls->GetName(), cls);
+    }
+
+    // a lookup would cache the method in the selector, which keeps it alive
+    auto* method = static_cast<VMMethod*>(cls->GetInstanceInvokable(0));
+    CPPUNIT_ASSERT(method != nullptr);
+    return method;
+}
+
+static bool ownsNativeMemory(VMMethod* method) {
+    for (const VMMethod::NativeMemoryOwner& owner :
+         VMMethod::ownersOfNativeMemory) {
+        if (owner.method == method) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Whether a method of the class owns native memory. Moving collectors
+/// change the addresses of the methods that survive.
+static bool ownsNativeMemory(const std::string& className) {
+    for (const VMMethod::NativeMemoryOwner& owner :
+         VMMethod::ownersOfNativeMemory) {
+        VMClass* holder = owner.method->GetHolder();
+        if (holder != nullptr && holder->GetName()->GetStdString() == className) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void collectGarbage() {
+    GetHeap<HEAP_CLS>()->FullGC();
+#ifdef INCREMENTAL_MARKING
+    while (IncrementalMarker::IsMarking()) {
+        GetHeap<HEAP_CLS>()->FullGC();
+    }
+#endif
+}
+
+void NativeMemoryTest::testCachesOfDeadMethodsAreFreed() {
+    VMMethod* method =
+        compileMethod("NativeMemoryDead = ( m = ( ^ 1 printString ) )", false);
+    CPPUNIT_ASSERT(method->GetInlineCache(0) != nullptr);
+    CPPUNIT_ASSERT(ownsNativeMemory(method));
+    CPPUNIT_ASSERT(ownsNativeMemory("NativeMemoryDead"));
+
+    // nothing refers to the class, so the method dies
+    collectGarbage();
+    CPPUNIT_ASSERT(!ownsNativeMemory("NativeMemoryDead"));
+}
+
+void NativeMemoryTest::testCachesOfLiveMethodsAreKept() {
+    VMMethod* method =
+        compileMethod("NativeMemoryLive = ( m = ( ^ 1 printString ) )", true);
+    InlineCache* cache = method->GetInlineCache(0);
+
+    // the method may have moved, but it keeps its cache
+    collectGarbage();
+    auto* cls = static_cast<VMClass*>(
+        Universe::GetGlobal(SymbolFor("NativeMemoryLive")));
+    auto* moved =
+        static_cast<VMMethod*>(cls->LookupInvokable(SymbolFor("m")));
+    CPPUNIT_ASSERT(ownsNativeMemory(moved));
+    CPPUNIT_ASSERT_EQUAL(cache, moved->GetInlineCache(0));
+}
+
+#ifdef USE_JIT
+void NativeMemoryTest::testCompiledCodeOfDeadMethodsIsFreed() {
+    VMMethod* method = compileMethod(
+        "NativeMemoryDeadCode = ( m = ( ^ 1 printString ) )", false);
+    JIT::Compile(method);
+    CPPUNIT_ASSERT(method->GetCompiledCode() != nullptr);
+    CPPUNIT_ASSERT(ownsNativeMemory("NativeMemoryDeadCode"));
+
+    collectGarbage();
+    CPPUNIT_ASSERT(!ownsNativeMemory("NativeMemoryDeadCode"));
+}
+#endif
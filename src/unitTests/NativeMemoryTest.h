@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <string>
+
+#include "../vmobjects/ObjectFormats.h"
+
+using namespace std;
+
+/**
+ * Methods own inline caches and native code outside of the heap. These
+ * tests check that the collectors keep them for the methods that survive,
+ * and free them for the ones that die.
+ */
+class NativeMemoryTest : public CPPUNIT_NS::TestCase {
+    CPPUNIT_TEST_SUITE(NativeMemoryTest);  // NOLINT(misc-const-correctness)
+    CPPUNIT_TEST(testCachesOfDeadMethodsAreFreed);
+    CPPUNIT_TEST(testCachesOfLiveMethodsAreKept);
+#ifdef USE_JIT
+    CPPUNIT_TEST(testCompiledCodeOfDeadMethodsIsFreed);
+#endif
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    static void testCachesOfDeadMethodsAreFreed();
+    static void testCachesOfLiveMethodsAreKept();
+#ifdef USE_JIT
+    static void testCompiledCodeOfDeadMethodsIsFreed();
+#endif
+
+    static VMMethod* compileMethod(const std::string& source, bool asGlobal);
+};
@@ -0,0 +1,172 @@
+#include "VectorTest.h"
+
+#include <cppunit/TestAssert.h>
+#include <cstddef>
+#include <cstdint>
+
+#include "../misc/defs.h"
+#include "../vm/Globals.h"
+#include "../vm/Universe.h"
+#include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMArray.h"
+#include "../vmobjects/VMVector.h"
+
+static VMVector* newVector(size_t capacity) {
+    return Universe::NewVector(capacity, load_ptr(objectClass));
+}
+
+static int64_t intAt(VMVector* vec, int64_t index) {
+    return SMALL_INT_VAL(vec->GetStorage(index));
+}
+
+static void appendInts(VMVector* vec, int64_t from, int64_t to) {
+    for (int64_t i = from; i <= to; i += 1) {
+        vec->Append(NEW_INT(i));
+    }
+}
+
+static int64_t sizeOf(VMVector* vec) {
+    return SMALL_INT_VAL(vec->Size());
+}
+
+static int64_t capacityOf(VMVector* vec) {
+    return SMALL_INT_VAL(vec->Capacity());
+}
+
+void VectorTest::testAppendGrows() {
+    VMVector* vec = newVector(4);
+    appendInts(vec, 1, 4);
+    CPPUNIT_ASSERT_EQUAL((int64_t)4, capacityOf(vec));
+
+    appendInts(vec, 5, 9);
+    CPPUNIT_ASSERT_EQUAL((int64_t)9, sizeOf(vec));
+    CPPUNIT_ASSERT_EQUAL((int64_t)16, capacityOf(vec));
+    for (int64_t i = 1; i <= 9; i += 1) {
+        CPPUNIT_ASSERT_EQUAL(i, intAt(vec, i));
+    }
+
+    // a Vector without storage grows to the minimal capacity
+    VMVector* empty = newVector(0);
+    empty->Append(NEW_INT(1));
+    CPPUNIT_ASSERT_EQUAL((int64_t)VECTOR_MIN_CAPACITY, capacityOf(empty));
+    CPPUNIT_ASSERT_EQUAL((int64_t)1, intAt(empty, 1));
+}
+
+void VectorTest::testAppendCompactsFront() {
+    // a queue that removes most elements from the front keeps its storage
+    VMVector* vec = newVector(8);
+    appendInts(vec, 1, 8);
+    for (int64_t i = 1; i <= 6; i += 1) {
+        CPPUNIT_ASSERT_EQUAL(i, SMALL_INT_VAL(vec->RemoveFirst()));
+    }
+    VMArray* storage = load_ptr(vec->storage);
+
+    appendInts(vec, 9, 10);
+    CPPUNIT_ASSERT_EQUAL(storage, load_ptr(vec->storage));
+    CPPUNIT_ASSERT_EQUAL((int64_t)8, capacityOf(vec));
+    CPPUNIT_ASSERT_EQUAL((int64_t)1, SMALL_INT_VAL(load_ptr(vec->first)));
+    CPPUNIT_ASSERT_EQUAL((int64_t)4, sizeOf(vec));
+    for (int64_t i = 1; i <= 4; i += 1) {
+        CPPUNIT_ASSERT_EQUAL(i + 6, intAt(vec, i));
+    }
+
+    // the slots the elements moved out of are cleared
+    for (size_t i = 4; i < 8; i += 1) {
+        CPPUNIT_ASSERT_EQUAL(load_ptr(nilObject),
+                             storage->GetIndexableField(i));
+    }
+}
+
+void VectorTest::testAppendGrowsWhenMostlyFull() {
+    // with only one element removed from the front, it grows instead, and
+    // drops the removed element
+    VMVector* vec = newVector(8);
+    appendInts(vec, 1, 8);
+    CPPUNIT_ASSERT_EQUAL((int64_t)1, SMALL_INT_VAL(vec->RemoveFirst()));
+
+    vec->Append(NEW_INT(9));
+    CPPUNIT_ASSERT_EQUAL((int64_t)16, capacityOf(vec));
+    CPPUNIT_ASSERT_EQUAL((int64_t)1, SMALL_INT_VAL(load_ptr(vec->first)));
+    CPPUNIT_ASSERT_EQUAL((int64_t)8, sizeOf(vec));
+    for (int64_t i = 1; i <= 8; i += 1) {
+        CPPUNIT_ASSERT_EQUAL(i + 1, intAt(vec, i));
+    }
+}
+
+void VectorTest::testRemoveFirstUntilEmpty() {
+    VMVector* vec = newVector(4);
+    appendInts(vec, 1, 3);
+    for (int64_t i = 1; i <= 3; i += 1) {
+        CPPUNIT_ASSERT_EQUAL(i, SMALL_INT_VAL(vec->RemoveFirst()));
+    }
+    CPPUNIT_ASSERT_EQUAL((int64_t)0, sizeOf(vec));
+
+    // an empty Vector appends at the front again
+    CPPUNIT_ASSERT_EQUAL((int64_t)1, SMALL_INT_VAL(load_ptr(vec->first)));
+    appendInts(vec, 4, 7);
+    CPPUNIT_ASSERT_EQUAL((int64_t)4, capacityOf(vec));
+    CPPUNIT_ASSERT_EQUAL((int64_t)4, sizeOf(vec));
+    for (int64_t i = 1; i <= 4; i += 1) {
+        CPPUNIT_ASSERT_EQUAL(i + 3, intAt(vec, i));
+    }
+}
+
+void VectorTest::testRemoveInTheMiddle() {
+    VMVector* vec = newVector(8);
+    appendInts(vec, 1, 6);
+    CPPUNIT_ASSERT_EQUAL((int64_t)1, SMALL_INT_VAL(vec->RemoveFirst()));
+
+    // remove: 4, which is the third element. Boxed integers are compared by
+    // identity, so it is the element itself.
+    vm_oop_t four = vec->GetStorage(3);
+    CPPUNIT_ASSERT_EQUAL(load_ptr(trueObject), vec->RemoveObj(four));
+    CPPUNIT_ASSERT_EQUAL(load_ptr(falseObject), vec->RemoveObj(four));
+    CPPUNIT_ASSERT_EQUAL((int64_t)4, sizeOf(vec));
+    CPPUNIT_ASSERT_EQUAL((int64_t)2, intAt(vec, 1));
+    CPPUNIT_ASSERT_EQUAL((int64_t)3, intAt(vec, 2));
+    CPPUNIT_ASSERT_EQUAL((int64_t)5, intAt(vec, 3));
+    CPPUNIT_ASSERT_EQUAL((int64_t)6, intAt(vec, 4));
+
+    // the slot after the last element is cleared
+    VMArray* storage = load_ptr(vec->storage);
+    CPPUNIT_ASSERT_EQUAL(load_ptr(nilObject), storage->GetIndexableField(5));
+}
+
+void VectorTest::testLastAfterRemoveFirst() {
+    VMVector* vec = newVector(4);
+    appendInts(vec, 1, 3);
+    CPPUNIT_ASSERT_EQUAL((int64_t)3, SMALL_INT_VAL(vec->GetLast()));
+
+    CPPUNIT_ASSERT_EQUAL((int64_t)1, SMALL_INT_VAL(vec->RemoveFirst()));
+    CPPUNIT_ASSERT_EQUAL((int64_t)2, SMALL_INT_VAL(vec->GetFirst()));
+    CPPUNIT_ASSERT_EQUAL((int64_t)3, SMALL_INT_VAL(vec->GetLast()));
+
+    CPPUNIT_ASSERT_EQUAL((int64_t)2, SMALL_INT_VAL(vec->RemoveFirst()));
+    CPPUNIT_ASSERT_EQUAL((int64_t)3, SMALL_INT_VAL(vec->GetFirst()));
+    CPPUNIT_ASSERT_EQUAL((int64_t)3, SMALL_INT_VAL(vec->GetLast()));
+}
+
+void VectorTest::testStrategyKeptWhenGrowing() {
+    VMVector* vec = newVector(2);
+    appendInts(vec, 1, 2);
+    ArrayStrategy const strategy = load_ptr(vec->storage)->GetStrategy();
+#if USE_TAGGING
+    CPPUNIT_ASSERT_EQUAL(ARRAY_INTEGERS, strategy);
+#endif
+
+    // both by growing, and by compacting the front
+    appendInts(vec, 3, 8);
+    CPPUNIT_ASSERT_EQUAL((int64_t)8, capacityOf(vec));
+    CPPUNIT_ASSERT_EQUAL(strategy, load_ptr(vec->storage)->GetStrategy());
+    for (int64_t i = 1; i <= 5; i += 1) {
+        (void)vec->RemoveFirst();
+    }
+    VMArray* storage = load_ptr(vec->storage);
+    vec->Append(NEW_INT(9));
+    CPPUNIT_ASSERT_EQUAL(storage, load_ptr(vec->storage));
+    CPPUNIT_ASSERT_EQUAL(strategy, storage->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL((int64_t)4, sizeOf(vec));
+    for (int64_t i = 1; i <= 4; i += 1) {
+        CPPUNIT_ASSERT_EQUAL(i + 5, intAt(vec, i));
+    }
+}
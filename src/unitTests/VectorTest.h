@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cppunit/extensions/HelperMacros.h>
+
+using namespace std;
+
+class VectorTest : public CPPUNIT_NS::TestCase {
+    CPPUNIT_TEST_SUITE(VectorTest);  // NOLINT(misc-const-correctness)
+    CPPUNIT_TEST(testAppendGrows);
+    CPPUNIT_TEST(testAppendCompactsFront);
+    CPPUNIT_TEST(testAppendGrowsWhenMostlyFull);
+    CPPUNIT_TEST(testRemoveFirstUntilEmpty);
+    CPPUNIT_TEST(testRemoveInTheMiddle);
+    CPPUNIT_TEST(testLastAfterRemoveFirst);
+    CPPUNIT_TEST(testStrategyKeptWhenGrowing);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    static void testAppendGrows();
+    static void testAppendCompactsFront();
+    static void testAppendGrowsWhenMostlyFull();
+    static void testRemoveFirstUntilEmpty();
+    static void testRemoveInTheMiddle();
+    static void testLastAfterRemoveFirst();
+    static void testStrategyKeptWhenGrowing();
+};
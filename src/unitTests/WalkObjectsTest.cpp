@@ -20,6 +20,7 @@
 #include "../vm/Universe.h"
 #include "../vmobjects/ObjectFormats.h"
 #include "../vmobjects/VMArray.h"
+#include "../vmobjects/VMBigInteger.h"  // NOLINT(misc-include-cleaner)
 #include "../vmobjects/VMBlock.h"
 #include "../vmobjects/VMClass.h"
 #include "../vmobjects/VMDouble.h"
@@ -217,6 +218,28 @@ void WalkObjectsTest::testWalkMethod() {
     CPPUNIT_ASSERT_EQUAL(expectedNumberOfObjects, walkedObjects.size());
 }
 
+void WalkObjectsTest::testWalkMethodWithInlineCache() {
+    walkedObjects.clear();
+
+    VMSymbol* methodSymbol = NewSymbol("myMethodWithSend");
+    vector<BackJump> inlinedLoops;
+    VMMethod* method =
+        Universe::NewMethod(methodSymbol, 2, 0, 0, 0,
+                            new LexicalScope(nullptr, {}, {}), inlinedLoops);
+    method->SetHolder(load_ptr(symbolClass));
+
+    VMInvokable* invokable = load_ptr(objectClass)->GetInstanceInvokable(0);
+    method->GetInlineCache(0)->Update(method, load_ptr(stringClass),
+                                      invokable);
+    method->WalkObjects(collectMembers);
+
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(load_ptr(stringClass))));
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(invokable)));
+
+    const size_t expectedNumberOfObjects = NoOfFields_Method + 2;
+    CPPUNIT_ASSERT_EQUAL(expectedNumberOfObjects, walkedObjects.size());
+}
+
 void WalkObjectsTest::testWalkBlock() {
     walkedObjects.clear();
     VMSymbol* methodSymbol = NewSymbol("someMethod");
@@ -249,3 +272,27 @@ void WalkObjectsTest::testWalkArray() {
     CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(str1)));
     CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(int1)));
 }
+
+void WalkObjectsTest::testWalkUnboxedArray() {
+    // arrays without references only report their class
+    walkedObjects.clear();
+    VMArray* a = Universe::NewArray(3);
+    a->WalkObjects(collectMembers);
+    CPPUNIT_ASSERT_EQUAL(ARRAY_ALL_NIL, a->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(NoOfFields_Array, walkedObjects.size());
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(a->GetClass())));
+
+    walkedObjects.clear();
+    a->SetIndexableField(0, NEW_INT(42));
+    a->SetIndexableField(2, NEW_INT(43));
+    a->WalkObjects(collectMembers);
+#if USE_TAGGING
+    CPPUNIT_ASSERT_EQUAL(ARRAY_INTEGERS, a->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(NoOfFields_Array, walkedObjects.size());
+#else
+    // boxed integers are objects, and nil is reported as well
+    CPPUNIT_ASSERT_EQUAL(ARRAY_OBJECTS, a->GetStrategy());
+    CPPUNIT_ASSERT_EQUAL(NoOfFields_Array + 3, walkedObjects.size());
+#endif
+    CPPUNIT_ASSERT(WalkerHasFound(tmp_ptr(a->GetClass())));
+}
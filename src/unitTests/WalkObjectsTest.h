@@ -24,6 +24,7 @@ using namespace std;
 class WalkObjectsTest : public CPPUNIT_NS::TestCase {
     CPPUNIT_TEST_SUITE(WalkObjectsTest);  // NOLINT(misc-const-correctness)
     CPPUNIT_TEST(testWalkArray);
+    CPPUNIT_TEST(testWalkUnboxedArray);
     CPPUNIT_TEST(testWalkBlock);
     CPPUNIT_TEST(testWalkClass);
     CPPUNIT_TEST(testWalkDouble);
@@ -32,6 +33,7 @@ class WalkObjectsTest : public CPPUNIT_NS::TestCase {
     CPPUNIT_TEST(testWalkInteger);
     CPPUNIT_TEST(testWalkString);
     CPPUNIT_TEST(testWalkMethod);
+    CPPUNIT_TEST(testWalkMethodWithInlineCache);
     CPPUNIT_TEST(testWalkObject);
     CPPUNIT_TEST(testWalkPrimitive);
     CPPUNIT_TEST(testWalkSymbol);
@@ -43,6 +45,7 @@ public:
 
 private:
     static void testWalkArray();
+    static void testWalkUnboxedArray();
     static void testWalkBlock();
     static void testWalkClass();
     static void testWalkDouble();
@@ -51,6 +54,7 @@ private:
     static void testWalkInteger();
     static void testWalkString();
     static void testWalkMethod();
+    static void testWalkMethodWithInlineCache();
     static void testWalkObject();
     static void testWalkPrimitive();
     static void testWalkSymbol();
@@ -45,7 +45,7 @@ void WriteBarrierTest::testWriteArray() {
     VMClass* cloneClass = load_ptr(arrayClass)->CloneForMovingGC();
     VMClass* clone2Class = cloneClass->CloneForMovingGC();
     arr->SetClass(cloneClass);
-    arr->SetField(0, clone2Class);
+    arr->SetIndexableField(0, clone2Class);
     arr->SetIndexableField(0, newInt);
     arr->SetIndexableField(1, str);
     arr->SetIndexableField(2, doub);
@@ -63,7 +63,7 @@ void WriteBarrierTest::testWriteArray() {
                    cloneClass);
     TEST_WB_CALLED("VMArray failed to call writeBarrier for clazz", arr,
                    clone2Class);
-    // nilObject is assigned in constructor
+    // nilObject is assigned when the array gets its strategy
     TEST_WB_CALLED("VMArray failed to call writeBarrier for an element", arr,
                    load_ptr(nilObject));
 }
@@ -18,12 +18,16 @@
 
 #include "../misc/defs.h"
 #include "../vm/Universe.h"
+#include "ArrayStrategiesTest.h"
 #include "BasicInterpreterTests.h"
 #include "BytecodeGenerationTest.h"
 #include "CloneObjectsTest.h"
 #include "HashingTest.h"
 #include "InfIntTests.h"
+#include "InterpreterTest.h"
+#include "NativeMemoryTest.h"
 #include "TrivialMethodTest.h"
+#include "VectorTest.h"
 #include "WalkObjectsTest.h"
 
 #if GC_TYPE == GENERATIONAL
@@ -40,6 +44,10 @@ CPPUNIT_TEST_SUITE_REGISTRATION(BytecodeGenerationTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(TrivialMethodTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(BasicInterpreterTests);
 CPPUNIT_TEST_SUITE_REGISTRATION(HashingTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(InterpreterTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(ArrayStrategiesTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(VectorTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(NativeMemoryTest);
 
 int32_t main(int32_t ac, char** av) {
     Universe::Start(ac, av);
@@ -85,7 +85,7 @@ bool IsValidObject(vm_oop_t obj) {
         return false;
     }
 
-#if GC_TYPE == COPYING || GC_TYPE == DEBUG_COPYING
+#if GC_TYPE == COPYING || GC_TYPE == DEBUG_COPYING || GC_TYPE == IMMIX
     if (AS_OBJ(obj)->GetGCField() != 0) {
         // this is a properly forwarded object
         return true;
@@ -42,8 +42,14 @@
 #include "../compiler/LexicalScope.h"
 #include "../compiler/SourcecodeCompiler.h"
 #include "../interpreter/bytecodes.h"
+#include "../interpreter/SequenceProfile.h"
 #include "../lib/InfInt.h"
+#include "../memory/AllocationSite.h"
+#include "../memory/FrameStack.h"
 #include "../memory/Heap.h"
+#include "../memory/HeapSizingPolicy.h"
+#include "../memory/LargeObjectSpace.h"
+#include "../memory/ParallelMarker.h"
 #include "../misc/defs.h"
 #include "../vmobjects/IntegerBox.h"
 #include "../vmobjects/ObjectFormats.h"
@@ -78,6 +84,12 @@ static gc_oop_t prebuildInts[INT_CACHE_MAX_VALUE - INT_CACHE_MIN_VALUE + 1];
 uint8_t dumpBytecodes;
 uint8_t gcVerbosity;
 bool abortOnCoreLibHashMismatch = false;
+#ifdef USE_JIT
+bool useJIT = false;
+#endif
+#ifdef USE_REGISTER_BYTECODES
+bool useRegisterBytecodes = false;
+#endif
 
 static std::string bm_name;
 
@@ -87,6 +99,7 @@ map<GCSymbol*, gc_oop_t> Universe::globals;
 map<uint8_t, GCClass*> Universe::blockClassesByNoOfArgs;
 vector<std::string> Universe::classPath;
 size_t Universe::heapSize;
+size_t Universe::gcThreads;
 
 #ifdef LOG_RECEIVER_TYPES
 map<std::string, long> Universe::receiverTypes;
@@ -108,6 +121,8 @@ void Universe::Shutdown() {
                    to_string(Timer::GCTimer.GetTotalTime()) + "] msec\n");
     }
 
+    ParallelMarker::Destroy();
+
 #ifdef GENERATE_INTEGER_HISTOGRAM
     std::string file_name_hist = std::string(bm_name);
     file_name_hist.append("_integer_histogram.csv");
@@ -120,6 +135,12 @@ void Universe::Shutdown() {
     }
 #endif
 
+#ifdef BYTECODE_SEQUENCE_PROFILE
+    std::string file_name_sequences = std::string(bm_name);
+    file_name_sequences.append("_bytecode_sequences.csv");
+    SequenceProfile::WriteCSV(file_name_sequences);
+#endif
+
 #ifdef LOG_RECEIVER_TYPES
     std::string file_name_receivers = std::string(bm_name);
     file_name_receivers.append("_receivers.csv");
@@ -159,6 +180,8 @@ static void printVmConfig() {
         cout << "\tgarbage collector: mark-sweep\n";
     } else if (GC_TYPE == DEBUG_COPYING) {  // NOLINT(misc-redundant-expression)
         cout << "\tgarbage collector: debug copying\n";
+    } else if (GC_TYPE == IMMIX) {  // NOLINT(misc-redundant-expression)
+        cout << "\tgarbage collector: immix\n";
     } else {
         cout << "\tgarbage collector: unknown\n";
     }
@@ -169,6 +192,12 @@ static void printVmConfig() {
         cout << "\tnot tagging integers\n";
     }
 
+    if (TAGGED_DOUBLES) {
+        cout << "\twith tagged doubles\n";
+    } else {
+        cout << "\tnot tagging doubles\n";
+    }
+
     if (CACHE_INTEGER) {
         cout << "\tcaching integers from " << INT_CACHE_MIN_VALUE << " to "
              << INT_CACHE_MAX_VALUE << "\n";
@@ -182,6 +211,18 @@ static void printVmConfig() {
         cout << "\tVector primitives: disabled\n";
     }
 
+#ifdef USE_JIT
+    cout << "\tbaseline JIT: available (enable with -jit)\n";
+#else
+    cout << "\tbaseline JIT: not available\n";
+#endif
+
+#ifdef USE_REGISTER_BYTECODES
+    cout << "\tregister bytecodes: available (enable with -reg)\n";
+#else
+    cout << "\tregister bytecodes: not available\n";
+#endif
+
     cout << "--------------------------------------\n";
 }
 
@@ -201,6 +242,33 @@ vector<std::string> Universe::handleArguments(int32_t argc, char** argv) {
             ++dumpBytecodes;
         } else if (!sawOtherArgs && strncmp(argv[i], "-cfg", 4) == 0) {
             printVmConfig();
+        } else if (!sawOtherArgs && strcmp(argv[i], "-gcthreads") == 0) {
+            // NOLINTNEXTLINE (cert-err34-c)
+            if ((argc == i + 1) || sscanf(argv[++i], "%zu", &gcThreads) != 1 ||
+                gcThreads == 0) {
+                printUsageAndExit(argv[0]);
+            }
+        } else if (!sawOtherArgs && strcmp(argv[i], "-lothreshold") == 0) {
+            // NOLINTNEXTLINE (cert-err34-c)
+            if ((argc == i + 1) ||
+                sscanf(argv[++i], "%zu", &LargeObjectSpace::Threshold) != 1 ||
+                LargeObjectSpace::Threshold == 0) {
+                printUsageAndExit(argv[0]);
+            }
+        } else if (!sawOtherArgs && strcmp(argv[i], "-gcpause") == 0) {
+            // NOLINTNEXTLINE (cert-err34-c)
+            if ((argc == i + 1) ||
+                sscanf(argv[++i], "%lf", &HeapSizingPolicy::PauseGoal) != 1 ||
+                HeapSizingPolicy::PauseGoal <= 0.0) {
+                printUsageAndExit(argv[0]);
+            }
+        } else if (!sawOtherArgs && strcmp(argv[i], "-gcratio") == 0) {
+            // NOLINTNEXTLINE (cert-err34-c)
+            if ((argc == i + 1) ||
+                sscanf(argv[++i], "%zu", &HeapSizingPolicy::GCTimeRatio) != 1 ||
+                HeapSizingPolicy::GCTimeRatio == 0) {
+                printUsageAndExit(argv[0]);
+            }
         } else if (!sawOtherArgs && strncmp(argv[i], "-g", 2) == 0) {
             ++gcVerbosity;
         } else if (!sawOtherArgs && strncmp(argv[i], "-H", 2) == 0) {
@@ -216,12 +284,39 @@ vector<std::string> Universe::handleArguments(int32_t argc, char** argv) {
             } else {
                 printUsageAndExit(argv[0]);
             }
+        } else if (!sawOtherArgs && strncmp(argv[i], "-Xmax", 5) == 0) {
+            size_t max_size = 0;
+            char unit[3];
+            // NOLINTNEXTLINE (cert-err34-c)
+            if (sscanf(argv[i], "-Xmax%zu%2s", &max_size, unit) == 2) {
+                if (strcmp(unit, "KB") == 0) {
+                    HeapSizingPolicy::MaxHeapSize = max_size * 1024;
+                } else if (strcmp(unit, "MB") == 0) {
+                    HeapSizingPolicy::MaxHeapSize = max_size * 1024 * 1024;
+                }
+            } else {
+                printUsageAndExit(argv[0]);
+            }
         } else if (!sawOtherArgs && ((strncmp(argv[i], "-h", 2) == 0) ||
                                      (strncmp(argv[i], "--help", 6) == 0))) {
             printUsageAndExit(argv[0]);
         } else if (!sawOtherArgs &&
                    (strncmp(argv[i], "-prim-hash-check", 16)) == 0) {
             abortOnCoreLibHashMismatch = true;
+        } else if (!sawOtherArgs && strcmp(argv[i], "-jit") == 0) {
+#ifdef USE_JIT
+            useJIT = true;
+#else
+            ErrorPrint("Warning: -jit ignored, VM was built without USE_JIT\n");
+#endif
+        } else if (!sawOtherArgs && strcmp(argv[i], "-reg") == 0) {
+#ifdef USE_REGISTER_BYTECODES
+            useRegisterBytecodes = true;
+#else
+            ErrorPrint(
+                "Warning: -reg ignored, VM was built without "
+                "USE_REGISTER_BYTECODES\n");
+#endif
         } else {
             sawOtherArgs = true;
 
@@ -305,6 +400,21 @@ void Universe::printUsageAndExit(char* executable) {
         << "\n";
     cout << "    -HxMB set the heap size to x MB (default: 1 MB)\n";
     cout << "    -HxKB set the heap size to x KB (default: 1 MB)\n";
+    cout << "    -XmaxxMB|-XmaxxKB do not grow the heap beyond x MB or KB "
+            "(default: unlimited)\n";
+    cout << "    -gcpause ms shrink the heap while collections pause for "
+            "longer than ms\n";
+    cout << "    -gcratio n grow the heap while more than 1/(1+n) of the time "
+            "is spent in\n"
+         << "               collections (default: 19)\n";
+    cout << "    -gcthreads n mark with n threads (default: 1, needs "
+            "MARK_SWEEP or GENERATIONAL)\n";
+    cout << "    -lothreshold n allocate objects bigger than n bytes in the "
+            "large-object space\n"
+         << "                   (default: 65536)\n";
+    cout << "    -jit compile hot methods to native code (needs USE_JIT)\n";
+    cout << "    -reg translate hot methods to register bytecodes (needs "
+            "USE_REGISTER_BYTECODES)\n";
     cout << "    -h|--help show this help\n";
 
     Quit(ERR_SUCCESS);
@@ -384,6 +494,7 @@ void Universe::initialize(int32_t _argc, char** _argv) {
     InitializeAllocationLog();
 
     heapSize = 1ULL * 1024 * 1024;
+    gcThreads = 1;
 
     vector<std::string> argv = handleArguments(_argc, _argv);
 
@@ -393,6 +504,8 @@ void Universe::initialize(int32_t _argc, char** _argv) {
     }
 
     Heap<HEAP_CLS>::InitializeHeap(heapSize);
+    FrameStack::Initialize(FRAME_STACK_SIZE);
+    ParallelMarker::Initialize(gcThreads);
 
 #if CACHE_INTEGER
     // create prebuilt integers
@@ -434,6 +547,7 @@ void Universe::initialize(int32_t _argc, char** _argv) {
 Universe::~Universe() {
     // check done inside
     Heap<HEAP_CLS>::DestroyHeap();
+    FrameStack::Destroy();
 }
 
 VMObject* Universe::InitializeGlobals() {
@@ -490,6 +604,9 @@ VMObject* Universe::InitializeGlobals() {
 
 #if USE_TAGGING
     GlobalBox::updateIntegerBox(NewInteger(1));
+#endif
+#if TAGGED_DOUBLES
+    GlobalBox::updateDoubleBox(NewDouble(0.0));
 #endif
     InitializeSymbols();
     obtain_vtables_of_known_classes(load_ptr(symbolSelf));
@@ -703,6 +820,8 @@ VMArray* Universe::NewArray(size_t size) {
         VMArray(size, additionalBytes);
     // NOLINTNEXTLINE(misc-redundant-expression)
     if ((GC_TYPE == GENERATIONAL) && outsideNursery) {
+        // the elements are not initialized, and are stored with a barrier
+        // once the array gets a strategy
         result->SetGCField(MASK_OBJECT_IS_OLD);
     }
 
@@ -713,35 +832,8 @@ VMArray* Universe::NewArray(size_t size) {
 }
 
 VMArray* Universe::NewExpandedArrayFromArray(size_t size, VMArray* array) {
-    size_t const additionalBytes = size * sizeof(VMObject*);
-
-    bool outsideNursery = false;  // NOLINT
-
-    size_t const currentArraySize = array->GetNumberOfIndexableFields();
-
-#if GC_TYPE == GENERATIONAL
-    // if the array is too big for the nursery, we will directly allocate a
-    // mature object
-    outsideNursery = additionalBytes + sizeof(VMArray) >
-                     GetHeap<HEAP_CLS>()->GetMaxNurseryObjectSize();
-#endif
-
-    auto* result = new (GetHeap<HEAP_CLS>(),
-                        additionalBytes ALLOC_OUTSIDE_NURSERY(outsideNursery))
-        VMArray(size, additionalBytes, currentArraySize);
-    // NOLINTNEXTLINE(misc-redundant-expression)
-    if ((GC_TYPE == GENERATIONAL) && outsideNursery) {
-        result->SetGCField(MASK_OBJECT_IS_OLD);
-    }
-
-    result->SetClass(load_ptr(arrayClass));
-
-    LOG_ALLOCATION("VMArray", result->GetObjectSize());
-
-    // Now copy the contents of the old array into the new one
-    for (size_t i = 0; i < currentArraySize; ++i) {
-        result->SetIndexableField(i, array->GetIndexableField(i));
-    }
+    VMArray* result = NewArray(size);
+    array->CopyIndexableFieldsTo(result);
     return result;
 }
 
@@ -822,35 +914,50 @@ VMDouble* Universe::NewDouble(double value) {
 }
 
 VMFrame* Universe::NewFrame(VMFrame* previousFrame, VMMethod* method) {
-    VMFrame* result = nullptr;
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    result = load_ptr(method->GetCachedFrame());
-    if (result != nullptr) {
-        method->SetCachedFrame(nullptr);
-        result->SetPreviousFrameOnReuse(previousFrame);
-        return result;
-    }
-#endif
     size_t const length = method->GetNumberOfArguments() +
                           method->GetNumberOfLocals() +
                           method->GetMaximumNumberOfStackElements();
 
     size_t const additionalBytes = length * sizeof(VMObject*);
-    result = new (GetHeap<HEAP_CLS>(), additionalBytes)
+    auto* result = new (GetHeap<HEAP_CLS>(), additionalBytes)
         VMFrame(additionalBytes, method, previousFrame);
 
     LOG_ALLOCATION("VMFrame", result->GetObjectSize());
     return result;
 }
 
-VMObject* Universe::NewInstance(VMClass* classOfInstance) {
+VMObject* Universe::NewInstance(VMClass* classOfInstance,
+                                [[maybe_unused]] AllocationSite* site) {
     size_t const numOfFields = classOfInstance->GetNumberOfInstanceFields();
     // the additional space needed is calculated from the number of fields
     size_t const additionalBytes = numOfFields * sizeof(VMObject*);
-    auto* result = new (GetHeap<HEAP_CLS>(), additionalBytes)
+
+#if GC_TYPE == GENERATIONAL
+    // sites of which almost all objects survive allocate mature objects
+    bool const outsideNursery = site != nullptr && site->pretenure;
+#endif
+
+    auto* result = new (GetHeap<HEAP_CLS>(),
+                        additionalBytes ALLOC_OUTSIDE_NURSERY(outsideNursery))
         VMObject(numOfFields, additionalBytes + sizeof(VMObject));
     result->SetClass(classOfInstance);
 
+#if GC_TYPE == GENERATIONAL
+    if (outsideNursery) {
+        result->SetGCField(MASK_OBJECT_IS_OLD);
+        // the class and the fields were set before the object was old, and
+        // thus, without a barrier, which is only needed while they are still
+        // in the nursery
+        GenerationalHeap* heap = GetHeap<HEAP_CLS>();
+        if (heap->isObjectInNursery(classOfInstance) ||
+            heap->isObjectInNursery(load_ptr(nilObject))) {
+            write_barrier(result, load_ptr(nilObject));
+        }
+    } else if (site != nullptr) {
+        GetHeap<HEAP_CLS>()->RecordAllocationSite(result, site);
+    }
+#endif
+
     LOG_ALLOCATION(classOfInstance->GetName()->GetStdString(),
                    result->GetObjectSize());
     return result;
@@ -1002,8 +1109,22 @@ VMString* Universe::NewString(const std::string& str) {
 }
 
 VMString* Universe::NewString(const size_t length, const char* str) {
-    auto* result =
-        new (GetHeap<HEAP_CLS>(), PADDED_SIZE(length)) VMString(length, str);
+    bool outsideNursery = false;  // NOLINT
+
+#if GC_TYPE == GENERATIONAL
+    // if the string is too big for the nursery, we will directly allocate a
+    // mature object
+    outsideNursery = PADDED_SIZE(length) + sizeof(VMString) >
+                     GetHeap<HEAP_CLS>()->GetMaxNurseryObjectSize();
+#endif
+
+    auto* result = new (GetHeap<HEAP_CLS>(),
+                        PADDED_SIZE(length) ALLOC_OUTSIDE_NURSERY(
+                            outsideNursery)) VMString(length, str);
+    // NOLINTNEXTLINE(misc-redundant-expression)
+    if ((GC_TYPE == GENERATIONAL) && outsideNursery) {
+        result->SetGCField(MASK_OBJECT_IS_OLD);
+    }
 
     LOG_ALLOCATION("VMString", result->GetObjectSize());
     return result;
@@ -38,12 +38,23 @@
 #include "Print.h"
 
 class SourcecodeCompiler;
+struct AllocationSite;
 
 // for runtime debug
 extern uint8_t dumpBytecodes;
 extern uint8_t gcVerbosity;
 extern bool abortOnCoreLibHashMismatch;
 
+#ifdef USE_JIT
+// compile hot methods to native code
+extern bool useJIT;
+#endif
+
+#ifdef USE_REGISTER_BYTECODES
+// translate hot methods to register bytecodes
+extern bool useRegisterBytecodes;
+#endif
+
 using namespace std;
 class Universe {
 public:
@@ -82,7 +93,8 @@ public:
                                size_t maxStackDepth,
                                LexicalScope* /*lexicalScope*/,
                                vector<BackJump>& inlinedLoops);
-    static VMObject* NewInstance(VMClass* /*classOfInstance*/);
+    static VMObject* NewInstance(VMClass* /*classOfInstance*/,
+                                 AllocationSite* /*site*/ = nullptr);
     static VMObject* NewInstanceWithoutFields();
     static VMInteger* NewInteger(int64_t /*value*/);
 
@@ -93,6 +105,16 @@ public:
                                               bool /* negateValue */);
     static void WalkGlobals(walk_heap_fn /*walk*/);
     static VMDouble* NewDouble(double /*value*/);
+#if TAGGED_DOUBLES
+    /// Returns an immediate double, or a boxed one if the value cannot be
+    /// tagged.
+    static inline vm_oop_t NewTaggedDouble(double value) {
+        if (likely(CanTagDouble(value))) {
+            return TagDouble(value);
+        }
+        return (vm_oop_t)NewDouble(value);
+    }
+#endif
     static VMClass* NewMetaclassClass();
     static VMString* NewString(const std::string& str);
     static VMString* NewString(size_t length, const char* str);
@@ -146,6 +168,7 @@ private:
     static void initialize(int32_t _argc, char** _argv);
 
     static size_t heapSize;
+    static size_t gcThreads;
     static map<GCSymbol*, gc_oop_t> globals;
 
     static map<uint8_t, GCClass*> blockClassesByNoOfArgs;
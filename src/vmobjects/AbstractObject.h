@@ -13,6 +13,7 @@
 #include "../memory/CopyingHeap.h"
 #include "../memory/DebugCopyingHeap.h"
 #include "../memory/GenerationalHeap.h"
+#include "../memory/ImmixHeap.h"
 #include "../memory/MarkSweepHeap.h"
 #include "../misc/defs.h"
 #include "../vm/Print.h"
@@ -56,6 +57,15 @@ public:
 
     virtual void WalkObjects(walk_heap_fn /*walk*/) {}
 
+#ifdef CARD_MARKING
+    /// Walks at least the references that are stored in [start, end), which
+    /// are the dirty cards of the object.
+    virtual void WalkObjectsInRange(walk_heap_fn walk, const void* /*start*/,
+                                    const void* /*end*/) {
+        WalkObjects(walk);
+    }
+#endif
+
     [[nodiscard]] inline virtual VMSymbol* GetFieldName(
         size_t /*index*/) const {
         ErrorPrint("this object doesn't support GetFieldName\n");
@@ -0,0 +1,83 @@
+#include "InlineCache.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../memory/Heap.h"  // NOLINT(misc-include-cleaner) needed for the write barrier
+#include "../misc/defs.h"
+#include "ObjectFormats.h"
+#include "VMClass.h"
+#include "VMInvokable.h"
+#include "VMMethod.h"
+#include "VMSymbol.h"
+
+size_t InlineCache::epoch = 0;
+
+void InlineCache::Update(VMMethod* holder, VMClass* cls,
+                         VMInvokable* invokable) {
+    if (validInEpoch != epoch) {
+        validInEpoch = epoch;
+        numEntries = 0;
+        megamorphic = false;
+    }
+
+    if (megamorphic) {
+        return;
+    }
+
+    if (numEntries == INLINE_CACHE_SIZE) {
+        // drop the entries, they are not going to be used anymore
+        for (uint8_t i = 0; i < numEntries; i += 1) {
+            classes[i] = nullptr;
+            invokables[i] = nullptr;
+        }
+        numEntries = 0;
+        megamorphic = true;
+        return;
+    }
+
+    classes[numEntries] = store_with_separate_barrier(cls);
+    invokables[numEntries] = store_with_separate_barrier(invokable);
+    write_barrier(holder, cls);
+    write_barrier(holder, invokable);
+    numEntries += 1;
+}
+
+void InlineCache::UpdateFieldIndex(VMMethod* holder, VMClass* cls,
+                                   VMSymbol* name, int64_t index) {
+    if (fieldIndexes == nullptr) {
+        fieldIndexes = new FieldIndexCache();
+    }
+
+    if (fieldIndexes->validInEpoch != epoch) {
+        *fieldIndexes = FieldIndexCache();
+        fieldIndexes->validInEpoch = epoch;
+    }
+
+    uint8_t const i = fieldIndexes->nextEntry;
+    fieldIndexes->nextEntry = (i + 1) % FIELD_INDEX_CACHE_SIZE;
+
+    fieldIndexes->classes[i] = store_with_separate_barrier(cls);
+    fieldIndexes->names[i] = store_with_separate_barrier(name);
+    fieldIndexes->indexes[i] = index;
+    write_barrier(holder, cls);
+    write_barrier(holder, name);
+}
+
+void InlineCache::WalkObjects(walk_heap_fn walk) {
+    for (uint8_t i = 0; i < numEntries; i += 1) {
+        classes[i] = static_cast<GCClass*>(walk(classes[i]));
+        invokables[i] = static_cast<GCInvokable*>(walk(invokables[i]));
+    }
+
+    if (fieldIndexes != nullptr) {
+        for (uint8_t i = 0; i < FIELD_INDEX_CACHE_SIZE; i += 1) {
+            if (fieldIndexes->classes[i] != nullptr) {
+                fieldIndexes->classes[i] =
+                    static_cast<GCClass*>(walk(fieldIndexes->classes[i]));
+                fieldIndexes->names[i] =
+                    static_cast<GCSymbol*>(walk(fieldIndexes->names[i]));
+            }
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../misc/defs.h"
+#include "ObjectFormats.h"
+
+#if GC_TYPE == GENERATIONAL
+  #include "../memory/AllocationSite.h"
+#endif
+
+// number of receiver classes a send site caches before it goes megamorphic
+#define INLINE_CACHE_SIZE 4
+
+// number of receiver class and field name pairs a site of #instVarNamed:
+// caches the field index for
+#define FIELD_INDEX_CACHE_SIZE 4
+
+/**
+ * The field indexes that a site of #instVarNamed: looked up. The class of an
+ * object is its shape: objects cannot gain fields, and the layout of a class
+ * is fixed when it is loaded. Thus, a receiver class and field name determine
+ * the index, as long as the class is not reloaded. Entries are replaced
+ * round-robin.
+ */
+struct FieldIndexCache {
+    size_t validInEpoch{0};
+    uint8_t nextEntry{0};
+    GCClass* classes[FIELD_INDEX_CACHE_SIZE]{};
+    GCSymbol* names[FIELD_INDEX_CACHE_SIZE]{};
+    int64_t indexes[FIELD_INDEX_CACHE_SIZE]{};
+};
+
+/**
+ * A per-send-site cache of receiver class to invokable mappings.
+ *
+ * A site starts out empty, becomes monomorphic with its first lookup, and
+ * polymorphic as further receiver classes are seen. Once more than
+ * INLINE_CACHE_SIZE classes have been seen, the site is megamorphic, stops
+ * caching, and sends from it use the normal class lookup.
+ *
+ * All caches are invalidated at once by bumping a global epoch, which is done
+ * whenever the methods of a class change, i.e., when primitives are installed
+ * or a class is (re)loaded.
+ */
+class InlineCache {
+public:
+    InlineCache() = default;
+    ~InlineCache() { delete fieldIndexes; }
+
+    InlineCache(const InlineCache&) = delete;
+    InlineCache& operator=(const InlineCache&) = delete;
+
+    [[nodiscard]] inline VMInvokable* Lookup(const VMClass* cls) const {
+        if (unlikely(validInEpoch != epoch)) {
+            return nullptr;
+        }
+
+        for (uint8_t i = 0; i < numEntries; i += 1) {
+            if (load_ptr(classes[i]) == cls) {
+                return load_ptr(invokables[i]);
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] inline bool IsMegamorphic() const {
+        return validInEpoch == epoch && megamorphic;
+    }
+
+    [[nodiscard]] inline uint8_t GetNumberOfEntries() const {
+        return validInEpoch == epoch ? numEntries : 0;
+    }
+
+    /// A site whose quickened bytecode saw operands it could not handle is
+    /// not quickened again. This does not depend on the class hierarchy and
+    /// therefore survives invalidation.
+    [[nodiscard]] inline bool IsQuickeningDisabled() const {
+        return quickeningDisabled;
+    }
+
+    inline void DisableQuickening() { quickeningDisabled = true; }
+
+    /// Records the result of a lookup. The holder is the method owning the
+    /// cache, which needs to see the write barrier.
+    void Update(VMMethod* holder, VMClass* cls, VMInvokable* invokable);
+
+    void WalkObjects(walk_heap_fn walk);
+
+    static inline void InvalidateAll() { epoch += 1; }
+
+    /// Returns the cached index of the named field of instances of cls, or
+    /// -1 if there is none.
+    [[nodiscard]] inline int64_t LookupFieldIndex(const VMClass* cls,
+                                                  const VMSymbol* name) const {
+        if (unlikely(fieldIndexes == nullptr ||
+                     fieldIndexes->validInEpoch != epoch)) {
+            return -1;
+        }
+
+        for (uint8_t i = 0; i < FIELD_INDEX_CACHE_SIZE; i += 1) {
+            if (load_ptr(fieldIndexes->classes[i]) == cls &&
+                load_ptr(fieldIndexes->names[i]) == name) {
+                return fieldIndexes->indexes[i];
+            }
+        }
+        return -1;
+    }
+
+    /// Records the index of a field, allocating the field index cache on
+    /// first use. The holder is the method owning the cache.
+    void UpdateFieldIndex(VMMethod* holder, VMClass* cls, VMSymbol* name,
+                          int64_t index);
+
+#if GC_TYPE == GENERATIONAL
+    /// The statistics of the objects that are instantiated by this site.
+    [[nodiscard]] inline AllocationSite* GetAllocationSite() {
+        return &allocationSite;
+    }
+#endif
+
+private:
+    static size_t epoch;
+
+    size_t validInEpoch{0};
+    uint8_t numEntries{0};
+    bool megamorphic{false};
+    bool quickeningDisabled{false};
+    GCClass* classes[INLINE_CACHE_SIZE]{};
+    GCInvokable* invokables[INLINE_CACHE_SIZE]{};
+
+    // only allocated for sites of #instVarNamed:
+    FieldIndexCache* fieldIndexes{nullptr};
+
+#if GC_TYPE == GENERATIONAL
+    AllocationSite allocationSite;
+#endif
+};
@@ -3,7 +3,14 @@
 #include "ObjectFormats.h"
 #include "VMInteger.h"
 
+#if TAGGED_DOUBLES
+  #include "VMDouble.h"
+#endif
+
 GCInteger* GlobalBox::integerBox = nullptr;
+#if TAGGED_DOUBLES
+GCDouble* GlobalBox::doubleBox = nullptr;
+#endif
 
 void GlobalBox::updateIntegerBox(VMInteger* newValue) {
     integerBox = store_root(newValue);
@@ -13,6 +20,19 @@ VMInteger* GlobalBox::IntegerBox() {
     return load_ptr(integerBox);
 }
 
+#if TAGGED_DOUBLES
+void GlobalBox::updateDoubleBox(VMDouble* newValue) {
+    doubleBox = store_root(newValue);
+}
+
+VMDouble* GlobalBox::DoubleBox() {
+    return load_ptr(doubleBox);
+}
+#endif
+
 void GlobalBox::WalkGlobals(walk_heap_fn walk) {
     integerBox = static_cast<GCInteger*>(walk(integerBox));
+#if TAGGED_DOUBLES
+    doubleBox = static_cast<GCDouble*>(walk(doubleBox));
+#endif
 }
@@ -5,11 +5,18 @@
 class GlobalBox {
 public:
     static VMInteger* IntegerBox();
+#if TAGGED_DOUBLES
+    static VMDouble* DoubleBox();
+#endif
 
     static void WalkGlobals(walk_heap_fn walk);
 
 private:
     static void updateIntegerBox(VMInteger* /*newValue*/);
     static GCInteger* integerBox;
+#if TAGGED_DOUBLES
+    static void updateDoubleBox(VMDouble* /*newValue*/);
+    static GCDouble* doubleBox;
+#endif
     friend class Universe;
 };
@@ -25,8 +25,15 @@
  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  THE SOFTWARE.
  */
+#include <cstdint>
+#include <cstring>
+
 #include "../misc/defs.h"
 
+#ifdef INCREMENTAL_MARKING
+  #include "../memory/IncrementalMarker.h"
+#endif
+
 // some MACROS for integer tagging
 /**
  * The second-highest bit of a 64bit integer is not useable, because we need it
@@ -79,17 +86,38 @@ __attribute__((always_inline)) inline bool VMTAGGED_INTEGER_WITHIN_RANGE_CHECK(
   #define SMALL_INT_VAL(X) \
       ((int64_t)(X) >> 1U) /* NOLINT (hicpp-signed-bitwise) */
   #define NEW_INT(X) (TAG_INTEGER((X)))
-  #define IS_TAGGED(X) ((bool)((uintptr_t)(X) & 1U))
-  #define IS_SMALL_INT(X) IS_TAGGED(X)
   #define IS_BIG_INT(X) IsVMBigInteger(X)
   #define AS_BIG_INT(X) (static_cast<VMBigInteger*>(X))
-  #define IS_DOUBLE(X) IsVMDouble(X)
-  #define AS_DOUBLE(X) (static_cast<VMDouble*>(X)->GetEmbeddedDouble())
-  #define CLASS_OF(X)                        \
-      (IS_TAGGED(X) ? load_ptr(integerClass) \
-                    : ((AbstractVMObject*)(X))->GetClass())
-  #define AS_OBJ(X) \
-      (IS_TAGGED(X) ? GlobalBox::IntegerBox() : ((AbstractVMObject*)(X)))
+  #if TAGGED_DOUBLES
+    // integers end in 1, doubles in 10, and pointers in 00
+    #define IS_TAGGED(X) ((bool)((uintptr_t)(X) & 3U))
+    #define IS_SMALL_INT(X) ((bool)((uintptr_t)(X) & 1U))
+    #define IS_TAGGED_DOUBLE(X) (((uintptr_t)(X) & 3U) == 2U)
+    #define NEW_DOUBLE(X) (Universe::NewTaggedDouble(X))
+    #define IS_DOUBLE(X) (IS_TAGGED_DOUBLE(X) || IsVMDouble(X))
+    #define AS_DOUBLE(X)                      \
+        (IS_TAGGED_DOUBLE(X) ? UntagDouble(X) \
+                             : static_cast<VMDouble*>(X)->GetEmbeddedDouble())
+    #define CLASS_OF(X)                                \
+        (IS_SMALL_INT(X)       ? load_ptr(integerClass) \
+         : IS_TAGGED_DOUBLE(X) ? load_ptr(doubleClass)  \
+                               : ((AbstractVMObject*)(X))->GetClass())
+    #define AS_OBJ(X)                                                      \
+        (IS_SMALL_INT(X)       ? GlobalBox::IntegerBox()                   \
+         : IS_TAGGED_DOUBLE(X) ? (AbstractVMObject*)GlobalBox::DoubleBox() \
+                               : ((AbstractVMObject*)(X)))
+  #else
+    #define IS_TAGGED(X) ((bool)((uintptr_t)(X) & 1U))
+    #define IS_SMALL_INT(X) IS_TAGGED(X)
+    #define NEW_DOUBLE(X) (Universe::NewDouble(X))
+    #define IS_DOUBLE(X) IsVMDouble(X)
+    #define AS_DOUBLE(X) (static_cast<VMDouble*>(X)->GetEmbeddedDouble())
+    #define CLASS_OF(X)                        \
+        (IS_TAGGED(X) ? load_ptr(integerClass) \
+                      : ((AbstractVMObject*)(X))->GetClass())
+    #define AS_OBJ(X) \
+        (IS_TAGGED(X) ? GlobalBox::IntegerBox() : ((AbstractVMObject*)(X)))
+  #endif
 #else
   #define SMALL_INT_VAL(X) (static_cast<VMInteger*>(X)->GetEmbeddedInteger())
   #define NEW_INT(X) (Universe::NewInteger(X))
@@ -97,6 +125,7 @@ __attribute__((always_inline)) inline bool VMTAGGED_INTEGER_WITHIN_RANGE_CHECK(
   #define IS_SMALL_INT(X) IsVMInteger(X)
   #define IS_BIG_INT(X) IsVMBigInteger(X)
   #define AS_BIG_INT(X) (static_cast<VMBigInteger*>(X))
+  #define NEW_DOUBLE(X) (Universe::NewDouble(X))
   #define IS_DOUBLE(X) IsVMDouble(X)
   #define AS_DOUBLE(X) (static_cast<VMDouble*>(X)->GetEmbeddedDouble())
   #define CLASS_OF(X) (AS_OBJ(X)->GetClass())
@@ -160,6 +189,54 @@ public:
 typedef VMOop* vm_oop_t;
 typedef GCOop* gc_oop_t;
 
+#if TAGGED_DOUBLES
+/**
+ * Immediate doubles keep their sign and mantissa, but only 9 of the 11 bits of
+ * the exponent, which is rotated and rebased as in the 64-bit Spur VM. This
+ * covers magnitudes from 2^-255 to 2^256, and zero. Other doubles, including
+ * infinity and NaN, are boxed.
+ */
+  #define TAGGED_DOUBLE_EXPONENT_OFFSET ((uint64_t)(1023 - 255) << 53U)
+
+// the bits with the sign moved from the top to the lowest bit
+inline uint64_t rotatedDoubleBits(double value) {
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits << 1U) | (bits >> 63U);
+}
+
+inline bool CanTagDouble(double value) {
+    uint64_t const rotated = rotatedDoubleBits(value);
+    if (rotated <= 1) {
+        return true;
+    }
+
+    // the rebased bits need to fit into 62 bits, and must not be taken for
+    // zero
+    uint64_t const rebased = rotated - TAGGED_DOUBLE_EXPONENT_OFFSET;
+    return rebased - 2 < ((uint64_t)1 << 62U) - 2;
+}
+
+inline vm_oop_t TagDouble(double value) {
+    uint64_t rotated = rotatedDoubleBits(value);
+    if (rotated > 1) {
+        rotated -= TAGGED_DOUBLE_EXPONENT_OFFSET;
+    }
+    return (vm_oop_t)((rotated << 2U) | 2U);
+}
+
+inline double UntagDouble(const void* tagged) {
+    uint64_t rotated = (uint64_t)tagged >> 2U;
+    if (rotated > 1) {
+        rotated += TAGGED_DOUBLE_EXPONENT_OFFSET;
+    }
+    uint64_t const bits = (rotated >> 1U) | (rotated << 63U);
+    double value = 0.0;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+#endif
+
 /**
  We need to distinguish between pointers that need to be handled with a
  read barrier, and between pointers that already went through it.
@@ -227,9 +304,17 @@ inline typename T::Stored* store_with_separate_barrier(T* vm_val) {
     return (typename T::Stored*)vm_val;
 }
 
-/** Standard assignment of pointer to field, including write barrier. */
-#define store_ptr(field, val)                 \
+/** Standard assignment of pointer to field, including write barriers. */
+#define store_ptr(field, val)        \
+    satb_write_barrier(this, field); \
+    store_ptr_into_empty(field, val)
+
+/** Assignment of pointer to a field that does not hold a reference yet, e.g.,
+ * an argument of a new frame, or the slot above the stack pointer. The field
+ * may contain garbage, which must not be given to the barrier of incremental
+ * marking. */
+#define store_ptr_into_empty(field, val)      \
     field = store_with_separate_barrier(val); \
-    write_barrier(this, val)
+    write_barrier_slot(this, &(field), val)
 
 typedef gc_oop_t (*walk_heap_fn)(gc_oop_t);
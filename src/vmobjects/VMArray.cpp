@@ -28,26 +28,62 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <string>
 
 #include "../memory/Heap.h"
 #include "../misc/defs.h"
+#include "../vm/Globals.h"
 #include "../vm/Print.h"
 #include "../vm/Universe.h"
 #include "../vmobjects/ObjectFormats.h"
+#include "../vmobjects/VMBigInteger.h"  // NOLINT(misc-include-cleaner)
+#include "../vmobjects/VMDouble.h"     // NOLINT(misc-include-cleaner)
 #include "../vmobjects/VMObject.h"
 
 const size_t VMArray::VMArrayNumberOfFields = 0;
 
-VMArray* VMArray::Copy() const {
-    VMArray* copy = Universe::NewArray(GetNumberOfIndexableFields());
+static inline bool isNilDouble(double value) {
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits == ARRAY_NIL_DOUBLE_BITS;
+}
 
-    const size_t additionalSpace = totalObjectSize - sizeof(VMArray);
-    void* destination = SHIFTED_PTR(copy, sizeof(VMArray));
-    const void* source = SHIFTED_PTR(this, sizeof(VMArray));
-    memcpy(destination, source, additionalSpace);
+static inline double nilDouble() {
+    uint64_t const bits = ARRAY_NIL_DOUBLE_BITS;
+    double value = 0.0;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/// Whether the value can be stored unboxed into a DOUBLES array, and be
+/// read back as the same value.
+static inline bool isUnboxableDouble(vm_oop_t value) {
+#if TAGGED_DOUBLES
+    return IS_TAGGED_DOUBLE(value) && !isNilDouble(AS_DOUBLE(value));
+#else
+    (void)value;
+    return false;
+#endif
+}
 
+/// The strategy for an ALL_NIL array, in which the value is stored.
+static ArrayStrategy strategyFor(vm_oop_t value) {
+#if USE_TAGGING
+    if (IS_SMALL_INT(value)) {
+        return ARRAY_INTEGERS;
+    }
+#endif
+    if (isUnboxableDouble(value)) {
+        return ARRAY_DOUBLES;
+    }
+    return ARRAY_OBJECTS;
+}
+
+VMArray* VMArray::Copy() const {
+    VMArray* copy = Universe::NewArray(GetNumberOfIndexableFields());
+    CopyIndexableFieldsTo(copy);
     return copy;
 }
 
@@ -69,16 +105,201 @@ VMArray* VMArray::CloneForMovingGC() const {
     return clone;
 }
 
+void VMArray::WalkObjects(walk_heap_fn walk) {
+    clazz = static_cast<GCClass*>(walk(clazz));
+
+    if (strategy != ARRAY_OBJECTS) {
+        return;
+    }
+
+    ArraySlot* elements = slots();
+    size_t const numElements = GetNumberOfIndexableFields();
+    for (size_t i = 0; i < numElements; ++i) {
+        elements[i].object = walk(elements[i].object);
+    }
+}
+
+#ifdef CARD_MARKING
+void VMArray::WalkObjectsInRange(walk_heap_fn walk, const void* start,
+                                 const void* end) {
+    if ((const void*)&clazz >= start && (const void*)&clazz < end) {
+        clazz = static_cast<GCClass*>(walk(clazz));
+    }
+
+    if (strategy != ARRAY_OBJECTS) {
+        return;
+    }
+
+    // cards start at word boundaries of the object
+    ArraySlot* elements = slots();
+    size_t const numElements = GetNumberOfIndexableFields();
+    size_t first = 0;
+    if (start > (const void*)elements) {
+        first = (const ArraySlot*)start - elements;
+    }
+    size_t last = 0;
+    if (end > (const void*)elements) {
+        last = min(numElements, (size_t)((const ArraySlot*)end - elements));
+    }
+
+    for (size_t i = first; i < last; ++i) {
+        elements[i].object = walk(elements[i].object);
+    }
+}
+#endif
+
+vm_oop_t VMArray::getUnboxedElement(size_t idx) const {
+    switch (strategy) {
+        case ARRAY_INTEGERS: {
+            int64_t const value = slots()[idx].integer;
+            if (value != ARRAY_NIL_INTEGER) {
+                return NEW_INT(value);
+            }
+            break;
+        }
+        case ARRAY_DOUBLES: {
+            double const value = slots()[idx].number;
+            if (!isNilDouble(value)) {
+                return NEW_DOUBLE(value);
+            }
+            break;
+        }
+        case ARRAY_OBJECTS:
+            return load_ptr(slots()[idx].object);
+        case ARRAY_ALL_NIL:
+            break;
+    }
+    return load_ptr(nilObject);
+}
+
+void VMArray::setUnboxedElement(size_t idx, vm_oop_t value) {
+    bool const isNil = value == load_ptr(nilObject);
+
+    switch (strategy) {
+        case ARRAY_ALL_NIL: {
+            if (isNil) {
+                return;
+            }
+            ArrayStrategy const newStrategy = strategyFor(value);
+            if (newStrategy != ARRAY_OBJECTS) {
+                adoptStrategy(newStrategy, 0);
+                setUnboxedElement(idx, value);
+                return;
+            }
+            break;
+        }
+        case ARRAY_INTEGERS:
+            if (IS_SMALL_INT(value) &&
+                SMALL_INT_VAL(value) != ARRAY_NIL_INTEGER) {
+                slots()[idx].integer = SMALL_INT_VAL(value);
+                return;
+            }
+            if (isNil) {
+                slots()[idx].integer = ARRAY_NIL_INTEGER;
+                return;
+            }
+            break;
+        case ARRAY_DOUBLES:
+            if (isUnboxableDouble(value)) {
+                slots()[idx].number = AS_DOUBLE(value);
+                return;
+            }
+            if (isNil) {
+                slots()[idx].number = nilDouble();
+                return;
+            }
+            break;
+        case ARRAY_OBJECTS:
+            break;
+    }
+
+    generalize();
+    store_ptr(slots()[idx].object, value);
+}
+
+void VMArray::adoptStrategy(ArrayStrategy newStrategy, size_t nilFrom) {
+    assert(strategy == ARRAY_ALL_NIL);
+
+    ArraySlot* elements = slots();
+    size_t const numElements = GetNumberOfIndexableFields();
+    switch (newStrategy) {
+        case ARRAY_INTEGERS:
+            for (size_t i = nilFrom; i < numElements; ++i) {
+                elements[i].integer = ARRAY_NIL_INTEGER;
+            }
+            break;
+        case ARRAY_DOUBLES:
+            for (size_t i = nilFrom; i < numElements; ++i) {
+                elements[i].number = nilDouble();
+            }
+            break;
+        case ARRAY_OBJECTS: {
+            vm_oop_t nil = load_ptr(nilObject);
+            for (size_t i = nilFrom; i < numElements; ++i) {
+                storeIntoEmpty(i, nil);
+            }
+            break;
+        }
+        case ARRAY_ALL_NIL:
+            break;
+    }
+    strategy = newStrategy;
+}
+
+void VMArray::generalize() {
+    // the elements are boxed in place, the slots hold no references yet
+    size_t const numElements = GetNumberOfIndexableFields();
+    for (size_t i = 0; i < numElements; ++i) {
+        storeIntoEmpty(i, getUnboxedElement(i));
+    }
+    strategy = ARRAY_OBJECTS;
+}
+
 void VMArray::IndexOutOfBounds(size_t idx) const {
     ErrorExit(("Array index out of bounds: Accessing " + to_string(idx) +
-               ", but array size is only " + to_string(numberOfFields) + "\n")
+               ", but array size is only " +
+               to_string(GetNumberOfIndexableFields()) + "\n")
                   .c_str());
 }
 
-void VMArray::CopyIndexableFieldsTo(VMArray* to) const {
-    const size_t numIndexableFields = GetNumberOfIndexableFields();
-    for (size_t i = 0; i < numIndexableFields; ++i) {
-        to->SetIndexableField(i, GetIndexableField(i));
+void VMArray::CopyIndexableFieldsTo(VMArray* to, size_t start,
+                                    size_t count) const {
+    assert(to->strategy == ARRAY_ALL_NIL);
+    assert(start + count <= GetNumberOfIndexableFields());
+    assert(to->GetNumberOfIndexableFields() >= count);
+
+    if (strategy == ARRAY_ALL_NIL) {
+        return;
+    }
+
+    to->adoptStrategy(strategy, count);
+    if (strategy == ARRAY_OBJECTS) {
+        for (size_t i = 0; i < count; ++i) {
+            to->storeIntoEmpty(i, GetIndexableField(start + i));
+        }
+    } else {
+        memcpy(to->slots(), slots() + start, count * sizeof(ArraySlot));
+    }
+}
+
+void VMArray::MoveIndexableFields(size_t from, size_t to, size_t count) {
+    assert(from + count <= GetNumberOfIndexableFields());
+    assert(to + count <= GetNumberOfIndexableFields());
+
+    if (strategy == ARRAY_ALL_NIL) {
+        return;
+    }
+
+    if (strategy != ARRAY_OBJECTS) {
+        memmove(slots() + to, slots() + from, count * sizeof(ArraySlot));
+    } else if (to < from) {
+        for (size_t i = 0; i < count; ++i) {
+            SetIndexableField(to + i, GetIndexableField(from + i));
+        }
+    } else {
+        for (size_t i = count; i > 0; --i) {
+            SetIndexableField(to + i - 1, GetIndexableField(from + i - 1));
+        }
     }
 }
 
@@ -26,70 +26,134 @@
  THE SOFTWARE.
  */
 #include <cstddef>
+#include <cstdint>
 
 #include "../vmobjects/VMInteger.h"
 #include "../vmobjects/VMObject.h"
 
+/**
+ * How the elements of an array are stored. A new array is ALL_NIL, and does
+ * not initialize its elements. The first store of something else than nil
+ * picks the strategy for the array. A store that the strategy cannot hold
+ * generalizes it to OBJECTS, which is never undone.
+ *
+ * INTEGERS and DOUBLES hold the values unboxed, and the elements that are nil
+ * as ARRAY_NIL_INTEGER and ARRAY_NIL_DOUBLE_BITS. They hold no references, so
+ * the GC does not scan them. INTEGERS is only used with USE_TAGGING, and
+ * DOUBLES only with TAGGED_DOUBLES and for immediate doubles, since boxed
+ * numbers would lose their identity.
+ */
+enum ArrayStrategy : uint8_t {
+    ARRAY_ALL_NIL,
+    ARRAY_INTEGERS,
+    ARRAY_DOUBLES,
+    ARRAY_OBJECTS
+};
+
+#define ARRAY_NIL_INTEGER INT64_MIN
+#define ARRAY_NIL_DOUBLE_BITS ((uint64_t)0x7FF8000000000BADU)  // a NaN
+
+union ArraySlot {
+    gc_oop_t object;
+    int64_t integer;
+    double number;
+};
+
 /**
  * For the VMArray, we assume that there are no subclasses, and that `Array`
- * doesn't have any fields itself. This way, we just used the fields as
- * indexable fields.
+ * doesn't have any fields itself. The elements are stored after the strategy,
+ * and are not fields of the VMObject.
  */
 class VMArray : public VMObject {
 public:
     typedef GCArray Stored;
 
-    explicit VMArray(size_t arraySize, size_t additionalBytes)
-        : VMObject(arraySize +
-                       0 /* VMArray is not allowed to have any fields itself */,
+    explicit VMArray([[maybe_unused]] size_t arraySize, size_t additionalBytes)
+        : VMObject(0 /* VMArray is not allowed to have any fields itself */,
                    additionalBytes + sizeof(VMArray)) {
         assert(VMArrayNumberOfFields == 0);
+        assert(additionalBytes == arraySize * sizeof(ArraySlot));
     }
 
-    explicit VMArray(size_t arraySize,
-                     size_t additionalBytes,
-                     size_t nillableFrom)
-        : VMObject(arraySize +
-                       0 /* VMArray is not allowed to have any fields itself */,
-                   additionalBytes + sizeof(VMArray),
-                   nillableFrom) {
-        assert(VMArrayNumberOfFields == 0);
-    }
-
-    // VMArray doesn't need to customize `void WalkObjects(walk_heap_fn)`,
-    // because it doesn't need anything special.
+    void WalkObjects(walk_heap_fn walk) override;
+#ifdef CARD_MARKING
+    void WalkObjectsInRange(walk_heap_fn walk, const void* start,
+                            const void* end) override;
+#endif
 
     [[nodiscard]] inline size_t GetNumberOfIndexableFields() const {
-        return numberOfFields;
+        return (totalObjectSize - sizeof(VMArray)) / sizeof(ArraySlot);
     }
 
+    [[nodiscard]] inline ArrayStrategy GetStrategy() const { return strategy; }
+
     /** Used from language level, via primitive */
     [[nodiscard]] VMArray* Copy() const;
 
     VMArray* CopyAndExtendWith(vm_oop_t /*item*/) const;
 
     [[nodiscard]] inline vm_oop_t GetIndexableField(size_t idx) const {
-        if (unlikely(idx > numberOfFields)) {
+        if (unlikely(idx >= GetNumberOfIndexableFields())) {
             IndexOutOfBounds(idx);
         }
-        return GetField(idx);
+        if (likely(strategy == ARRAY_OBJECTS)) {
+            vm_oop_t result = load_ptr(slots()[idx].object);
+            assert(IsValidObject(result));
+            return result;
+        }
+        return getUnboxedElement(idx);
     }
 
     inline void SetIndexableField(size_t idx, vm_oop_t value) {
-        if (unlikely(idx > GetNumberOfIndexableFields())) {
+        if (unlikely(idx >= GetNumberOfIndexableFields())) {
             IndexOutOfBounds(idx);
         }
-        SetField(idx, value);
+        assert(IsValidObject(value));
+        if (likely(strategy == ARRAY_OBJECTS)) {
+            store_ptr(slots()[idx].object, value);
+            return;
+        }
+        setUnboxedElement(idx, value);
     }
 
     __attribute__((noreturn)) __attribute__((noinline)) void IndexOutOfBounds(
         size_t idx) const;
 
-    void CopyIndexableFieldsTo(VMArray* /*to*/) const;
+    /// Copies the elements into a new array, which is at least as big.
+    inline void CopyIndexableFieldsTo(VMArray* to) const {
+        CopyIndexableFieldsTo(to, 0, GetNumberOfIndexableFields());
+    }
+
+    /// Copies count elements from start on to the beginning of a new array.
+    void CopyIndexableFieldsTo(VMArray* to, size_t start, size_t count) const;
+
+    /// Moves count elements from index from to index to, which may overlap.
+    void MoveIndexableFields(size_t from, size_t to, size_t count);
     [[nodiscard]] VMArray* CloneForMovingGC() const override;
 
     [[nodiscard]] std::string AsDebugString() const override;
 
 private:
+    [[nodiscard]] inline ArraySlot* slots() const {
+        return (ArraySlot*)SHIFTED_PTR(this, sizeof(VMArray));
+    }
+
+    /// Stores into a slot that does not hold a reference yet.
+    inline void storeIntoEmpty(size_t idx, vm_oop_t value) {
+        store_ptr_into_empty(slots()[idx].object, value);
+    }
+
+    vm_oop_t getUnboxedElement(size_t idx) const;
+    void setUnboxedElement(size_t idx, vm_oop_t value);
+
+    /// Switches an ALL_NIL array to the given strategy, and sets the elements
+    /// from nilFrom on to nil.
+    void adoptStrategy(ArrayStrategy newStrategy, size_t nilFrom);
+
+    /// Boxes the elements, and switches to OBJECTS.
+    void generalize();
+
+    ArrayStrategy strategy{ARRAY_ALL_NIL};
+
     static const size_t VMArrayNumberOfFields;
 };
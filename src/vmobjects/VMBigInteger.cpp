@@ -49,7 +49,7 @@ vm_oop_t VMBigInteger::Add(vm_oop_t value) const {
     if (IS_DOUBLE(value)) {
         double const left = embeddedInteger.toDouble();
         double const right = AS_DOUBLE(value);
-        return Universe::NewDouble(left + right);
+        return NEW_DOUBLE(left + right);
     }
 
     assert(IS_BIG_INT(value) && "assume rcvr is a big int now");
@@ -74,7 +74,7 @@ vm_oop_t VMBigInteger::Subtract(vm_oop_t value) const {
     if (IS_DOUBLE(value)) {
         double const left = embeddedInteger.toDouble();
         double const right = AS_DOUBLE(value);
-        return Universe::NewDouble(left - right);
+        return NEW_DOUBLE(left - right);
     }
 
     assert(IS_BIG_INT(value) && "assume rcvr is a big int now");
@@ -99,7 +99,7 @@ vm_oop_t VMBigInteger::Multiply(vm_oop_t value) const {
     if (IS_DOUBLE(value)) {
         double const left = embeddedInteger.toDouble();
         double const right = AS_DOUBLE(value);
-        return Universe::NewDouble(left * right);
+        return NEW_DOUBLE(left * right);
     }
 
     assert(IS_BIG_INT(value) && "assume rcvr is a big int now");
@@ -124,7 +124,7 @@ vm_oop_t VMBigInteger::DivideBy(vm_oop_t value) const {
     if (IS_DOUBLE(value)) {
         double const left = embeddedInteger.toDouble();
         double const right = AS_DOUBLE(value);
-        return Universe::NewDouble(left / right);
+        return NEW_DOUBLE(left / right);
     }
 
     assert(IS_BIG_INT(value) && "assume rcvr is a big int now");
@@ -149,7 +149,7 @@ vm_oop_t VMBigInteger::Modulo(vm_oop_t value) const {
     if (IS_DOUBLE(value)) {
         double const left = embeddedInteger.toDouble();
         double const right = AS_DOUBLE(value);
-        return Universe::NewDouble(std::fmod(left, right));
+        return NEW_DOUBLE(std::fmod(left, right));
     }
 
     assert(IS_BIG_INT(value) && "assume rcvr is a big int now");
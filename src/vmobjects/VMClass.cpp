@@ -38,6 +38,7 @@
 #include "../vm/Globals.h"
 #include "../vm/IsValidObject.h"
 #include "../vm/Print.h"
+#include "InlineCache.h"
 #include "ObjectFormats.h"
 #include "VMArray.h"
 #include "VMInvokable.h"
@@ -136,6 +137,7 @@ PrimInstallResult VMClass::InstallPrimitive(VMInvokable* invokable,
     // it's a new invokable so we need to expand the invokables array.
     store_ptr(instanceInvokables,
               instInvokables->CopyAndExtendWith((vm_oop_t)invokable));
+    InlineCache::InvalidateAll();
 
     // set holder, since we don't call SetInstanceInvokable, which does it
     // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast)
@@ -158,6 +160,7 @@ VMSymbol* VMClass::GetInstanceFieldName(size_t index) const {
 
 void VMClass::SetInstanceInvokables(VMArray* invokables) {
     store_ptr(instanceInvokables, invokables);
+    InlineCache::InvalidateAll();
     vm_oop_t nil = load_ptr(nilObject);
 
     size_t const numInvokables = GetNumberOfInstanceInvokables();
@@ -183,6 +186,7 @@ VMInvokable* VMClass::GetInstanceInvokable(size_t index) const {
 
 void VMClass::SetInstanceInvokable(size_t index, VMInvokable* invokable) {
     load_ptr(instanceInvokables)->SetIndexableField(index, invokable);
+    InlineCache::InvalidateAll();
 
     // NOLINTNEXTLINE (cppcoreguidelines-pro-type-reinterpret-cast)
     if (invokable != reinterpret_cast<VMInvokable*>(load_ptr(nilObject))) {
@@ -217,10 +221,12 @@ VMInvokable* VMClass::LookupInvokable(VMSymbol* name) {
 }
 
 int64_t VMClass::LookupFieldIndex(VMSymbol* name) const {
-    size_t const numInstanceFields = GetNumberOfInstanceFields();
-    for (size_t i = 0; i <= numInstanceFields; ++i) {
-        // even with GetNumberOfInstanceFields == 0 there is the class field
-        if (name == GetInstanceFieldName(i)) {
+    // the instance fields of a class start with the ones of its superclass,
+    // so the index in them is the index in the object
+    VMArray* fields = load_ptr(instanceFields);
+    size_t const numFields = fields->GetNumberOfIndexableFields();
+    for (size_t i = 0; i < numFields; ++i) {
+        if (fields->GetIndexableField(i) == name) {
             return (int64_t)i;
         }
     }
@@ -274,6 +280,7 @@ VMObject* VMClass::GetSuperClass() const {
 
 void VMClass::SetSuperClass(VMObject* sup) {
     store_ptr(superClass, sup);
+    InlineCache::InvalidateAll();
 }
 
 VMSymbol* VMClass::GetName() const {
@@ -69,6 +69,7 @@ public:
     [[nodiscard]] VMInvokable* GetInstanceInvokable(size_t index) const;
     void SetInstanceInvokable(size_t index, VMInvokable* invokable);
     VMInvokable* LookupInvokable(VMSymbol* name);
+    /// Returns the index of the named instance field, or -1 if there is none.
     int64_t LookupFieldIndex(VMSymbol* name) const;
     PrimInstallResult InstallPrimitive(VMInvokable* invokable,
                                        size_t bytecodeHash,
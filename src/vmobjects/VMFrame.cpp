@@ -33,6 +33,7 @@
 
 #include "../compiler/Disassembler.h"
 #include "../interpreter/Interpreter.h"
+#include "../memory/FrameStack.h"
 #include "../memory/Heap.h"
 #include "../misc/defs.h"
 #include "../vm/Globals.h"
@@ -83,6 +84,11 @@ VMFrame* VMFrame::EmergencyFrameFrom(VMFrame* from, size_t extraLength) {
         result->arguments[i] = nilObject;
         i++;
     }
+
+    // the copy replaces the frame, which is the topmost one on the stack
+    if (from->IsOnStack()) {
+        FrameStack::Release(from);
+    }
     return result;
 }
 
@@ -101,9 +107,13 @@ VMFrame* VMFrame::CloneForMovingGC() const {
     // is problematic here, because it may be invalid object while
     // cloning/moving within GC
 
-#if GC_TYPE == GENERATIONAL || GC_TYPE == COPYING || GC_TYPE == DEBUG_COPYING
+#if GC_TYPE == GENERATIONAL || GC_TYPE == COPYING || \
+    GC_TYPE == DEBUG_COPYING || GC_TYPE == IMMIX
     VMMethod* meth = load_ptr(method);
-    if (meth->GetGCField() != 0 && meth->GetGCField() != MASK_OBJECT_IS_OLD) {
+    // old objects may also carry the write-barrier bit, only young ones
+    // can have been forwarded
+    if (meth->GetGCField() != 0 &&
+        (meth->GetGCField() & MASK_OBJECT_IS_OLD) == 0) {
         meth = (VMMethod*)meth->GetGCField();
     }
 //    int64_t numArgs =
@@ -142,7 +152,8 @@ void VMFrame::WalkObjects(walk_heap_fn walk) {
     // VMFrame is not a proper SOM object any longer, we don't have a class for
     // it. clazz = (VMClass*) walk(clazz);
 
-    if (previousFrame != nullptr) {
+    // frames on the frame stack are not heap objects, they are walked as roots
+    if (previousFrame != nullptr && !FrameStack::Contains(previousFrame)) {
         previousFrame = static_cast<GCFrame*>(walk(previousFrame));
     }
     if (context != nullptr) {
@@ -250,7 +261,7 @@ void VMFrame::CopyArgumentsFrom(VMFrame* frame) {
     size_t const num_args = GetMethod()->GetNumberOfArguments();
     for (size_t i = 0; i < num_args; ++i) {
         vm_oop_t stackElem = frame->GetStackElement(num_args - 1 - i);
-        store_ptr(arguments[i], stackElem);
+        store_ptr_into_empty(arguments[i], stackElem);
     }
 }
 
@@ -29,14 +29,18 @@
 #include <cstdint>
 #include <type_traits>
 
+#include "../memory/FrameStack.h"
 #include "../vmobjects/VMArray.h"
 #include "../vmobjects/VMMethod.h"
 
 class Universe;
 
 class VMFrame : public AbstractVMObject {
+    friend class FrameStack;
     friend class Universe;
     friend class Interpreter;
+    friend class JIT;
+    friend class RegisterInterpreter;
     friend class Shell;
     friend class VMMethod;
 
@@ -52,14 +56,11 @@ public:
           arguments((gc_oop_t*)&(stack_ptr) + 1),
           locals(arguments + method->GetNumberOfArguments()),
           stack_ptr(locals + method->GetNumberOfLocals() - 1) {
-        // initialize all other fields. Don't need to initialize arguments,
-        // because they will be copied in still
-        // --> until end of Frame
-        auto* end = (gc_oop_t*)SHIFTED_PTR(this, totalObjectSize);
-        size_t i = 0;
-        while (locals + i < end) {
+        // initialize the locals. Don't need to initialize arguments,
+        // because they will be copied in still, nor the stack, because only
+        // the elements up to the stack pointer are ever read
+        for (size_t i = 0; i < method->GetNumberOfLocals(); i++) {
             locals[i] = nilObject;
-            i++;
         }
     }
 
@@ -85,6 +86,7 @@ public:
     inline void ClearPreviousFrame();
     [[nodiscard]] inline bool HasPreviousFrame() const;
     [[nodiscard]] inline bool IsBootstrapFrame() const;
+    [[nodiscard]] inline bool IsOnStack() const;
     [[nodiscard]] inline VMFrame* GetContext() const;
     inline void SetContext(VMFrame* /*frm*/);
     [[nodiscard]] inline bool HasContext() const;
@@ -115,7 +117,7 @@ public:
     inline void Push(vm_oop_t obj) {
         assert(RemainingStackSize() > 0);
         ++stack_ptr;
-        store_ptr(*stack_ptr, obj);
+        store_ptr_into_empty(*stack_ptr, obj);
     }
 
     [[nodiscard]] inline size_t GetBytecodeIndex() const {
@@ -189,12 +191,6 @@ public:
 
     void ResetBytecodeIndex();
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    void SetPreviousFrameOnReuse(VMFrame* previousFrame) {
-        this->previousFrame = store_root(previousFrame);
-    }
-#endif
-
 private:
     GCFrame* previousFrame;
     GCFrame* context{nullptr};
@@ -220,6 +216,10 @@ bool VMFrame::IsBootstrapFrame() const {
     return !HasPreviousFrame();
 }
 
+bool VMFrame::IsOnStack() const {
+    return FrameStack::Contains(this);
+}
+
 VMFrame* VMFrame::GetContext() const {
     return load_ptr(context);
 }
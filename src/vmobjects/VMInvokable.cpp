@@ -36,6 +36,10 @@ bool VMInvokable::IsPrimitive() const {
     return false;
 }
 
+bool VMInvokable::IsSafePrimitive() const {
+    return false;
+}
+
 void VMInvokable::WalkObjects(walk_heap_fn walk) {
     signature = static_cast<GCSymbol*>(walk(signature));
     if (holder != nullptr) {
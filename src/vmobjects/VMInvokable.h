@@ -56,12 +56,19 @@ public:
         uint8_t removedCtxLevel,
         MethodGenerationContext&
             mgencWithInlined) { /* NOOP for everything but VMMethods */ }
+    virtual void FuseSuperinstructions() { /* NOOP for everything but
+                                              VMMethods */
+    }
     virtual const Variable* GetArgument(size_t /*unused*/, size_t /*unused*/);
 
     [[nodiscard]] virtual uint8_t GetNumberOfArguments() const = 0;
 
     [[nodiscard]] virtual bool IsPrimitive() const;
 
+    /// Whether this is a primitive that only operates on its arguments, and
+    /// thus, cannot invoke other methods or primitives.
+    [[nodiscard]] virtual bool IsSafePrimitive() const;
+
     [[nodiscard]] inline VMSymbol* GetSignature() const {
         return load_ptr(signature);
     }
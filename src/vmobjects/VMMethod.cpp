@@ -32,6 +32,7 @@
 #include <cstring>
 #include <queue>
 #include <string>
+#include <vector>
 
 #include "../compiler/BytecodeGenerator.h"
 #include "../compiler/Disassembler.h"
@@ -39,6 +40,8 @@
 #include "../compiler/MethodGenerationContext.h"
 #include "../compiler/Variable.h"
 #include "../interpreter/Interpreter.h"
+#include "../interpreter/JIT.h"
+#include "../interpreter/RegisterCode.h"
 #include "../interpreter/bytecodes.h"
 #include "../memory/Heap.h"
 #include "../misc/Murmur3Hash.h"
@@ -64,10 +67,6 @@ VMMethod::VMMethod(VMSymbol* signature, size_t bcCount,
                             : Signature::GetNumberOfArguments(signature)),
       numberOfConstants(numberOfConstants), lexicalScope(lexicalScope),
       inlinedLoops(inlinedLoops) {
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    cachedFrame = nullptr;
-#endif
-
     indexableFields = (gc_oop_t*)(&indexableFields + 2);
     for (size_t i = 0; i < numberOfConstants; ++i) {
         indexableFields[i] = nilObject;
@@ -102,41 +101,102 @@ VMMethod* VMMethod::CloneForMovingGC() const {
 void VMMethod::WalkObjects(walk_heap_fn walk) {
     VMInvokable::WalkObjects(walk);
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    if (cachedFrame != nullptr) {
-        cachedFrame = static_cast<GCFrame*>(walk(cachedFrame));
-    }
-#endif
-
     size_t const numIndexableFields = GetNumberOfIndexableFields();
     for (size_t i = 0; i < numIndexableFields; ++i) {
         if (indexableFields[i] != nullptr) {
             indexableFields[i] = walk(indexableFields[i]);
         }
     }
-}
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-GCFrame* VMMethod::GetCachedFrame() const {
-    return cachedFrame;
+    if (inlineCaches != nullptr) {
+        for (size_t i = 0; i < bcLength; ++i) {
+            if (inlineCaches[i] != nullptr) {
+                inlineCaches[i]->WalkObjects(walk);
+            }
+        }
+    }
 }
 
-void VMMethod::SetCachedFrame(VMFrame* frame) {
-    cachedFrame = store_with_separate_barrier(frame);
-    if (frame != nullptr) {
-        frame->SetContext(nullptr);
-        frame->SetBytecodeIndex(0);
-        frame->ResetStackPointer();
-        write_barrier(this, cachedFrame);
+InlineCache* VMMethod::createInlineCache(size_t bytecodeIndex) {
+    assert(bytecodeIndex < bcLength);
+    if (inlineCaches == nullptr) {
+        if (!ownsNativeMemory()) {
+            ownersOfNativeMemory.push_back({this, false});
+        }
+        inlineCaches = new InlineCache*[bcLength]();
     }
+
+    auto* cache = new InlineCache();
+    inlineCaches[bytecodeIndex] = cache;
+    return cache;
 }
+
+std::vector<VMMethod::NativeMemoryOwner> VMMethod::ownersOfNativeMemory;
+
+void VMMethod::releaseNativeMemory() {
+    if (inlineCaches != nullptr) {
+        for (size_t i = 0; i < bcLength; ++i) {
+            delete inlineCaches[i];
+        }
+        delete[] inlineCaches;
+        inlineCaches = nullptr;
+    }
+
+#ifdef USE_JIT
+    delete compiledCode;
+    compiledCode = nullptr;
+#endif
+
+#ifdef USE_REGISTER_BYTECODES
+    delete registerCode;
+    registerCode = nullptr;
 #endif
+}
+
+void VMMethod::SweepNativeMemory(
+    AbstractVMObject* (*survivor)(AbstractVMObject*), bool onlyInSnapshot) {
+    size_t kept = 0;
+    for (NativeMemoryOwner owner : ownersOfNativeMemory) {
+        if (!onlyInSnapshot || owner.inSnapshot) {
+            auto* method = static_cast<VMMethod*>(survivor(owner.method));
+            if (method == nullptr) {
+                owner.method->releaseNativeMemory();
+                continue;
+            }
+            owner.method = method;
+        }
+
+        if (onlyInSnapshot) {
+            owner.inSnapshot = false;
+        }
+        ownersOfNativeMemory[kept] = owner;
+        kept += 1;
+    }
+    ownersOfNativeMemory.resize(kept);
+}
+
+void VMMethod::SnapshotOwnersOfNativeMemory() {
+    for (NativeMemoryOwner& owner : ownersOfNativeMemory) {
+        owner.inSnapshot = true;
+    }
+}
 
 VMFrame* VMMethod::Invoke(VMFrame* frame) {
     // since an invokable is able to change/use the frame, we have to write
     // cached values before, and read cached values after calling
     frame->SetBytecodeIndex(Interpreter::GetBytecodeIndex());
 
+#ifdef USE_JIT
+    if (useJIT && unlikely(CountInvocation())) {
+        JIT::Compile(this);
+    }
+#endif
+#ifdef USE_REGISTER_BYTECODES
+    if (useRegisterBytecodes && unlikely(CountInvocation())) {
+        RegisterCode::Translate(this);
+    }
+#endif
+
     VMFrame* frm = Interpreter::PushNewFrame(this);
     frm->CopyArgumentsFrom(frame);
     return frm;
@@ -147,6 +207,17 @@ VMFrame* VMMethod::Invoke1(VMFrame* frame) {
     // cached values before, and read cached values after calling
     frame->SetBytecodeIndex(Interpreter::GetBytecodeIndex());
 
+#ifdef USE_JIT
+    if (useJIT && unlikely(CountInvocation())) {
+        JIT::Compile(this);
+    }
+#endif
+#ifdef USE_REGISTER_BYTECODES
+    if (useRegisterBytecodes && unlikely(CountInvocation())) {
+        RegisterCode::Translate(this);
+    }
+#endif
+
     VMFrame* frm = Interpreter::PushNewFrame(this);
     frm->SetArgument(0, frame->Top());
     return frm;
@@ -392,7 +463,20 @@ void VMMethod::inlineInto(MethodGenerationContext& mgenc,
             case BC_SEND_1:
             case BC_SEND_2:
             case BC_SEND_3:
-            case BC_SEND_N: {
+            case BC_SEND_N:
+            case BC_ADD:
+            case BC_SUB:
+            case BC_MUL:
+            case BC_LT:
+            case BC_GT:
+            case BC_LE:
+            case BC_GE:
+            case BC_EQ:
+            case BC_EQ_EQ:
+            case BC_DIV_DOUBLE:
+            case BC_AT_ARRAY:
+            case BC_AT_PUT_ARRAY:
+            case BC_INST_VAR_NAMED: {
                 auto* const sym = (VMSymbol*)GetConstant(i);
                 EmitSEND(mgenc, parser, sym);
                 break;
@@ -559,6 +643,19 @@ void VMMethod::AdaptAfterOuterInlined(
             case BC_SEND_1:
             case BC_SEND_2:
             case BC_SEND_3:
+            case BC_ADD:
+            case BC_SUB:
+            case BC_MUL:
+            case BC_LT:
+            case BC_GT:
+            case BC_LE:
+            case BC_GE:
+            case BC_EQ:
+            case BC_EQ_EQ:
+            case BC_DIV_DOUBLE:
+            case BC_AT_ARRAY:
+            case BC_AT_PUT_ARRAY:
+            case BC_INST_VAR_NAMED:
             case BC_SUPER_SEND:
             case BC_RETURN_LOCAL:
             case BC_RETURN_NON_LOCAL:
@@ -716,6 +813,58 @@ void VMMethod::MergeScopeInto(MethodGenerationContext& mgenc) {
     mgenc.MergeIntoScope(*lexicalScope);
 }
 
+void VMMethod::FuseSuperinstructions() {
+    // the bytecodes of a superinstruction are not fused again, so that its
+    // last bytecode is still in place, and can be jumped to directly
+    size_t fusedUntil = 0;
+
+    size_t i = 0;
+    while (i < bcLength) {
+        uint8_t const first = bytecodes[i];
+        size_t const next = i + Bytecode::GetBytecodeLength(first);
+
+        if (first == BC_PUSH_BLOCK) {
+            auto* blockMethod = static_cast<VMInvokable*>(GetConstant(i));
+            blockMethod->FuseSuperinstructions();
+        } else if (i >= fusedUntil && CanPrecedeInSuperinstruction(first) &&
+                   next < bcLength) {
+            uint8_t const second = bytecodes[next];
+            size_t const nextNext = next + Bytecode::GetBytecodeLength(second);
+            uint8_t const third =
+                CanPrecedeInSuperinstruction(second) && nextNext < bcLength
+                    ? bytecodes[nextNext]
+                    : BC_INVALID;
+
+            uint8_t const pair = GetSuperinstruction(first, second, BC_INVALID);
+            uint8_t const triple =
+                third == BC_INVALID ? BC_INVALID
+                                    : GetSuperinstruction(first, second, third);
+
+            if (triple != BC_INVALID && triple != pair) {
+                bytecodes[i] = triple;
+                fusedUntil = nextNext + Bytecode::GetBytecodeLength(third);
+            } else if (pair != BC_INVALID) {
+                bytecodes[i] = pair;
+                fusedUntil = nextNext;
+            }
+        }
+        i = next;
+    }
+}
+
 size_t VMMethod::GetBytecodeHash() const {
-    return murmur3_32(bytecodes, bcLength, 0x00000000);
+    // hash the bytecodes without the effects of quickening and
+    // superinstructions, and with binary operations as plain sends, as other
+    // SOM implementations compile them
+    std::vector<uint8_t> original(bytecodes, bytecodes + bcLength);
+    size_t i = 0;
+    while (i < bcLength) {
+        if (IsBinaryOperationBytecode(original[i]) ||
+            IsQuickenedBytecode(original[i])) {
+            original[i] = BC_SEND;
+        }
+        original[i] = Bytecode::GetBaseBytecode(original[i]);
+        i += Bytecode::GetBytecodeLength(original[i]);
+    }
+    return murmur3_32(original.data(), bcLength, 0x00000000);
 }
@@ -28,10 +28,14 @@
 
 #include <iostream>
 #include <queue>
+#include <vector>
 
 #include "../compiler/LexicalScope.h"
+#include "../interpreter/JIT.h"
+#include "../interpreter/RegisterCode.h"
 #include "../vm/Globals.h"
 #include "../vm/Print.h"
+#include "InlineCache.h"
 #include "VMInteger.h"
 #include "VMInvokable.h"
 
@@ -88,6 +92,8 @@ bool operator<(const BackJumpPatch& a, const BackJumpPatch& b);
 class VMMethod : public VMInvokable {
     friend class Interpreter;
     friend class Disassembler;
+    friend class JIT;
+    friend class RegisterInterpreter;
 
 public:
     typedef GCMethod Stored;
@@ -142,13 +148,77 @@ public:
 
     inline void SetBytecode(size_t indx, uint8_t val) { bytecodes[indx] = val; }
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    void SetCachedFrame(VMFrame* frame);
-    GCFrame* GetCachedFrame() const;
+    /// Returns the inline cache of the send at the given bytecode index,
+    /// creating it on first use.
+    [[nodiscard]] inline InlineCache* GetInlineCache(size_t bytecodeIndex) {
+        if (likely(inlineCaches != nullptr)) {
+            InlineCache* cache = inlineCaches[bytecodeIndex];
+            if (likely(cache != nullptr)) {
+                return cache;
+            }
+        }
+        return createInlineCache(bytecodeIndex);
+    }
+
+#ifdef USE_JIT
+    [[nodiscard]] inline CompiledCode* GetCompiledCode() const {
+        return compiledCode;
+    }
+
+    inline void SetCompiledCode(CompiledCode* code) {
+        if (!ownsNativeMemory()) {
+            ownersOfNativeMemory.push_back({this, false});
+        }
+        compiledCode = code;
+    }
+
+    /// Count invocations and loop iterations, and return true exactly once,
+    /// when the method became hot enough to be compiled.
+    inline bool CountInvocation() {
+        return ++invocationCount == JIT_INVOCATION_THRESHOLD;
+    }
+
+    inline bool CountBackEdge() {
+        return ++backEdgeCount == JIT_BACK_EDGE_THRESHOLD;
+    }
+#endif
+
+#ifdef USE_REGISTER_BYTECODES
+    [[nodiscard]] inline RegisterCode* GetRegisterCode() const {
+        return registerCode;
+    }
+
+    inline void SetRegisterCode(RegisterCode* code) {
+        if (!ownsNativeMemory()) {
+            ownersOfNativeMemory.push_back({this, false});
+        }
+        registerCode = code;
+    }
+
+    /// Count invocations and loop iterations, and return true exactly once,
+    /// when the method became hot enough to be translated.
+    inline bool CountInvocation() {
+        return ++invocationCount == REGISTER_INVOCATION_THRESHOLD;
+    }
+
+    inline bool CountBackEdge() {
+        return ++backEdgeCount == REGISTER_BACK_EDGE_THRESHOLD;
+    }
 #endif
 
     void WalkObjects(walk_heap_fn /*unused*/) override;
 
+    /// The inline caches and the native code of a method are allocated
+    /// outside of the heap, and are freed by the collectors once it died.
+    /// They call this when they know which objects survived, and survivor
+    /// returns where the given method is now, or nullptr if it is dead. With
+    /// onlyInSnapshot, it is only called for the methods that were known when
+    /// SnapshotOwnersOfNativeMemory() was called, i.e., when marking started,
+    /// and the others are kept.
+    static void SweepNativeMemory(
+        AbstractVMObject* (*survivor)(AbstractVMObject*), bool onlyInSnapshot);
+    static void SnapshotOwnersOfNativeMemory();
+
     [[nodiscard]] inline size_t GetNumberOfIndexableFields() const {
         return numberOfConstants;
     }
@@ -181,15 +251,42 @@ public:
         MethodGenerationContext& mgencWithInlined) final;
 
     void MergeScopeInto(MethodGenerationContext& mgenc) override;
+
+    /// Replaces the first bytecode of each sequence that has a
+    /// superinstruction, in this method and its blocks. This has to be done
+    /// after all blocks were inlined, since inlining expects the plain
+    /// bytecodes.
+    void FuseSuperinstructions() final;
+
     const Variable* GetArgument(size_t index, size_t contextLevel) override {
         return lexicalScope->GetArgument(index, contextLevel);
     }
 
+    /// Block methods are executed with a context, methods are not.
+    [[nodiscard]] inline bool IsBlockMethod() const {
+        return lexicalScope != nullptr && lexicalScope->IsBlockScope();
+    }
+
     void Dump(const char* indent, bool printObjects) override;
 
     [[nodiscard]] inline uint8_t* GetBytecodes() const { return bytecodes; }
 
 private:
+    InlineCache* createInlineCache(size_t bytecodeIndex);
+
+    [[nodiscard]] inline bool ownsNativeMemory() const {
+        bool owns = inlineCaches != nullptr;
+#ifdef USE_JIT
+        owns = owns || compiledCode != nullptr;
+#endif
+#ifdef USE_REGISTER_BYTECODES
+        owns = owns || registerCode != nullptr;
+#endif
+        return owns;
+    }
+
+    void releaseNativeMemory();
+
     void inlineInto(MethodGenerationContext& mgenc, const Parser& parser);
     std::priority_queue<BackJump> createBackJumpHeap();
 
@@ -204,6 +301,13 @@ private:
 
     make_testable(public);
 
+    struct NativeMemoryOwner {
+        VMMethod* method;
+        bool inSnapshot;
+    };
+
+    static std::vector<NativeMemoryOwner> ownersOfNativeMemory;
+
     [[nodiscard]] inline vm_oop_t GetIndexableField(size_t idx) const {
         return load_ptr(indexableFields[idx]);
     }
@@ -214,13 +318,24 @@ private:
     const uint8_t numberOfArguments;
     const size_t numberOfConstants;
 
+#ifdef USE_JIT
+    CompiledCode* compiledCode{nullptr};
+    uint32_t invocationCount{0};
+    uint32_t backEdgeCount{0};
+#endif
+
+#ifdef USE_REGISTER_BYTECODES
+    RegisterCode* registerCode{nullptr};
+    uint32_t invocationCount{0};
+    uint32_t backEdgeCount{0};
+#endif
+
 private:
     LexicalScope* lexicalScope;
     BackJump* inlinedLoops;
 
-#ifdef UNSAFE_FRAME_OPTIMIZATION
-    GCFrame* cachedFrame;
-#endif
+    // one entry per bytecode, only send sites get a cache
+    InlineCache** inlineCaches{nullptr};
 
 #ifdef BYTECODE_HEATMAP
     uint64_t* heatmap;
@@ -26,6 +26,7 @@
 
 #include "VMObject.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
@@ -87,6 +88,30 @@ void VMObject::WalkObjects(walk_heap_fn walk) {
     }
 }
 
+#ifdef CARD_MARKING
+void VMObject::WalkObjectsInRange(walk_heap_fn walk, const void* start,
+                                  const void* end) {
+    if ((const void*)&clazz >= start && (const void*)&clazz < end) {
+        clazz = static_cast<GCClass*>(walk(clazz));
+    }
+
+    // cards start at word boundaries of the object
+    size_t const numFields = GetNumberOfFields();
+    size_t first = 0;
+    if (start > (const void*)FIELDS) {
+        first = (const gc_oop_t*)start - FIELDS;
+    }
+    size_t last = 0;
+    if (end > (const void*)FIELDS) {
+        last = min(numFields, (size_t)((const gc_oop_t*)end - FIELDS));
+    }
+
+    for (size_t i = first; i < last; ++i) {
+        FIELDS[i] = walk(tmp_ptr(GetField(i)));
+    }
+}
+#endif
+
 void VMObject::MarkObjectAsInvalid() {
     clazz = (GCClass*)INVALID_GC_POINTER;
 
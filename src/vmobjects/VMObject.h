@@ -123,6 +123,10 @@ public:
 
     virtual void Assert(bool value) const;
     void WalkObjects(walk_heap_fn walk) override;
+#ifdef CARD_MARKING
+    void WalkObjectsInRange(walk_heap_fn walk, const void* start,
+                            const void* end) override;
+#endif
     [[nodiscard]] VMObject* CloneForMovingGC() const override;
 
     /** The total size of the object on the heap. */
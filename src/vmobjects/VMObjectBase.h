@@ -15,6 +15,13 @@ protected:
 public:
     [[nodiscard]] inline size_t GetGCField() const;
     inline void SetGCField(size_t /*val*/);
+
+    /// Sets the GC field to val if it is still expected. Used by the
+    /// ParallelMarker to mark objects from several threads.
+    inline bool CompareAndSetGCField(size_t expected, size_t val) {
+        return __atomic_compare_exchange_n(&gcfield, &expected, val, false,
+                                           __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+    }
     VMObjectBase() : VMOop() {}
     ~VMObjectBase() override = default;
 };
@@ -16,6 +16,8 @@ public:
 
     [[nodiscard]] bool IsPrimitive() const final { return true; };
 
+    [[nodiscard]] bool IsSafePrimitive() const final { return true; };
+
     void InlineInto(MethodGenerationContext& mgenc, const Parser& parser,
                     bool mergeScope = true) final;
 
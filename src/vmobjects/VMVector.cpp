@@ -1,5 +1,6 @@
 #include "../vmobjects/VMVector.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -77,37 +78,47 @@ void VMVector::SetStorageAWFY(int64_t index, vm_oop_t value) {
 
         newStorage->SetIndexableField(index - 1, value);
 
-        this->storage = store_ptr(this->storage, newStorage);
+        store_ptr(this->storage, newStorage);
 
     } else {
         // Just set the new value
         storage->SetIndexableField(first + index - 2, value);
         last += 1;
-        this->last = store_ptr(this->last, NEW_INT(last));
+        store_ptr(this->last, NEW_INT(last));
     }
 }
 
 void VMVector::Append(vm_oop_t value) {
+    int64_t first = SMALL_INT_VAL(load_ptr(this->first));
     int64_t last = SMALL_INT_VAL(load_ptr(this->last));
     VMArray* storage = load_ptr(this->storage);
-
-    if (last >= storage->GetNumberOfIndexableFields()) {  // Expand the array
-        // Expand by the correct amount *2 by default in the native som
-        // implementation
-        VMArray* newStorage = Universe::NewExpandedArrayFromArray(
-            storage->GetNumberOfIndexableFields() * 2, storage);
-
-        storage->CopyIndexableFieldsTo(newStorage);
-        newStorage->SetIndexableField(last - 1, value);
-
-        SetField(2 /* storage */, newStorage);
-
-    } else {  // Just set the new value
-        storage->SetIndexableField(last - 1, value);
+    size_t const capacity = storage->GetNumberOfIndexableFields();
+
+    if (last > capacity) {
+        size_t const size = last - first;
+        if (first > 1 && size <= capacity / 2) {
+            // a queue that is mostly removed from the front: move its
+            // elements to the front, instead of growing
+            storage->MoveIndexableFields(first - 1, 0, size);
+            for (size_t i = size; i < capacity; ++i) {
+                storage->SetIndexableField(i, load_ptr(nilObject));
+            }
+        } else {
+            // grow geometrically, and drop the removed elements in front
+            VMArray* newStorage = Universe::NewArray(
+                std::max(capacity * 2, (size_t)VECTOR_MIN_CAPACITY));
+            storage->CopyIndexableFieldsTo(newStorage, first - 1, size);
+            store_ptr(this->storage, newStorage);
+            storage = newStorage;
+        }
+        first = 1;
+        last = (int64_t)size + 1;
+        store_ptr(this->first, NEW_INT(first));
     }
 
+    storage->SetIndexableField(last - 1, value);
     last += 1;
-    this->last = store_ptr(this->last, NEW_INT(last));
+    store_ptr(this->last, NEW_INT(last));
 }
 
 vm_oop_t VMVector::RemoveLast() {
@@ -145,8 +156,16 @@ vm_oop_t VMVector::RemoveFirst() {
 
     // This is 1 because GetIndexableField handles 1 to 0 indexing
     vm_oop_t itemToRemove = GetStorage(1);
+    VMArray* storage = load_ptr(this->storage);
+    storage->SetIndexableField(first - 1, load_ptr(nilObject));
+
     first += 1;  // Increment the first index
-    this->first = store_ptr(this->first, NEW_INT(first));
+    if (first == SMALL_INT_VAL(load_ptr(this->last))) {
+        // the vector is empty, appending can start at the front again
+        first = 1;
+        store_ptr(this->last, NEW_INT(1));
+    }
+    store_ptr(this->first, NEW_INT(first));
     return itemToRemove;
 }
 
@@ -175,24 +194,23 @@ vm_oop_t VMVector::remove(int64_t index) {
     vm_oop_t itemToRemove = GetStorage(index);
 
     // Shift all elements after the index to the left
-    for (int64_t i = index; i < last - first; ++i) {
-        storage->SetIndexableField(first + i - 1,
-                                   storage->GetIndexableField(first + i));
-    }
+    storage->MoveIndexableFields(first + index - 1, first + index - 2,
+                                 last - first - index);
+    storage->SetIndexableField(last - 2, load_ptr(nilObject));
 
     last -= 1;
-    this->last = store_ptr(this->last, NEW_INT(last));
+    store_ptr(this->last, NEW_INT(last));
 
     return itemToRemove;
 }
 
 void VMVector::RemoveAll() {
-    this->first = store_ptr(this->first, NEW_INT(1));
-    this->last = store_ptr(this->last, NEW_INT(1));
+    store_ptr(this->first, NEW_INT(1));
+    store_ptr(this->last, NEW_INT(1));
     VMArray* storage = load_ptr(this->storage);
     VMArray* newArray =
         Universe::NewArray(storage->GetNumberOfIndexableFields());
-    this->storage = store_ptr(this->storage, newArray);
+    store_ptr(this->storage, newArray);
 }
 
 vm_oop_t VMVector::copyStorageArray() {
@@ -201,9 +219,7 @@ vm_oop_t VMVector::copyStorageArray() {
     VMArray* storage = load_ptr(this->storage);
 
     VMArray* result = Universe::NewArray(last - first);
-    for (int64_t i = first - 1; i < last - 1; ++i) {
-        result->SetIndexableField(i - first + 1, storage->GetIndexableField(i));
-    }
+    storage->CopyIndexableFieldsTo(result, first - 1, last - first);
 
     return result;
 }
@@ -10,6 +10,14 @@
 #include "ObjectFormats.h"
 #include "VMArray.h"
 
+// the capacity to which a Vector without any storage grows
+#define VECTOR_MIN_CAPACITY 8
+
+/**
+ * The fields are the ones of Vector in the core library, which also accesses
+ * them directly. The elements are stored in storage from index first on, up
+ * to before last, and the storage array keeps its strategy as it grows.
+ */
 class VMVector : public VMObject {
 public:
     typedef GCVector Stored;
@@ -30,8 +38,9 @@ public:
 
     /* Return the last element */
     [[nodiscard]] inline vm_oop_t GetLast() {
+        const int64_t first = SMALL_INT_VAL(load_ptr(this->first));
         const int64_t last = SMALL_INT_VAL(load_ptr(this->last));
-        vm_oop_t returned = GetStorage(last - 1);
+        vm_oop_t returned = GetStorage(last - first);
         return returned;
     }
 
@@ -79,6 +88,8 @@ public:
 private:
     static const size_t VMVectorNumberOfFields;
 
+    make_testable(public);
+
     gc_oop_t first;
     gc_oop_t last;
     GCArray* storage;